@@ -2,6 +2,26 @@
 #define CPP2_S21_CONTAINERS_1_INCLUDE_S21_CONTAINERSPLUS_H_
 
 #include "../src/array/array.h"
+#include "../src/btree/btree_map.h"
+#include "../src/btree/btree_set.h"
+#include "../src/deque/deque.h"
+#include "../src/deque/ws_deque.h"
+#include "../src/flat/flat_map.h"
+#include "../src/flat/flat_set.h"
+#include "../src/map/concurrent_map.h"
+#include "../src/map/skiplist_map.h"
 #include "../src/multiset/multiset.h"
+#include "../src/persistent/persistent_map.h"
+#include "../src/persistent/persistent_set.h"
+#include "../src/priority_queue/indexed_priority_queue.h"
+#include "../src/priority_queue/priority_queue.h"
+#include "../src/queue/blocking_queue.h"
+#include "../src/queue/mpmc_queue.h"
+#include "../src/queue/spsc_queue.h"
+#include "../src/stack/concurrent_stack.h"
+#include "../src/thread_pool/thread_pool.h"
+#include "../src/timer_wheel/timer_wheel.h"
+#include "../src/unordered/unordered_map.h"
+#include "../src/unordered/unordered_set.h"
 
 #endif  // CPP2_S21_CONTAINERS_1_INCLUDE_S21_CONTAINERSPLUS_H_
\ No newline at end of file
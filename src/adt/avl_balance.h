@@ -0,0 +1,230 @@
+#ifndef CPP2_S21_CONTAINERS_1_ADT_AVL_BALANCE_H_
+#define CPP2_S21_CONTAINERS_1_ADT_AVL_BALANCE_H_
+
+#include <cstddef>
+#include <type_traits>
+
+namespace s21 {
+
+// Key-agnostic AVL maintenance shared by map and set. Nodes are TreeNode
+// instances hanging off a header ("phantom") node whose left_ is the root,
+// so the root is relinked exactly like any other child and no comparison is
+// ever needed to find which side of its parent a node is on. The header's
+// right_ is left to the container (map and set cache the last node there).
+//
+// Besides the height, every node carries its subtree size and, when a
+// Monoid is given, the fold of its subtree. A Monoid provides value_type
+// and the static functions identity(), lift(const Data&) and
+// combine(lhs, rhs); combine must be associative, and none of them should
+// throw, since erase has no way to undo a half-updated path.
+template <typename Node, typename Monoid = void>
+struct AvlBalance {
+  static int height(const Node *node) noexcept {
+    return node ? node->height_ : 0;
+  }
+
+  static size_t count(const Node *node) noexcept {
+    return node ? node->count_ : 0;
+  }
+
+  // Recomputes everything node caches about its subtree from its children.
+  static void update(Node *node) {
+    int left = height(node->left_);
+    int right = height(node->right_);
+    node->height_ = (left > right ? left : right) + 1;
+    node->count_ = count(node->left_) + count(node->right_) + 1;
+    if constexpr (!std::is_void_v<Monoid>) {
+      typename Monoid::value_type summary = Monoid::lift(node->data_);
+      if (node->left_) {
+        summary = Monoid::combine(node->left_->summary_, summary);
+      }
+      if (node->right_) {
+        summary = Monoid::combine(summary, node->right_->summary_);
+      }
+      node->summary_ = summary;
+    }
+  }
+
+  static void replaceChild(Node *parent, Node *old_child,
+                           Node *new_child) noexcept {
+    if (parent->left_ == old_child) {
+      parent->left_ = new_child;
+    } else {
+      parent->right_ = new_child;
+    }
+  }
+
+  // node's right child takes its place.
+  static Node *rotateLeft(Node *node) {
+    Node *pivot = node->right_;
+    node->right_ = pivot->left_;
+    if (pivot->left_) {
+      pivot->left_->parent_ = node;
+    }
+    pivot->parent_ = node->parent_;
+    replaceChild(node->parent_, node, pivot);
+    pivot->left_ = node;
+    node->parent_ = pivot;
+    update(node);
+    update(pivot);
+    return pivot;
+  }
+
+  // node's left child takes its place.
+  static Node *rotateRight(Node *node) {
+    Node *pivot = node->left_;
+    node->left_ = pivot->right_;
+    if (pivot->right_) {
+      pivot->right_->parent_ = node;
+    }
+    pivot->parent_ = node->parent_;
+    replaceChild(node->parent_, node, pivot);
+    pivot->right_ = node;
+    node->parent_ = pivot;
+    update(node);
+    update(pivot);
+    return pivot;
+  }
+
+  // Restores the AVL property at node, whose subtrees are already balanced.
+  // Returns the root of the subtree that now stands where node was.
+  static Node *rebalance(Node *node) {
+    int factor = height(node->left_) - height(node->right_);
+    if (factor > 1) {
+      if (height(node->left_->left_) < height(node->left_->right_)) {
+        rotateLeft(node->left_);
+      }
+      return rotateRight(node);
+    }
+    if (factor < -1) {
+      if (height(node->right_->right_) < height(node->right_->left_)) {
+        rotateRight(node->right_);
+      }
+      return rotateLeft(node);
+    }
+    update(node);
+    return node;
+  }
+
+  // Hangs a fresh leaf under parent and fixes the ancestors. An insertion
+  // needs at most one (single or double) rotation; once a subtree comes out
+  // as tall as it was, the ancestors above only need their counts and
+  // summaries refreshed.
+  static void insertLeaf(Node *node, Node *parent, bool as_left,
+                         Node *header) {
+    node->left_ = nullptr;
+    node->right_ = nullptr;
+    node->parent_ = parent;
+    update(node);
+    if (as_left) {
+      parent->left_ = node;
+    } else {
+      parent->right_ = node;
+    }
+    fixUpward(parent, header);
+  }
+
+  // Unlinks node from the tree without touching its data; the caller frees
+  // it. A node with two children is replaced by relinking its in-order
+  // successor into its place, so iterators to every other element stay
+  // valid. Unlike insertion, every ancestor may need a rotation.
+  static void erase(Node *node, Node *header) {
+    Node *parent = node->parent_;
+    Node *lowest = parent;
+    if (node->left_ && node->right_) {
+      Node *successor = node->right_;
+      while (successor->left_) {
+        successor = successor->left_;
+      }
+      if (successor->parent_ == node) {
+        lowest = successor;
+      } else {
+        lowest = successor->parent_;
+        lowest->left_ = successor->right_;
+        if (successor->right_) {
+          successor->right_->parent_ = lowest;
+        }
+        successor->right_ = node->right_;
+        node->right_->parent_ = successor;
+      }
+      successor->left_ = node->left_;
+      node->left_->parent_ = successor;
+      successor->parent_ = parent;
+      successor->height_ = node->height_;
+      replaceChild(parent, node, successor);
+    } else {
+      Node *child = node->left_ ? node->left_ : node->right_;
+      if (child) {
+        child->parent_ = parent;
+      }
+      replaceChild(parent, node, child);
+    }
+    fixUpward(lowest, header);
+  }
+
+  // Whether merging source elements into a target of the given size is
+  // cheaper as one linear pass over both (flatten, merge, rebuild) than as
+  // source descents of about log2(target + source) comparisons each.
+  static bool preferLinearMerge(size_t target, size_t source) noexcept {
+    size_t total = target + source;
+    size_t depth = 1;
+    while (total >> depth) {
+      ++depth;
+    }
+    return source * depth >= total;
+  }
+
+  // Turns the subtree into a list in key order threaded through right_,
+  // followed by tail, and returns its head. Only the links change.
+  static Node *flatten(Node *node, Node *tail) noexcept {
+    while (node) {
+      Node *left = node->left_;
+      node->right_ = flatten(node->right_, tail);
+      node->left_ = nullptr;
+      tail = node;
+      node = left;
+    }
+    return tail;
+  }
+
+  // Builds a balanced subtree under parent out of the first count nodes
+  // of a right_-threaded list, advancing list past them.
+  static Node *buildFromList(Node *&list, size_t count, Node *parent) {
+    if (count == 0) {
+      return nullptr;
+    }
+    size_t left_count = count / 2;
+    Node *left = buildFromList(list, left_count, nullptr);
+    Node *node = list;
+    list = list->right_;
+    node->parent_ = parent;
+    node->left_ = left;
+    if (left) {
+      left->parent_ = node;
+    }
+    node->right_ = buildFromList(list, count - left_count - 1, node);
+    update(node);
+    return node;
+  }
+
+ private:
+  // Rebalances from node up while heights keep changing, then refreshes
+  // the remaining ancestors' counts and summaries.
+  static void fixUpward(Node *node, Node *header) {
+    while (node != header) {
+      int old_height = node->height_;
+      Node *subtree = rebalance(node);
+      node = subtree->parent_;
+      if (subtree->height_ == old_height) {
+        break;
+      }
+    }
+    for (; node != header; node = node->parent_) {
+      update(node);
+    }
+  }
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_ADT_AVL_BALANCE_H_
@@ -0,0 +1,98 @@
+#ifndef CPP2_S21_CONTAINERS_1_ADT_NODE_HANDLE_H_
+#define CPP2_S21_CONTAINERS_1_ADT_NODE_HANDLE_H_
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace s21 {
+
+// Owns one node taken out of a node-based container by extract(), until
+// insert() hangs it into a container again. Handing a node over only
+// moves this pointer: the element is never copied and no memory changes
+// hands, so moving an entry between containers costs no allocation. A
+// handle that still owns its node on destruction frees it.
+//
+// Node keeps its element in data_ and, with a Monoid (see AvlBalance),
+// a separately constructed summary_. Containers derive their node_type
+// from this and add the accessors for their element.
+template <typename Node, typename Allocator, typename NodeAllocator,
+          typename Monoid = void>
+class NodeHandle {
+ public:
+  using allocator_type = Allocator;
+
+  NodeHandle() noexcept : node_(nullptr) {}
+
+  NodeHandle(NodeHandle &&other) noexcept
+      : node_(std::exchange(other.node_, nullptr)),
+        allocator_(std::move(other.allocator_)),
+        allocator_node_(std::move(other.allocator_node_)) {}
+
+  NodeHandle &operator=(NodeHandle &&other) noexcept {
+    if (this != &other) {
+      reset();
+      node_ = std::exchange(other.node_, nullptr);
+      allocator_ = std::move(other.allocator_);
+      allocator_node_ = std::move(other.allocator_node_);
+    }
+    return *this;
+  }
+
+  NodeHandle(const NodeHandle &) = delete;
+  NodeHandle &operator=(const NodeHandle &) = delete;
+
+  ~NodeHandle() { reset(); }
+
+  bool empty() const noexcept { return node_ == nullptr; }
+  explicit operator bool() const noexcept { return node_ != nullptr; }
+
+  allocator_type get_allocator() const { return allocator_; }
+
+  void swap(NodeHandle &other) noexcept {
+    std::swap(node_, other.node_);
+    std::swap(allocator_, other.allocator_);
+    std::swap(allocator_node_, other.allocator_node_);
+  }
+
+ protected:
+  NodeHandle(Node *node, const Allocator &alloc,
+             const NodeAllocator &alloc_node) noexcept
+      : node_(node), allocator_(alloc), allocator_node_(alloc_node) {}
+
+  // Gives the node up to a container.
+  Node *release() noexcept { return std::exchange(node_, nullptr); }
+
+  Node *node_;
+
+ private:
+  void reset() noexcept {
+    if (node_ == nullptr) {
+      return;
+    }
+    if constexpr (!std::is_void_v<Monoid>) {
+      using summary_type = typename Monoid::value_type;
+      node_->summary_.~summary_type();
+    }
+    std::allocator_traits<Allocator>::destroy(allocator_, &(node_->data_));
+    std::allocator_traits<NodeAllocator>::deallocate(allocator_node_, node_,
+                                                     1);
+    node_ = nullptr;
+  }
+
+  Allocator allocator_;
+  NodeAllocator allocator_node_;
+};
+
+// What insert(node_type&&) returns for containers with unique keys: where
+// the key now is, whether the node went in and, if not, the node back.
+template <typename Iterator, typename NodeType>
+struct InsertReturnType {
+  Iterator position;
+  bool inserted;
+  NodeType node;
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_ADT_NODE_HANDLE_H_
@@ -0,0 +1,95 @@
+#ifndef CPP2_S21_CONTAINERS_1_ADT_RING_BUFFER_H_
+#define CPP2_S21_CONTAINERS_1_ADT_RING_BUFFER_H_
+
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include "../../utils/allocator.h"
+
+namespace s21 {
+
+// Fixed-capacity circular buffer. Not thread-safe: the concurrent queues
+// that use it provide their own synchronization.
+template <typename T, typename Allocator = Allocator<T>>
+class RingBuffer {
+ public:
+  using value_type = T;
+  using reference = T &;
+  using const_reference = const T &;
+  using size_type = size_t;
+  using allocator_type = Allocator;
+
+  explicit RingBuffer(size_type capacity, const Allocator &alloc = Allocator())
+      : allocator_(
+            std::allocator_traits<
+                allocator_type>::select_on_container_copy_construction(alloc)),
+        capacity_(capacity),
+        head_(0),
+        size_(0),
+        data_(nullptr) {
+    if (capacity_ == 0) {
+      throw std::invalid_argument("RingBuffer capacity must be positive");
+    }
+    data_ = std::allocator_traits<allocator_type>::allocate(allocator_,
+                                                            capacity_);
+  }
+
+  RingBuffer(const RingBuffer &) = delete;
+  RingBuffer &operator=(const RingBuffer &) = delete;
+
+  ~RingBuffer() {
+    clear();
+    std::allocator_traits<allocator_type>::deallocate(allocator_, data_,
+                                                      capacity_);
+  }
+
+  reference front() { return data_[head_]; }
+
+  reference back() { return data_[index(size_ - 1)]; }
+
+  bool empty() const noexcept { return size_ == 0; }
+
+  bool full() const noexcept { return size_ == capacity_; }
+
+  size_type size() const noexcept { return size_; }
+
+  size_type capacity() const noexcept { return capacity_; }
+
+  template <typename... Args>
+  void emplace_back(Args &&...args) {
+    std::allocator_traits<allocator_type>::construct(
+        allocator_, data_ + index(size_), std::forward<Args>(args)...);
+    ++size_;
+  }
+
+  void pop_front() {
+    std::allocator_traits<allocator_type>::destroy(allocator_, data_ + head_);
+    head_ = index(1);
+    --size_;
+  }
+
+  void clear() {
+    while (!empty()) {
+      pop_front();
+    }
+  }
+
+ private:
+  size_type index(size_type offset) const noexcept {
+    size_type pos = head_ + offset;
+    return pos >= capacity_ ? pos - capacity_ : pos;
+  }
+
+ private:
+  allocator_type allocator_;
+  size_type capacity_;
+  size_type head_;
+  size_type size_;
+  T *data_;
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_ADT_RING_BUFFER_H_
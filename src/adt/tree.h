@@ -2,6 +2,7 @@
 #define CPP2_S21_CONTAINERS_S21_CONTAINERS_ADT_TREE_H_
 
 #include <iostream>
+#include <limits>
 
 namespace s21 {
 template <typename Key, typename Value>
@@ -97,6 +98,9 @@ class Tree {
 
   // проверки рекурсией
   bool RecuInsert(Node *node, const Key &key, Value value);
+  void RecuLink(Node *node, Node *leaf);
+  void LinkNode(Node *node);
+  void MoveNodes(Node *node, Tree &other);
   Node *RecuDelete(Node *node, Key key);
   size_t RecuSize(Node *node);
   Node *RecuFind(Node *node, const Key &key);
@@ -147,11 +151,8 @@ typename Tree<Key, Value>::Iterator Tree<Key, Value>::begin() {
 
 template <typename Key, typename Value>
 typename Tree<Key, Value>::Iterator Tree<Key, Value>::end() {
-  if (root_ == nullptr) return begin();
-
-  Node *last_node = GetMax(root_);
-  Iterator test(nullptr, last_node);
-  return test;
+  // Only --end() needs the last node, so it is looked up from the root there.
+  return Iterator(nullptr, root_);
 }
 
 template <typename Key, typename Value>
@@ -203,14 +204,14 @@ void Tree<Key, Value>::swap(Tree &other) {
   std::swap(root_, other.root_);
 }
 
+// Nodes are taken apart from other and relinked one by one, into this tree
+// or back into other when the key is already here: no copy, no allocation.
 template <typename Key, typename Value>
 void Tree<Key, Value>::merge(Tree &other) {
-  Tree const_tree(other);
-  Iterator const_it = const_tree.begin();
-  for (; const_it != const_tree.end(); ++const_it) {
-    std::pair<Iterator, bool> pr = insert(*const_it);
-    if (pr.second) other.erase(pr.first);
-  }
+  if (this == &other) return;
+  Node *nodes = other.root_;
+  other.root_ = nullptr;
+  MoveNodes(nodes, other);
 }
 
 template <typename Key, typename Value>
@@ -265,13 +266,10 @@ Tree<Key, Value>::Iterator::Iterator(Tree::Node *node, Tree::Node *last_node)
 
 template <typename Key, typename Value>
 typename Tree<Key, Value>::Iterator &Tree<Key, Value>::Iterator::operator++() {
-  Node *tmp;
-  if (iter_node_ != nullptr) {
-    tmp = GetMax(iter_node_);
-  }
+  Node *current = iter_node_;
   iter_node_ = Forward(iter_node_);
   if (iter_node_ == nullptr) {
-    iter_last_node_ = tmp;
+    iter_last_node_ = current;
   }
   return *this;
 }
@@ -287,7 +285,7 @@ typename Tree<Key, Value>::Iterator Tree<Key, Value>::Iterator::operator++(
 template <typename Key, typename Value>
 typename Tree<Key, Value>::Iterator &Tree<Key, Value>::Iterator::operator--() {
   if (iter_node_ == nullptr && iter_last_node_ != nullptr) {
-    *this = iter_last_node_;
+    iter_node_ = GetMax(iter_last_node_);
     return *this;
   }
   iter_node_ = Back(iter_node_);
@@ -449,16 +447,14 @@ void Tree<Key, Value>::Balance(Node *node) {  // какой вид поворо
 
 template <typename Key, typename Value>
 typename Tree<Key, Value>::Node *Tree<Key, Value>::GetMin(Tree::Node *node) {
-  if (node == nullptr) return nullptr;
-  if (node->left_ == nullptr) return node;
-  return GetMin(node->left_);
+  while (node != nullptr && node->left_ != nullptr) node = node->left_;
+  return node;
 }
 
 template <typename Key, typename Value>
 typename Tree<Key, Value>::Node *Tree<Key, Value>::GetMax(Tree::Node *node) {
-  if (node == nullptr) return nullptr;
-  if (node->right_ == nullptr) return node;
-  return GetMax(node->right_);
+  while (node != nullptr && node->right_ != nullptr) node = node->right_;
+  return node;
 }
 
 // рекурсивные функции, мать всех событий
@@ -498,6 +494,45 @@ bool Tree<Key, Value>::RecuInsert(Tree::Node *node, const Key &key,
   return is_insert;
 }
 
+template <typename Key, typename Value>
+void Tree<Key, Value>::RecuLink(Tree::Node *node, Tree::Node *leaf) {
+  Node *&child = leaf->key_ < node->key_ ? node->left_ : node->right_;
+  if (child == nullptr) {
+    child = leaf;
+    leaf->parent_ = node;
+  } else {
+    RecuLink(child, leaf);
+  }
+  SetHeight(node);
+  Balance(node);
+}
+
+template <typename Key, typename Value>
+void Tree<Key, Value>::LinkNode(Tree::Node *node) {  // готовый узел как лист
+  node->left_ = nullptr;
+  node->right_ = nullptr;
+  node->parent_ = nullptr;
+  node->height_ = 0;
+  if (root_ == nullptr) {
+    root_ = node;
+  } else {
+    RecuLink(root_, node);
+  }
+}
+
+template <typename Key, typename Value>
+void Tree<Key, Value>::MoveNodes(Tree::Node *node, Tree &other) {
+  if (node == nullptr) return;
+  // сначала дети: после LinkNode у узла уже другие указатели
+  MoveNodes(node->left_, other);
+  MoveNodes(node->right_, other);
+  if (RecuFind(root_, node->key_) == nullptr) {
+    LinkNode(node);
+  } else {
+    other.LinkNode(node);
+  }
+}
+
 template <typename Key, typename Value>
 typename Tree<Key, Value>::Node *Tree<Key, Value>::RecuDelete(Tree::Node *node,
                                                               Key key) {
@@ -0,0 +1,990 @@
+#ifndef CPP2_S21_CONTAINERS_1_BTREE_BTREE_H_
+#define CPP2_S21_CONTAINERS_1_BTREE_BTREE_H_
+
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "../../utils/cache_line.h"
+#include "../../utils/is_transparent.h"
+#include "../iterators/iterator_tree.h"
+
+namespace s21 {
+
+// B+-tree shared by btree_map and btree_set. Elements live only in the
+// leaves, stored contiguously and chained to their neighbours, so a scan
+// walks whole arrays; inner nodes hold copies of separator keys next to
+// each other followed by their child pointers. Both node kinds are sized
+// to about four cache lines, which puts dozens of keys behind every cache
+// miss instead of one.
+//
+// Inside a node, arithmetic keys under std::less are located by counting
+// the smaller keys over the whole node, a branch-free loop the compiler
+// turns into SIMD compares; other keys use binary search.
+//
+// Insertions and erasures shift elements inside nodes and move them
+// between nodes, so like absl::btree_map they invalidate every iterator.
+//
+// KeyOf maps an element to its key through a static of().
+template <typename Key, typename Value, typename KeyOf, typename Compare,
+          typename Allocator>
+class BTree {
+  struct Node {
+    bool leaf_;
+    int count_;
+  };
+
+  static constexpr int slotsFor(size_t bytes, size_t per_slot) {
+    size_t slots = bytes / per_slot;
+    return slots < 4 ? 4 : (slots > 255 ? 255 : static_cast<int>(slots));
+  }
+
+  static constexpr size_t kNodeBytes = 4 * kCacheLineSize;
+  static constexpr int kLeafSlots = slotsFor(kNodeBytes, sizeof(Value));
+  static constexpr int kInnerSlots =
+      slotsFor(kNodeBytes, sizeof(Key) + sizeof(Node *));
+  static constexpr int kMinLeaf = kLeafSlots / 2;
+  static constexpr int kMinInner = kInnerSlots / 2;
+  // Non-root inner nodes have at least three children.
+  static constexpr int kMaxDepth = 48;
+
+  struct Leaf : Node {
+    Value *values() noexcept { return reinterpret_cast<Value *>(storage_); }
+
+    Leaf *prev_;
+    Leaf *next_;
+    alignas(Value) unsigned char storage_[sizeof(Value) * kLeafSlots];
+  };
+
+  struct Inner : Node {
+    Key *keys() noexcept { return reinterpret_cast<Key *>(storage_); }
+
+    alignas(Key) unsigned char storage_[sizeof(Key) * kInnerSlots];
+    Node *children_[kInnerSlots + 1];
+  };
+
+  // The inner nodes passed on the way down and the child taken in each.
+  struct Path {
+    Inner *nodes_[kMaxDepth];
+    int slots_[kMaxDepth];
+    int depth_;
+  };
+
+  using leaf_allocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<Leaf>;
+  using inner_allocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<Inner>;
+
+  template <bool kConst>
+  class Iterator {
+    friend class BTree;
+    template <bool>
+    friend class Iterator;
+
+   public:
+    using value_type = Value;
+    using difference_type = ptrdiff_t;
+    using pointer = std::conditional_t<kConst, const Value *, Value *>;
+    using reference = std::conditional_t<kConst, const Value &, Value &>;
+    using iterator_category = std::bidirectional_iterator_tag;
+
+    Iterator() : tree_(nullptr), leaf_(nullptr), slot_(0) {}
+
+    template <bool kOther, std::enable_if_t<kConst && !kOther, int> = 0>
+    Iterator(const Iterator<kOther> &other)
+        : tree_(other.tree_), leaf_(other.leaf_), slot_(other.slot_) {}
+
+    reference operator*() const { return leaf_->values()[slot_]; }
+    pointer operator->() const { return leaf_->values() + slot_; }
+
+    Iterator &operator++() {
+      if (++slot_ == leaf_->count_) {
+        leaf_ = leaf_->next_;
+        slot_ = 0;
+      }
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      Iterator temp = *this;
+      ++(*this);
+      return temp;
+    }
+
+    Iterator &operator--() {
+      if (leaf_ == nullptr) {
+        leaf_ = tree_->last_;
+        slot_ = leaf_->count_ - 1;
+      } else if (slot_ == 0) {
+        leaf_ = leaf_->prev_;
+        slot_ = leaf_->count_ - 1;
+      } else {
+        --slot_;
+      }
+      return *this;
+    }
+
+    Iterator operator--(int) {
+      Iterator temp = *this;
+      --(*this);
+      return temp;
+    }
+
+    bool operator==(const Iterator &rhs) const noexcept {
+      return leaf_ == rhs.leaf_ && slot_ == rhs.slot_;
+    }
+
+    bool operator!=(const Iterator &rhs) const noexcept {
+      return !(*this == rhs);
+    }
+
+   private:
+    Iterator(const BTree *tree, Leaf *leaf, int slot)
+        : tree_(tree), leaf_(leaf), slot_(slot) {}
+
+    const BTree *tree_;
+    // nullptr for end().
+    Leaf *leaf_;
+    int slot_;
+  };
+
+ public:
+  using key_type = Key;
+  using value_type = Value;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  // Set elements are keys, so even the plain iterator is read-only.
+  using iterator = Iterator<std::is_same_v<Key, Value>>;
+  using const_iterator = Iterator<true>;
+  using size_type = size_t;
+  using allocator_type = Allocator;
+
+  explicit BTree(const Compare &compare = Compare(),
+                 const Allocator &alloc = Allocator())
+      : compare_(compare),
+        allocator_(alloc),
+        leaf_allocator_(alloc),
+        inner_allocator_(alloc),
+        root_(nullptr),
+        first_(nullptr),
+        last_(nullptr),
+        size_(0) {}
+
+  BTree(const BTree &other)
+      : compare_(other.compare_),
+        allocator_(std::allocator_traits<Allocator>::
+                       select_on_container_copy_construction(other.allocator_)),
+        leaf_allocator_(allocator_),
+        inner_allocator_(allocator_),
+        root_(nullptr),
+        first_(nullptr),
+        last_(nullptr),
+        size_(0) {
+    if (other.root_) {
+      Leaf *previous = nullptr;
+      root_ = copyNode(other.root_, previous);
+      last_ = previous;
+      size_ = other.size_;
+    }
+  }
+
+  BTree(BTree &&other) noexcept
+      : compare_(std::move(other.compare_)),
+        allocator_(std::move(other.allocator_)),
+        leaf_allocator_(std::move(other.leaf_allocator_)),
+        inner_allocator_(std::move(other.inner_allocator_)),
+        root_(std::exchange(other.root_, nullptr)),
+        first_(std::exchange(other.first_, nullptr)),
+        last_(std::exchange(other.last_, nullptr)),
+        size_(std::exchange(other.size_, 0)) {}
+
+  ~BTree() { clear(); }
+
+  BTree &operator=(const BTree &other) {
+    if (this != &other) {
+      BTree copy(other);
+      swap(copy);
+    }
+    return *this;
+  }
+
+  BTree &operator=(BTree &&other) noexcept {
+    if (this != &other) {
+      clear();
+      swap(other);
+    }
+    return *this;
+  }
+
+  iterator begin() noexcept { return iterator(this, first_, 0); }
+  const_iterator begin() const noexcept {
+    return const_iterator(this, first_, 0);
+  }
+  iterator end() noexcept { return iterator(this, nullptr, 0); }
+  const_iterator end() const noexcept {
+    return const_iterator(this, nullptr, 0);
+  }
+
+  bool empty() const noexcept { return size_ == 0; }
+  size_type size() const noexcept { return size_; }
+  size_type max_size() const noexcept {
+    return std::numeric_limits<size_type>::max() / sizeof(value_type);
+  }
+
+  Compare key_comp() const { return compare_; }
+
+  void clear() noexcept {
+    if (root_) {
+      destroyNode(root_);
+    }
+    root_ = nullptr;
+    first_ = nullptr;
+    last_ = nullptr;
+    size_ = 0;
+  }
+
+  void swap(BTree &other) noexcept {
+    std::swap(compare_, other.compare_);
+    std::swap(allocator_, other.allocator_);
+    std::swap(leaf_allocator_, other.leaf_allocator_);
+    std::swap(inner_allocator_, other.inner_allocator_);
+    std::swap(root_, other.root_);
+    std::swap(first_, other.first_);
+    std::swap(last_, other.last_);
+    std::swap(size_, other.size_);
+  }
+
+  iterator find(const key_type &key) { return findImpl<iterator>(key); }
+  const_iterator find(const key_type &key) const {
+    return findImpl<const_iterator>(key);
+  }
+
+  template <typename K, typename C = Compare,
+            std::enable_if_t<is_transparent_v<C>, int> = 0>
+  iterator find(const K &key) {
+    return findImpl<iterator>(key);
+  }
+
+  template <typename K, typename C = Compare,
+            std::enable_if_t<is_transparent_v<C>, int> = 0>
+  const_iterator find(const K &key) const {
+    return findImpl<const_iterator>(key);
+  }
+
+  bool contains(const key_type &key) const { return find(key) != end(); }
+
+  template <typename K, typename C = Compare,
+            std::enable_if_t<is_transparent_v<C>, int> = 0>
+  bool contains(const K &key) const {
+    return find(key) != end();
+  }
+
+  size_type count(const key_type &key) const { return contains(key) ? 1 : 0; }
+
+  template <typename K, typename C = Compare,
+            std::enable_if_t<is_transparent_v<C>, int> = 0>
+  size_type count(const K &key) const {
+    return contains(key) ? 1 : 0;
+  }
+
+  iterator lower_bound(const key_type &key) {
+    return boundImpl<iterator>(key, false);
+  }
+  const_iterator lower_bound(const key_type &key) const {
+    return boundImpl<const_iterator>(key, false);
+  }
+
+  template <typename K, typename C = Compare,
+            std::enable_if_t<is_transparent_v<C>, int> = 0>
+  const_iterator lower_bound(const K &key) const {
+    return boundImpl<const_iterator>(key, false);
+  }
+
+  iterator upper_bound(const key_type &key) {
+    return boundImpl<iterator>(key, true);
+  }
+  const_iterator upper_bound(const key_type &key) const {
+    return boundImpl<const_iterator>(key, true);
+  }
+
+  template <typename K, typename C = Compare,
+            std::enable_if_t<is_transparent_v<C>, int> = 0>
+  const_iterator upper_bound(const K &key) const {
+    return boundImpl<const_iterator>(key, true);
+  }
+
+  std::pair<iterator, iterator> equal_range(const key_type &key) {
+    iterator first = lower_bound(key);
+    iterator last = first;
+    if (last != end() && !compare_(key, KeyOf::of(*last))) {
+      ++last;
+    }
+    return std::make_pair(first, last);
+  }
+
+  std::pair<const_iterator, const_iterator> equal_range(
+      const key_type &key) const {
+    const_iterator first = lower_bound(key);
+    const_iterator last = first;
+    if (last != end() && !compare_(key, KeyOf::of(*last))) {
+      ++last;
+    }
+    return std::make_pair(first, last);
+  }
+
+  // The elements with keys in [low, high); empty when high is not after
+  // low.
+  TreeRange<const_iterator> range(const key_type &low,
+                                  const key_type &high) const {
+    const_iterator first = lower_bound(low);
+    if (!compare_(low, high)) {
+      return TreeRange<const_iterator>(first, first);
+    }
+    return TreeRange<const_iterator>(first, lower_bound(high));
+  }
+
+  void erase(const_iterator pos) { eraseKey(KeyOf::of(*pos)); }
+
+  size_type erase(const key_type &key) { return eraseKey(key); }
+
+ protected:
+  // Inserts an element built from args unless key is already present. The
+  // element is built before anything moves, so key and args may refer to
+  // elements of this tree.
+  template <typename K, typename... Args>
+  std::pair<iterator, bool> emplaceUnique(const K &key, Args &&...args) {
+    if (root_ == nullptr) {
+      Leaf *leaf = newLeaf();
+      try {
+        constructValue(leaf->values(), std::forward<Args>(args)...);
+      } catch (...) {
+        freeLeaf(leaf);
+        throw;
+      }
+      leaf->count_ = 1;
+      root_ = leaf;
+      first_ = leaf;
+      last_ = leaf;
+      size_ = 1;
+      return std::make_pair(iterator(this, leaf, 0), true);
+    }
+    Path path;
+    Leaf *leaf = descend(key, path);
+    int slot = lowerIndex(leaf, key);
+    if (holdsKey(leaf, slot, key)) {
+      return std::make_pair(iterator(this, leaf, slot), false);
+    }
+    Value value(std::forward<Args>(args)...);
+    return std::make_pair(insertAt(path, leaf, slot, std::move(value)), true);
+  }
+
+  // Appends after the last element without comparing along the way; the
+  // caller has checked that value's key is greater than every key here.
+  iterator appendUnique(Value &&value) {
+    if (root_ == nullptr) {
+      return emplaceUnique(KeyOf::of(value), std::move(value)).first;
+    }
+    Path path;
+    path.depth_ = 0;
+    Node *node = root_;
+    while (!node->leaf_) {
+      Inner *inner = static_cast<Inner *>(node);
+      path.nodes_[path.depth_] = inner;
+      path.slots_[path.depth_++] = inner->count_;
+      node = inner->children_[inner->count_];
+    }
+    Leaf *leaf = static_cast<Leaf *>(node);
+    return insertAt(path, leaf, leaf->count_, std::move(value));
+  }
+
+  bool isAfterLast(const key_type &key) const {
+    return last_ == nullptr ||
+           compare_(KeyOf::of(last_->values()[last_->count_ - 1]), key);
+  }
+
+ private:
+  // Arithmetic keys under plain less are searched by counting.
+  template <typename K>
+  static constexpr bool kCountingSearch =
+      std::is_arithmetic_v<Key> && std::is_arithmetic_v<K> &&
+      (std::is_same_v<Compare, std::less<Key>> ||
+       std::is_same_v<Compare, std::less<>>);
+
+  template <typename T>
+  static const Key &keyOf(const T &item) noexcept {
+    if constexpr (std::is_same_v<T, Key>) {
+      return item;
+    } else {
+      return KeyOf::of(item);
+    }
+  }
+
+  // The number of items whose key is less than key (or, with upper, not
+  // greater than it).
+  template <typename T, typename K>
+  int searchItems(const T *items, int count, const K &key, bool upper) const {
+    if constexpr (kCountingSearch<K>) {
+      int index = 0;
+      if (upper) {
+        for (int i = 0; i < count; ++i) {
+          index += keyOf(items[i]) <= key;
+        }
+      } else {
+        for (int i = 0; i < count; ++i) {
+          index += keyOf(items[i]) < key;
+        }
+      }
+      return index;
+    } else {
+      int low = 0;
+      int high = count;
+      while (low < high) {
+        int middle = (low + high) / 2;
+        bool go_right = upper ? !compare_(key, keyOf(items[middle]))
+                              : compare_(keyOf(items[middle]), key);
+        if (go_right) {
+          low = middle + 1;
+        } else {
+          high = middle;
+        }
+      }
+      return low;
+    }
+  }
+
+  template <typename K>
+  int lowerIndex(Leaf *leaf, const K &key) const {
+    return searchItems(leaf->values(), leaf->count_, key, false);
+  }
+
+  // Whether the element at slot, the lower bound of key, has that key.
+  template <typename K>
+  bool holdsKey(Leaf *leaf, int slot, const K &key) const {
+    return slot < leaf->count_ &&
+           !compare_(key, KeyOf::of(leaf->values()[slot]));
+  }
+
+  // A separator equals the smallest key of the subtree to its right, so the
+  // child to follow comes after every separator not greater than key.
+  template <typename K>
+  Leaf *descend(const K &key, Path &path) const {
+    path.depth_ = 0;
+    Node *node = root_;
+    while (!node->leaf_) {
+      Inner *inner = static_cast<Inner *>(node);
+      int slot = searchItems(inner->keys(), inner->count_, key, true);
+      path.nodes_[path.depth_] = inner;
+      path.slots_[path.depth_++] = slot;
+      node = inner->children_[slot];
+    }
+    return static_cast<Leaf *>(node);
+  }
+
+  template <typename K>
+  Leaf *descend(const K &key) const {
+    Node *node = root_;
+    while (!node->leaf_) {
+      Inner *inner = static_cast<Inner *>(node);
+      node = inner->children_[searchItems(inner->keys(), inner->count_, key,
+                                          true)];
+    }
+    return static_cast<Leaf *>(node);
+  }
+
+  template <typename It, typename K>
+  It findImpl(const K &key) const {
+    if (root_ == nullptr) {
+      return It(this, nullptr, 0);
+    }
+    Leaf *leaf = descend(key);
+    int slot = lowerIndex(leaf, key);
+    if (holdsKey(leaf, slot, key)) {
+      return It(this, leaf, slot);
+    }
+    return It(this, nullptr, 0);
+  }
+
+  template <typename It, typename K>
+  It boundImpl(const K &key, bool upper) const {
+    if (root_ == nullptr) {
+      return It(this, nullptr, 0);
+    }
+    Leaf *leaf = descend(key);
+    int slot = searchItems(leaf->values(), leaf->count_, key, upper);
+    if (slot == leaf->count_) {
+      return It(this, leaf->next_, 0);
+    }
+    return It(this, leaf, slot);
+  }
+
+  // Element storage.
+
+  template <typename... Args>
+  void constructValue(Value *slot, Args &&...args) {
+    std::allocator_traits<Allocator>::construct(allocator_, slot,
+                                                std::forward<Args>(args)...);
+  }
+
+  void destroyValue(Value *slot) noexcept {
+    std::allocator_traits<Allocator>::destroy(allocator_, slot);
+  }
+
+  // Moves count items from source to the raw slots at target; the ranges
+  // may overlap. Trivially copyable items go through memmove.
+  template <typename T>
+  void relocate(T *target, T *source, int count) {
+    if (count <= 0 || target == source) {
+      return;
+    }
+    if constexpr (std::is_trivially_copyable_v<T>) {
+      std::memmove(static_cast<void *>(target), source,
+                   sizeof(T) * static_cast<size_t>(count));
+    } else if (target < source) {
+      for (int i = 0; i < count; ++i) {
+        relocateOne(target + i, source + i);
+      }
+    } else {
+      for (int i = count - 1; i >= 0; --i) {
+        relocateOne(target + i, source + i);
+      }
+    }
+  }
+
+  template <typename T>
+  void relocateOne(T *target, T *source) {
+    if constexpr (std::is_same_v<T, Value>) {
+      constructValue(target, std::move(*source));
+      destroyValue(source);
+    } else {
+      ::new (static_cast<void *>(target)) T(std::move(*source));
+      source->~T();
+    }
+  }
+
+  // Nodes.
+
+  Leaf *newLeaf() {
+    Leaf *leaf =
+        std::allocator_traits<leaf_allocator>::allocate(leaf_allocator_, 1);
+    leaf->leaf_ = true;
+    leaf->count_ = 0;
+    leaf->prev_ = nullptr;
+    leaf->next_ = nullptr;
+    return leaf;
+  }
+
+  Inner *newInner() {
+    Inner *inner =
+        std::allocator_traits<inner_allocator>::allocate(inner_allocator_, 1);
+    inner->leaf_ = false;
+    inner->count_ = 0;
+    return inner;
+  }
+
+  void freeLeaf(Leaf *leaf) noexcept {
+    std::allocator_traits<leaf_allocator>::deallocate(leaf_allocator_, leaf,
+                                                      1);
+  }
+
+  void freeInner(Inner *inner) noexcept {
+    std::allocator_traits<inner_allocator>::deallocate(inner_allocator_, inner,
+                                                       1);
+  }
+
+  void destroyNode(Node *node) noexcept {
+    if (node->leaf_) {
+      Leaf *leaf = static_cast<Leaf *>(node);
+      for (int i = 0; i < leaf->count_; ++i) {
+        destroyValue(leaf->values() + i);
+      }
+      freeLeaf(leaf);
+      return;
+    }
+    Inner *inner = static_cast<Inner *>(node);
+    for (int i = 0; i < inner->count_; ++i) {
+      inner->keys()[i].~Key();
+    }
+    for (int i = 0; i <= inner->count_; ++i) {
+      destroyNode(inner->children_[i]);
+    }
+    freeInner(inner);
+  }
+
+  // Clones source with the same shape, chaining the new leaves in order
+  // behind previous. A throwing copy releases whatever this call built.
+  Node *copyNode(const Node *source, Leaf *&previous) {
+    if (source->leaf_) {
+      const Leaf *from = static_cast<const Leaf *>(source);
+      Leaf *leaf = newLeaf();
+      try {
+        for (; leaf->count_ < from->count_; ++leaf->count_) {
+          constructValue(leaf->values() + leaf->count_,
+                         const_cast<Leaf *>(from)->values()[leaf->count_]);
+        }
+      } catch (...) {
+        destroyNode(leaf);
+        throw;
+      }
+      leaf->prev_ = previous;
+      if (previous) {
+        previous->next_ = leaf;
+      } else {
+        first_ = leaf;
+      }
+      previous = leaf;
+      return leaf;
+    }
+    const Inner *from = static_cast<const Inner *>(source);
+    Inner *inner = newInner();
+    int children = 0;
+    try {
+      for (; inner->count_ < from->count_; ++inner->count_) {
+        ::new (static_cast<void *>(inner->keys() + inner->count_))
+            Key(const_cast<Inner *>(from)->keys()[inner->count_]);
+      }
+      for (; children <= from->count_; ++children) {
+        inner->children_[children] =
+            copyNode(from->children_[children], previous);
+      }
+    } catch (...) {
+      for (int i = 0; i < inner->count_; ++i) {
+        inner->keys()[i].~Key();
+      }
+      for (int i = 0; i < children; ++i) {
+        destroyNode(inner->children_[i]);
+      }
+      freeInner(inner);
+      throw;
+    }
+    return inner;
+  }
+
+  // Insertion.
+
+  // Puts value at slot of leaf, splitting full nodes from the leaf up.
+  iterator insertAt(Path &path, Leaf *leaf, int slot, Value &&value) {
+    if (leaf->count_ < kLeafSlots) {
+      placeValue(leaf, slot, std::move(value));
+      ++size_;
+      return iterator(this, leaf, slot);
+    }
+    // Every node the split will need is allocated up front, so running
+    // out of memory leaves the tree as it was.
+    Leaf *right = newLeaf();
+    Inner *spares[kMaxDepth + 1];
+    int spare_count = 0;
+    try {
+      int level = path.depth_;
+      while (level > 0 && path.nodes_[level - 1]->count_ == kInnerSlots) {
+        spares[spare_count++] = newInner();
+        --level;
+      }
+      if (level == 0) {
+        spares[spare_count++] = newInner();
+      }
+    } catch (...) {
+      while (spare_count > 0) {
+        freeInner(spares[--spare_count]);
+      }
+      freeLeaf(right);
+      throw;
+    }
+    // Appending to the last leaf starts a new one instead of halving it,
+    // so ascending inserts leave full leaves behind.
+    int split = leaf->next_ == nullptr && slot == kLeafSlots ? kLeafSlots
+                                                            : kLeafSlots / 2;
+    relocate(right->values(), leaf->values() + split, kLeafSlots - split);
+    right->count_ = kLeafSlots - split;
+    leaf->count_ = split;
+    Leaf *target = slot <= split && split < kLeafSlots ? leaf : right;
+    int target_slot = target == leaf ? slot : slot - split;
+    bool placed = false;
+    try {
+      placeValue(target, target_slot, std::move(value));
+      placed = true;
+      Key separator(KeyOf::of(right->values()[0]));
+      ++size_;
+      right->next_ = leaf->next_;
+      right->prev_ = leaf;
+      if (leaf->next_) {
+        leaf->next_->prev_ = right;
+      } else {
+        last_ = right;
+      }
+      leaf->next_ = right;
+      insertIntoParent(path, std::move(separator), right, spares);
+    } catch (...) {
+      if (placed) {
+        destroyValue(target->values() + target_slot);
+        relocate(target->values() + target_slot,
+                 target->values() + target_slot + 1,
+                 --target->count_ - target_slot);
+      }
+      relocate(leaf->values() + leaf->count_, right->values(), right->count_);
+      leaf->count_ += right->count_;
+      while (spare_count > 0) {
+        freeInner(spares[--spare_count]);
+      }
+      freeLeaf(right);
+      throw;
+    }
+    return iterator(this, target, target_slot);
+  }
+
+  // Moving value in should not throw; if it does, the slot it was meant
+  // for is closed again.
+  void placeValue(Leaf *leaf, int slot, Value &&value) {
+    relocate(leaf->values() + slot + 1, leaf->values() + slot,
+             leaf->count_ - slot);
+    try {
+      constructValue(leaf->values() + slot, std::move(value));
+    } catch (...) {
+      relocate(leaf->values() + slot, leaf->values() + slot + 1,
+               leaf->count_ - slot);
+      throw;
+    }
+    ++leaf->count_;
+  }
+
+  // Hangs right (whose smallest key is separator) next to the deepest
+  // child on path, splitting inner nodes into spares while they are full.
+  void insertIntoParent(Path &path, Key &&separator, Node *right,
+                        Inner **spares) noexcept {
+    Key key(std::move(separator));
+    for (int level = path.depth_; level > 0; --level) {
+      Inner *parent = path.nodes_[level - 1];
+      int slot = path.slots_[level - 1];
+      if (parent->count_ < kInnerSlots) {
+        insertIntoInner(parent, slot, std::move(key), right);
+        return;
+      }
+      Inner *sibling = *spares++;
+      Key promoted = splitInner(parent, sibling, slot, std::move(key), right);
+      key = std::move(promoted);
+      right = sibling;
+    }
+    Inner *root = *spares;
+    ::new (static_cast<void *>(root->keys())) Key(std::move(key));
+    root->count_ = 1;
+    root->children_[0] = root_;
+    root->children_[1] = right;
+    root_ = root;
+  }
+
+  // Inserts key at slot and child right after it into a non-full node.
+  void insertIntoInner(Inner *inner, int slot, Key &&key, Node *child) {
+    relocate(inner->keys() + slot + 1, inner->keys() + slot,
+             inner->count_ - slot);
+    ::new (static_cast<void *>(inner->keys() + slot)) Key(std::move(key));
+    std::memmove(inner->children_ + slot + 2, inner->children_ + slot + 1,
+                 sizeof(Node *) * static_cast<size_t>(inner->count_ - slot));
+    inner->children_[slot + 1] = child;
+    ++inner->count_;
+  }
+
+  // Splits a full node while inserting key at slot (child after it): the
+  // upper half goes to sibling and the middle key is returned to go up.
+  Key splitInner(Inner *node, Inner *sibling, int slot, Key &&key,
+                 Node *child) {
+    constexpr int middle = (kInnerSlots + 1) / 2;
+    if (slot == middle) {
+      relocate(sibling->keys(), node->keys() + middle, kInnerSlots - middle);
+      std::memcpy(sibling->children_ + 1, node->children_ + middle + 1,
+                  sizeof(Node *) * static_cast<size_t>(kInnerSlots - middle));
+      sibling->children_[0] = child;
+      sibling->count_ = kInnerSlots - middle;
+      node->count_ = middle;
+      return std::move(key);
+    }
+    int moved_from = slot < middle ? middle : middle + 1;
+    Key promoted(std::move(node->keys()[moved_from - 1]));
+    node->keys()[moved_from - 1].~Key();
+    relocate(sibling->keys(), node->keys() + moved_from,
+             kInnerSlots - moved_from);
+    std::memcpy(sibling->children_, node->children_ + moved_from,
+                sizeof(Node *) * static_cast<size_t>(kInnerSlots - moved_from +
+                                                    1));
+    sibling->count_ = kInnerSlots - moved_from;
+    node->count_ = moved_from - 1;
+    if (slot < middle) {
+      insertIntoInner(node, slot, std::move(key), child);
+    } else {
+      insertIntoInner(sibling, slot - moved_from, std::move(key), child);
+    }
+    return promoted;
+  }
+
+  // Erasure.
+
+  template <typename K>
+  size_type eraseKey(const K &key) {
+    if (root_ == nullptr) {
+      return 0;
+    }
+    Path path;
+    Leaf *leaf = descend(key, path);
+    int slot = lowerIndex(leaf, key);
+    if (!holdsKey(leaf, slot, key)) {
+      return 0;
+    }
+    destroyValue(leaf->values() + slot);
+    relocate(leaf->values() + slot, leaf->values() + slot + 1,
+             leaf->count_ - slot - 1);
+    --leaf->count_;
+    --size_;
+    rebalanceAfterErase(path);
+    return 1;
+  }
+
+  // Walks up from the leaf of path while nodes are below half full,
+  // borrowing one entry from a sibling that can spare it or else merging
+  // with a sibling, which takes an entry out of the parent in turn.
+  void rebalanceAfterErase(Path &path) {
+    for (int level = path.depth_; level > 0; --level) {
+      Inner *parent = path.nodes_[level - 1];
+      int slot = path.slots_[level - 1];
+      Node *node = parent->children_[slot];
+      if (node->count_ >= minCount(node)) {
+        break;
+      }
+      Node *left = slot > 0 ? parent->children_[slot - 1] : nullptr;
+      Node *right = slot < parent->count_ ? parent->children_[slot + 1]
+                                          : nullptr;
+      if (left && left->count_ > minCount(left)) {
+        borrowFromLeft(parent, slot);
+        break;
+      }
+      if (right && right->count_ > minCount(right)) {
+        borrowFromRight(parent, slot);
+        break;
+      }
+      mergeChildren(parent, left ? slot - 1 : slot);
+    }
+    if (root_->leaf_) {
+      if (root_->count_ == 0) {
+        freeLeaf(static_cast<Leaf *>(root_));
+        root_ = nullptr;
+        first_ = nullptr;
+        last_ = nullptr;
+      }
+    } else if (root_->count_ == 0) {
+      Inner *old_root = static_cast<Inner *>(root_);
+      root_ = old_root->children_[0];
+      freeInner(old_root);
+    }
+  }
+
+  static int minCount(const Node *node) noexcept {
+    return node->leaf_ ? kMinLeaf : kMinInner;
+  }
+
+  void borrowFromLeft(Inner *parent, int slot) {
+    Node *node = parent->children_[slot];
+    Node *left = parent->children_[slot - 1];
+    if (node->leaf_) {
+      Leaf *to = static_cast<Leaf *>(node);
+      Leaf *from = static_cast<Leaf *>(left);
+      relocate(to->values() + 1, to->values(), to->count_);
+      relocate(to->values(), from->values() + from->count_ - 1, 1);
+      parent->keys()[slot - 1] = KeyOf::of(to->values()[0]);
+    } else {
+      Inner *to = static_cast<Inner *>(node);
+      Inner *from = static_cast<Inner *>(left);
+      relocate(to->keys() + 1, to->keys(), to->count_);
+      relocate(to->keys(), parent->keys() + slot - 1, 1);
+      relocate(parent->keys() + slot - 1, from->keys() + from->count_ - 1, 1);
+      std::memmove(to->children_ + 1, to->children_,
+                   sizeof(Node *) * static_cast<size_t>(to->count_ + 1));
+      to->children_[0] = from->children_[from->count_];
+    }
+    ++node->count_;
+    --left->count_;
+  }
+
+  void borrowFromRight(Inner *parent, int slot) {
+    Node *node = parent->children_[slot];
+    Node *right = parent->children_[slot + 1];
+    if (node->leaf_) {
+      Leaf *to = static_cast<Leaf *>(node);
+      Leaf *from = static_cast<Leaf *>(right);
+      relocate(to->values() + to->count_, from->values(), 1);
+      relocate(from->values(), from->values() + 1, from->count_ - 1);
+      parent->keys()[slot] = KeyOf::of(from->values()[0]);
+    } else {
+      Inner *to = static_cast<Inner *>(node);
+      Inner *from = static_cast<Inner *>(right);
+      relocate(to->keys() + to->count_, parent->keys() + slot, 1);
+      relocate(parent->keys() + slot, from->keys(), 1);
+      relocate(from->keys(), from->keys() + 1, from->count_ - 1);
+      to->children_[to->count_ + 1] = from->children_[0];
+      std::memmove(from->children_, from->children_ + 1,
+                   sizeof(Node *) * static_cast<size_t>(from->count_));
+    }
+    ++node->count_;
+    --right->count_;
+  }
+
+  // Folds children slot + 1 into children slot and drops the separator
+  // between them from parent.
+  void mergeChildren(Inner *parent, int slot) {
+    Node *left = parent->children_[slot];
+    Node *right = parent->children_[slot + 1];
+    if (left->leaf_) {
+      Leaf *to = static_cast<Leaf *>(left);
+      Leaf *from = static_cast<Leaf *>(right);
+      relocate(to->values() + to->count_, from->values(), from->count_);
+      to->count_ += from->count_;
+      to->next_ = from->next_;
+      if (from->next_) {
+        from->next_->prev_ = to;
+      } else {
+        last_ = to;
+      }
+      freeLeaf(from);
+    } else {
+      Inner *to = static_cast<Inner *>(left);
+      Inner *from = static_cast<Inner *>(right);
+      relocate(to->keys() + to->count_, parent->keys() + slot, 1);
+      relocate(to->keys() + to->count_ + 1, from->keys(), from->count_);
+      std::memcpy(to->children_ + to->count_ + 1, from->children_,
+                  sizeof(Node *) * static_cast<size_t>(from->count_ + 1));
+      to->count_ += from->count_ + 1;
+      freeInner(from);
+      // The separator was moved down; close its slot without destroying.
+      relocate(parent->keys() + slot, parent->keys() + slot + 1,
+               parent->count_ - slot - 1);
+      removeChild(parent, slot + 1);
+      return;
+    }
+    parent->keys()[slot].~Key();
+    relocate(parent->keys() + slot, parent->keys() + slot + 1,
+             parent->count_ - slot - 1);
+    removeChild(parent, slot + 1);
+  }
+
+  static void removeChild(Inner *parent, int child) noexcept {
+    std::memmove(parent->children_ + child, parent->children_ + child + 1,
+                 sizeof(Node *) * static_cast<size_t>(parent->count_ - child));
+    --parent->count_;
+  }
+
+ private:
+  Compare compare_;
+  Allocator allocator_;
+  leaf_allocator leaf_allocator_;
+  inner_allocator inner_allocator_;
+  Node *root_;
+  Leaf *first_;
+  Leaf *last_;
+  size_t size_;
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_BTREE_BTREE_H_
@@ -0,0 +1,215 @@
+#ifndef CPP2_S21_CONTAINERS_1_BTREE_BTREE_MAP_H_
+#define CPP2_S21_CONTAINERS_1_BTREE_BTREE_MAP_H_
+
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "btree.h"
+
+namespace s21 {
+
+template <typename Key, typename T>
+struct BTreeMapKey {
+  static const Key &of(const std::pair<const Key, T> &item) noexcept {
+    return item.first;
+  }
+};
+
+// s21::map over a B+-tree: the same interface, but elements sit in
+// contiguous leaves, which makes lookups and scans far friendlier to the
+// cache. Unlike s21::map, every insertion or erasure invalidates all
+// iterators and references.
+template <class Key, class T, class Compare = std::less<Key>,
+          class Allocator = std::allocator<std::pair<const Key, T>>>
+class btree_map
+    : public BTree<Key, std::pair<const Key, T>, BTreeMapKey<Key, T>, Compare,
+                   Allocator> {
+  using Base = BTree<Key, std::pair<const Key, T>, BTreeMapKey<Key, T>,
+                     Compare, Allocator>;
+
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using iterator = typename Base::iterator;
+  using const_iterator = typename Base::const_iterator;
+  using size_type = size_t;
+  using allocator_type = Allocator;
+
+  btree_map(const Allocator &alloc = Allocator()) : Base(Compare(), alloc) {}
+
+  explicit btree_map(const Compare &compare,
+                     const Allocator &alloc = Allocator())
+      : Base(compare, alloc) {}
+
+  btree_map(std::initializer_list<value_type> const &items,
+            const Allocator &alloc = Allocator())
+      : Base(Compare(), alloc) {
+    for (auto &item : items) {
+      insert(item);
+    }
+  }
+
+  // Builds the tree by appending a range sorted in strictly ascending key
+  // order, which fills every leaf but the last.
+  template <typename ForwardIt>
+  static btree_map from_sorted(ForwardIt first, ForwardIt last,
+                               const Allocator &alloc = Allocator()) {
+    btree_map result(alloc);
+    for (; first != last; ++first) {
+      if (!result.isAfterLast(first->first)) {
+        throw std::invalid_argument(
+            "from_sorted needs strictly ascending keys");
+      }
+      result.appendUnique(value_type(*first));
+    }
+    return result;
+  }
+
+  template <typename Range>
+  static btree_map from_sorted(const Range &range) {
+    return from_sorted(std::begin(range), std::end(range));
+  }
+
+  mapped_type &at(const key_type &key) {
+    iterator it = this->find(key);
+    if (it == this->end()) {
+      throw std::out_of_range("Key not in map");
+    }
+    return it->second;
+  }
+
+  const mapped_type &at(const key_type &key) const {
+    const_iterator it = this->find(key);
+    if (it == this->end()) {
+      throw std::out_of_range("Key not in map");
+    }
+    return it->second;
+  }
+
+  // Inserts a value-initialised element when key is missing.
+  mapped_type &operator[](const key_type &key) {
+    return try_emplace(key).first->second;
+  }
+
+  mapped_type &operator[](key_type &&key) {
+    return try_emplace(std::move(key)).first->second;
+  }
+
+  std::pair<iterator, bool> insert(const_reference value) {
+    return this->emplaceUnique(value.first, value);
+  }
+
+  std::pair<iterator, bool> insert(value_type &&value) {
+    return this->emplaceUnique(value.first, std::move(value));
+  }
+
+  // Appending through an end() hint skips the key search.
+  iterator insert(const_iterator hint, const_reference value) {
+    if (hint == this->end() && this->isAfterLast(value.first)) {
+      return this->appendUnique(value_type(value));
+    }
+    return insert(value).first;
+  }
+
+  std::pair<iterator, bool> insert(const key_type &key,
+                                   const mapped_type &obj) {
+    return this->emplaceUnique(key, key, obj);
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args) {
+    value_type value(std::forward<Args>(args)...);
+    return this->emplaceUnique(value.first, std::move(value));
+  }
+
+  template <typename... Args>
+  iterator emplace_hint(const_iterator hint, Args &&...args) {
+    value_type value(std::forward<Args>(args)...);
+    if (hint == this->end() && this->isAfterLast(value.first)) {
+      return this->appendUnique(std::move(value));
+    }
+    return this->emplaceUnique(value.first, std::move(value)).first;
+  }
+
+  // Builds the mapped value from args only if key is missing; when it is
+  // present, args are not touched (so nothing is moved from).
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const key_type &key, Args &&...args) {
+    return this->emplaceUnique(
+        key, std::piecewise_construct, std::forward_as_tuple(key),
+        std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(key_type &&key, Args &&...args) {
+    return this->emplaceUnique(
+        key, std::piecewise_construct, std::forward_as_tuple(std::move(key)),
+        std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(const key_type &key, M &&obj) {
+    std::pair<iterator, bool> result = try_emplace(key, std::forward<M>(obj));
+    if (!result.second) {
+      result.first->second = std::forward<M>(obj);
+    }
+    return result;
+  }
+
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(key_type &&key, M &&obj) {
+    std::pair<iterator, bool> result =
+        try_emplace(std::move(key), std::forward<M>(obj));
+    if (!result.second) {
+      result.first->second = std::forward<M>(obj);
+    }
+    return result;
+  }
+
+  void swap(btree_map &other) noexcept { Base::swap(other); }
+
+  // Moves in the elements of other whose keys are missing here; the rest
+  // stay in other.
+  void merge(btree_map &other) {
+    if (this == &other) {
+      return;
+    }
+    btree_map rest(other.key_comp());
+    for (auto &item : other) {
+      if (this->contains(item.first)) {
+        rest.appendUnique(value_type(std::move(item)));
+      } else {
+        try_emplace(item.first, std::move(item.second));
+      }
+    }
+    other.swap(rest);
+  }
+
+  // Since each insertion invalidates the iterators returned before it,
+  // they are looked up again once everything is in.
+  template <typename... Args>
+  std::vector<std::pair<iterator, bool>> insert_many(Args &&...args) {
+    std::vector<std::pair<iterator, bool>> return_vector;
+    std::vector<key_type> keys;
+    for (auto &item : {args...}) {
+      return_vector.push_back(insert(item));
+      keys.push_back(item.first);
+    }
+    for (size_t i = 0; i < keys.size(); ++i) {
+      return_vector[i].first = this->find(keys[i]);
+    }
+    return return_vector;
+  }
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_BTREE_BTREE_MAP_H_
@@ -0,0 +1,143 @@
+#ifndef CPP2_S21_CONTAINERS_1_BTREE_BTREE_SET_H_
+#define CPP2_S21_CONTAINERS_1_BTREE_BTREE_SET_H_
+
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "btree.h"
+
+namespace s21 {
+
+template <typename Key>
+struct BTreeSetKey {
+  static const Key &of(const Key &item) noexcept { return item; }
+};
+
+// s21::set over a B+-tree: the same interface, but keys sit in contiguous
+// leaves, which makes lookups and scans far friendlier to the cache.
+// Unlike s21::set, every insertion or erasure invalidates all iterators.
+template <class Key, class Compare = std::less<Key>,
+          class Allocator = std::allocator<Key>>
+class btree_set
+    : public BTree<Key, Key, BTreeSetKey<Key>, Compare, Allocator> {
+  using Base = BTree<Key, Key, BTreeSetKey<Key>, Compare, Allocator>;
+
+ public:
+  using key_type = Key;
+  using value_type = Key;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using iterator = typename Base::iterator;
+  using const_iterator = typename Base::const_iterator;
+  using size_type = size_t;
+  using allocator_type = Allocator;
+
+  btree_set(const Allocator &alloc = Allocator()) : Base(Compare(), alloc) {}
+
+  explicit btree_set(const Compare &compare,
+                     const Allocator &alloc = Allocator())
+      : Base(compare, alloc) {}
+
+  btree_set(std::initializer_list<value_type> const &items,
+            const Allocator &alloc = Allocator())
+      : Base(Compare(), alloc) {
+    for (auto &item : items) {
+      insert(item);
+    }
+  }
+
+  // Builds the tree by appending a range sorted in strictly ascending
+  // order, which fills every leaf but the last.
+  template <typename ForwardIt>
+  static btree_set from_sorted(ForwardIt first, ForwardIt last,
+                               const Allocator &alloc = Allocator()) {
+    btree_set result(alloc);
+    for (; first != last; ++first) {
+      if (!result.isAfterLast(*first)) {
+        throw std::invalid_argument(
+            "from_sorted needs strictly ascending keys");
+      }
+      result.appendUnique(value_type(*first));
+    }
+    return result;
+  }
+
+  template <typename Range>
+  static btree_set from_sorted(const Range &range) {
+    return from_sorted(std::begin(range), std::end(range));
+  }
+
+  std::pair<iterator, bool> insert(const value_type &value) {
+    return this->emplaceUnique(value, value);
+  }
+
+  std::pair<iterator, bool> insert(value_type &&value) {
+    return this->emplaceUnique(value, std::move(value));
+  }
+
+  // Appending through an end() hint skips the key search.
+  iterator insert(const_iterator hint, const value_type &value) {
+    if (hint == this->end() && this->isAfterLast(value)) {
+      return this->appendUnique(value_type(value));
+    }
+    return insert(value).first;
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args) {
+    value_type value(std::forward<Args>(args)...);
+    return this->emplaceUnique(value, std::move(value));
+  }
+
+  template <typename... Args>
+  iterator emplace_hint(const_iterator hint, Args &&...args) {
+    value_type value(std::forward<Args>(args)...);
+    if (hint == this->end() && this->isAfterLast(value)) {
+      return this->appendUnique(std::move(value));
+    }
+    return this->emplaceUnique(value, std::move(value)).first;
+  }
+
+  void swap(btree_set &other) noexcept { Base::swap(other); }
+
+  // Takes the keys of other that are missing here; the rest stay in
+  // other.
+  void merge(btree_set &other) {
+    if (this == &other) {
+      return;
+    }
+    btree_set rest(other.key_comp());
+    for (const value_type &item : other) {
+      if (this->contains(item)) {
+        rest.appendUnique(value_type(item));
+      } else {
+        insert(item);
+      }
+    }
+    other.swap(rest);
+  }
+
+  // Since each insertion invalidates the iterators returned before it,
+  // they are looked up again once everything is in.
+  template <typename... Args>
+  std::vector<std::pair<iterator, bool>> insert_many(Args &&...args) {
+    std::vector<std::pair<iterator, bool>> return_vector;
+    std::vector<value_type> keys;
+    for (auto &item : {args...}) {
+      return_vector.push_back(insert(item));
+      keys.push_back(item);
+    }
+    for (size_t i = 0; i < keys.size(); ++i) {
+      return_vector[i].first = this->find(keys[i]);
+    }
+    return return_vector;
+  }
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_BTREE_BTREE_SET_H_
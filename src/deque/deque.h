@@ -0,0 +1,364 @@
+#ifndef CPP2_S21_CONTAINERS_1_DEQUE_DEQUE_H_
+#define CPP2_S21_CONTAINERS_1_DEQUE_DEQUE_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include "../iterators/deque_iterator.h"
+#include "../../utils/allocator.h"
+
+namespace s21 {
+
+// Elements are stored in fixed-size blocks referenced from a block map.
+// Growing at either end only allocates a new block (and occasionally a
+// bigger map of pointers), so existing elements never move and references
+// to them stay valid across push_front/push_back.
+template <typename T, typename Allocator = Allocator<T>>
+class deque {
+  static constexpr size_t blockSize() {
+    size_t count = sizeof(T) < 512 ? 512 / sizeof(T) : 1;
+    size_t power = 1;
+    while (power * 2 <= count) {
+      power *= 2;
+    }
+    return power;
+  }
+
+ public:
+  static constexpr size_t kBlockSize = blockSize();
+
+  using value_type = T;
+  using reference = T &;
+  using const_reference = const T &;
+  using iterator = DequeIterator<T, iterator_traits<T *>, kBlockSize>;
+  using const_iterator =
+      DequeIterator<T, iterator_traits<const T *>, kBlockSize>;
+  using size_type = size_t;
+  using allocator_type = Allocator;
+  using map_allocator =
+      typename std::allocator_traits<allocator_type>::template rebind_alloc<
+          T *>;
+
+  deque(const Allocator &alloc = Allocator())
+      : allocator_(
+            std::allocator_traits<
+                allocator_type>::select_on_container_copy_construction(alloc)),
+        allocator_map_(),
+        map_(nullptr),
+        map_size_(0),
+        start_(0),
+        size_(0) {
+    reallocateMap(0, false);
+  }
+
+  deque(std::initializer_list<value_type> const &items,
+        const Allocator &alloc = Allocator())
+      : deque(alloc) {
+    for (auto &item : items) {
+      push_back(item);
+    }
+  }
+
+  deque(const deque &rhs)
+      : deque(std::allocator_traits<allocator_type>::
+                  select_on_container_copy_construction(rhs.allocator_)) {
+    for (const auto &item : rhs) {
+      push_back(item);
+    }
+  }
+
+  deque(deque &&rhs) noexcept
+      : allocator_(std::move(rhs.allocator_)),
+        allocator_map_(std::move(rhs.allocator_map_)),
+        map_(std::exchange(rhs.map_, nullptr)),
+        map_size_(std::exchange(rhs.map_size_, 0)),
+        start_(std::exchange(rhs.start_, 0)),
+        size_(std::exchange(rhs.size_, 0)) {}
+
+  deque &operator=(const deque &rhs) {
+    if (this == &rhs) {
+      return *this;
+    }
+    deque copy = rhs;
+    swap(copy);
+    return *this;
+  }
+
+  deque &operator=(deque &&rhs) noexcept {
+    if (this == &rhs) {
+      return *this;
+    }
+    swap(rhs);
+    rhs.clear();
+    return *this;
+  }
+
+  ~deque() {
+    clear();
+    if (map_) {
+      std::allocator_traits<map_allocator>::deallocate(allocator_map_, map_,
+                                                       map_size_);
+    }
+  }
+
+  reference at(size_type pos) {
+    if (pos >= size_) {
+      throw std::out_of_range("Index out of range");
+    }
+    return (*this)[pos];
+  }
+
+  const_reference at(size_type pos) const {
+    if (pos >= size_) {
+      throw std::out_of_range("Index out of range");
+    }
+    return (*this)[pos];
+  }
+
+  reference operator[](size_type pos) { return slot(start_ + pos); }
+
+  const_reference operator[](size_type pos) const {
+    return slot(start_ + pos);
+  }
+
+  reference front() {
+    if (!size_) {
+      throw std::out_of_range("deque is empty");
+    }
+    return slot(start_);
+  }
+
+  const_reference front() const {
+    if (!size_) {
+      throw std::out_of_range("deque is empty");
+    }
+    return slot(start_);
+  }
+
+  reference back() {
+    if (!size_) {
+      throw std::out_of_range("deque is empty");
+    }
+    return slot(start_ + size_ - 1);
+  }
+
+  const_reference back() const {
+    if (!size_) {
+      throw std::out_of_range("deque is empty");
+    }
+    return slot(start_ + size_ - 1);
+  }
+
+  iterator begin() noexcept { return iterator(map_, start_); }
+
+  const_iterator begin() const noexcept { return const_iterator(map_, start_); }
+
+  iterator end() noexcept { return iterator(map_, start_ + size_); }
+
+  const_iterator end() const noexcept {
+    return const_iterator(map_, start_ + size_);
+  }
+
+  const_iterator cbegin() const noexcept { return begin(); }
+
+  const_iterator cend() const noexcept { return end(); }
+
+  bool empty() const noexcept { return size_ == 0; }
+
+  size_type size() const noexcept { return size_; }
+
+  size_type max_size() const noexcept {
+    return std::numeric_limits<size_type>::max() / sizeof(value_type);
+  }
+
+  void clear() noexcept {
+    for (size_type i = 0; i < size_; ++i) {
+      std::allocator_traits<allocator_type>::destroy(allocator_,
+                                                     &slot(start_ + i));
+    }
+    for (size_type i = 0; i < map_size_; ++i) {
+      deallocateBlock(i);
+    }
+    size_ = 0;
+    start_ = centre();
+  }
+
+  void push_back(const_reference value) { emplace_back(value); }
+
+  void push_back(value_type &&value) { emplace_back(std::move(value)); }
+
+  void push_front(const_reference value) { emplace_front(value); }
+
+  void push_front(value_type &&value) { emplace_front(std::move(value)); }
+
+  template <typename... Args>
+  reference emplace_back(Args &&...args) {
+    if ((start_ + size_) / kBlockSize >= map_size_) {
+      reallocateMap(1, false);
+    }
+    size_type pos = start_ + size_;
+    T *place = allocateBlock(pos / kBlockSize) + pos % kBlockSize;
+    std::allocator_traits<allocator_type>::construct(
+        allocator_, place, std::forward<Args>(args)...);
+    ++size_;
+    return *place;
+  }
+
+  template <typename... Args>
+  reference emplace_front(Args &&...args) {
+    if (start_ == 0) {
+      reallocateMap(1, true);
+    }
+    size_type pos = start_ - 1;
+    T *place = allocateBlock(pos / kBlockSize) + pos % kBlockSize;
+    std::allocator_traits<allocator_type>::construct(
+        allocator_, place, std::forward<Args>(args)...);
+    start_ = pos;
+    ++size_;
+    return *place;
+  }
+
+  void pop_back() {
+    if (size_ == 0) {
+      return;
+    }
+    size_type pos = start_ + size_ - 1;
+    std::allocator_traits<allocator_type>::destroy(allocator_, &slot(pos));
+    --size_;
+    if (size_ == 0 || pos % kBlockSize == 0) {
+      deallocateBlock(pos / kBlockSize);
+    }
+    if (size_ == 0) {
+      start_ = centre();
+    }
+  }
+
+  void pop_front() {
+    if (size_ == 0) {
+      return;
+    }
+    size_type pos = start_;
+    std::allocator_traits<allocator_type>::destroy(allocator_, &slot(pos));
+    ++start_;
+    --size_;
+    if (size_ == 0 || start_ % kBlockSize == 0) {
+      deallocateBlock(pos / kBlockSize);
+    }
+    if (size_ == 0) {
+      start_ = centre();
+    }
+  }
+
+  void swap(deque &rhs) noexcept {
+    std::swap(allocator_, rhs.allocator_);
+    std::swap(allocator_map_, rhs.allocator_map_);
+    std::swap(map_, rhs.map_);
+    std::swap(map_size_, rhs.map_size_);
+    std::swap(start_, rhs.start_);
+    std::swap(size_, rhs.size_);
+  }
+
+  template <typename... Args>
+  void insert_many_back(Args &&...args) {
+    (emplace_back(std::forward<Args>(args)), ...);
+  }
+
+  template <typename... Args>
+  void insert_many_front(Args &&...args) {
+    value_type items[] = {value_type(std::forward<Args>(args))...};
+    for (size_type i = sizeof...(Args); i > 0; --i) {
+      emplace_front(std::move(items[i - 1]));
+    }
+  }
+
+ private:
+  static constexpr size_type kInitialMapSize = 8;
+
+  T &slot(size_type pos) const {
+    return map_[pos / kBlockSize][pos % kBlockSize];
+  }
+
+  size_type centre() const noexcept { return map_size_ / 2 * kBlockSize; }
+
+  T *allocateBlock(size_type index) {
+    if (map_[index] == nullptr) {
+      map_[index] = std::allocator_traits<allocator_type>::allocate(
+          allocator_, kBlockSize);
+    }
+    return map_[index];
+  }
+
+  void deallocateBlock(size_type index) noexcept {
+    if (map_[index] != nullptr) {
+      std::allocator_traits<allocator_type>::deallocate(
+          allocator_, map_[index], kBlockSize);
+      map_[index] = nullptr;
+    }
+  }
+
+  // Makes room for extra_blocks more blocks at the requested end. Only the
+  // block pointers move: when the map is at most half used they are
+  // re-centred in place, otherwise they go to a map twice the size.
+  void reallocateMap(size_type extra_blocks, bool at_front) {
+    size_type first_block = start_ / kBlockSize;
+    size_type used_blocks =
+        size_ ? (start_ + size_ - 1) / kBlockSize - first_block + 1 : 0;
+    size_type needed = used_blocks + extra_blocks;
+    for (size_type i = 0; i < map_size_; ++i) {
+      if (i < first_block || i >= first_block + used_blocks) {
+        deallocateBlock(i);
+      }
+    }
+
+    size_type new_first = 0;
+    if (map_ != nullptr && map_size_ >= 2 * needed) {
+      new_first = (map_size_ - needed) / 2 + (at_front ? extra_blocks : 0);
+      if (new_first < first_block) {
+        std::copy(map_ + first_block, map_ + first_block + used_blocks,
+                  map_ + new_first);
+      } else {
+        std::copy_backward(map_ + first_block,
+                           map_ + first_block + used_blocks,
+                           map_ + new_first + used_blocks);
+      }
+      for (size_type i = 0; i < map_size_; ++i) {
+        if (i < new_first || i >= new_first + used_blocks) {
+          map_[i] = nullptr;
+        }
+      }
+    } else {
+      size_type new_map_size = std::max(
+          {map_size_ * 2, needed * 2, static_cast<size_type>(kInitialMapSize)});
+      T **new_map = std::allocator_traits<map_allocator>::allocate(
+          allocator_map_, new_map_size);
+      std::fill(new_map, new_map + new_map_size, nullptr);
+      new_first = (new_map_size - needed) / 2 + (at_front ? extra_blocks : 0);
+      if (map_ != nullptr) {
+        std::copy(map_ + first_block, map_ + first_block + used_blocks,
+                  new_map + new_first);
+        std::allocator_traits<map_allocator>::deallocate(allocator_map_, map_,
+                                                         map_size_);
+      }
+      map_ = new_map;
+      map_size_ = new_map_size;
+    }
+    start_ = new_first * kBlockSize + start_ % kBlockSize;
+  }
+
+ private:
+  allocator_type allocator_;
+  map_allocator allocator_map_;
+  T **map_;
+  size_type map_size_;
+  size_type start_;
+  size_type size_;
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_DEQUE_DEQUE_H_
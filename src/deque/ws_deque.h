@@ -0,0 +1,168 @@
+#ifndef CPP2_S21_CONTAINERS_1_DEQUE_WS_DEQUE_H_
+#define CPP2_S21_CONTAINERS_1_DEQUE_WS_DEQUE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "../../utils/cache_line.h"
+#include "../vector/vector.h"
+
+namespace s21 {
+
+// Chase-Lev work-stealing deque (with the C11 orderings of Le et al.,
+// "Correct and Efficient Work-Stealing for Weak Memory Models").
+//
+// One owner thread calls push() and pop() at the bottom; any number of
+// thieves call steal() at the top. The owner only synchronizes with thieves
+// when the deque is down to its last element. Items are read by thieves
+// before their CAS decides who gets them, so T must be trivially copyable
+// (typically a pointer to a task).
+//
+// The circular array doubles when full. A thief may still be reading the
+// old array, so retired arrays are kept until the deque is destroyed; their
+// total size never exceeds that of the live array.
+template <typename T>
+class ws_deque {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "ws_deque items are copied racily and must be trivially "
+                "copyable");
+
+  struct Array {
+    explicit Array(int64_t capacity)
+        : capacity_(capacity),
+          mask_(capacity - 1),
+          slots_(new std::atomic<T>[static_cast<size_t>(capacity)]) {}
+
+    ~Array() { delete[] slots_; }
+
+    T get(int64_t index) const noexcept {
+      return slots_[index & mask_].load(std::memory_order_relaxed);
+    }
+
+    void put(int64_t index, T value) noexcept {
+      slots_[index & mask_].store(value, std::memory_order_relaxed);
+    }
+
+    int64_t capacity_;
+    int64_t mask_;
+    std::atomic<T> *slots_;
+  };
+
+ public:
+  using value_type = T;
+  using size_type = size_t;
+
+  explicit ws_deque(size_type capacity = kDefaultCapacity)
+      : top_(0), bottom_(0), array_(new Array(roundUpToPowerOfTwo(capacity))) {}
+
+  ws_deque(const ws_deque &) = delete;
+  ws_deque &operator=(const ws_deque &) = delete;
+
+  ~ws_deque() {
+    delete array_.load(std::memory_order_relaxed);
+    for (Array *array : garbage_) {
+      delete array;
+    }
+  }
+
+  // Owner only.
+  void push(T value) {
+    int64_t bottom = bottom_.load(std::memory_order_relaxed);
+    int64_t top = top_.load(std::memory_order_acquire);
+    Array *array = array_.load(std::memory_order_relaxed);
+    if (bottom - top > array->capacity_ - 1) {
+      array = grow(array, top, bottom);
+    }
+    array->put(bottom, value);
+    bottom_.store(bottom + 1, std::memory_order_release);
+  }
+
+  // Owner only. Takes the most recently pushed item.
+  bool pop(T &value) {
+    int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+    Array *array = array_.load(std::memory_order_relaxed);
+    bottom_.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t top = top_.load(std::memory_order_relaxed);
+    if (top > bottom) {
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+      return false;
+    }
+    value = array->get(bottom);
+    if (top == bottom) {
+      // Last item: race the thieves for it.
+      bool won = top_.compare_exchange_strong(top, top + 1,
+                                              std::memory_order_seq_cst,
+                                              std::memory_order_relaxed);
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+      return won;
+    }
+    return true;
+  }
+
+  // Any thread. Takes the oldest item; returns false when the deque is
+  // empty or another thread won the race for the item.
+  bool steal(T &value) {
+    int64_t top = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t bottom = bottom_.load(std::memory_order_acquire);
+    if (top >= bottom) {
+      return false;
+    }
+    Array *array = array_.load(std::memory_order_acquire);
+    T item = array->get(top);
+    if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                      std::memory_order_relaxed)) {
+      return false;
+    }
+    value = item;
+    return true;
+  }
+
+  // Snapshots; exact only when no other thread is using the deque.
+  size_type size() const noexcept {
+    int64_t bottom = bottom_.load(std::memory_order_relaxed);
+    int64_t top = top_.load(std::memory_order_relaxed);
+    return bottom > top ? static_cast<size_type>(bottom - top) : 0;
+  }
+
+  bool empty() const noexcept { return size() == 0; }
+
+  size_type capacity() const noexcept {
+    return static_cast<size_type>(
+        array_.load(std::memory_order_relaxed)->capacity_);
+  }
+
+ private:
+  static constexpr size_type kDefaultCapacity = 256;
+
+  static int64_t roundUpToPowerOfTwo(size_type value) {
+    int64_t power = 2;
+    while (static_cast<size_type>(power) < value) {
+      power *= 2;
+    }
+    return power;
+  }
+
+  Array *grow(Array *array, int64_t top, int64_t bottom) {
+    Array *bigger = new Array(array->capacity_ * 2);
+    for (int64_t index = top; index < bottom; ++index) {
+      bigger->put(index, array->get(index));
+    }
+    garbage_.push_back(array);
+    array_.store(bigger, std::memory_order_release);
+    return bigger;
+  }
+
+ private:
+  alignas(kCacheLineSize) std::atomic<int64_t> top_;
+  alignas(kCacheLineSize) std::atomic<int64_t> bottom_;
+  std::atomic<Array *> array_;
+  s21::vector<Array *> garbage_;
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_DEQUE_WS_DEQUE_H_
@@ -0,0 +1,596 @@
+#ifndef CPP2_S21_CONTAINERS_1_FLAT_FLAT_MAP_H_
+#define CPP2_S21_CONTAINERS_1_FLAT_FLAT_MAP_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "../../utils/is_transparent.h"
+#include "../vector/vector.h"
+
+namespace s21 {
+
+// A map kept as two sorted s21::vectors, one of keys and one of mapped
+// values, for tables that are built once and then mostly read. Lookups
+// binary-search the packed keys, so they touch a few cache lines instead
+// of one scattered node per level, and scans run over plain arrays.
+//
+// Inserting or erasing a single element shifts everything after it, so
+// tables should be filled through the bulk insert or the adopting
+// constructors. Like std::flat_map, iterators yield a pair of references
+// rather than a stored pair, and any insertion or erasure invalidates
+// them.
+template <class Key, class T, class Compare = std::less<Key>>
+class flat_map {
+  template <bool kConst>
+  class Iterator;
+
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<key_type, mapped_type>;
+  using reference = std::pair<const key_type &, mapped_type &>;
+  using const_reference = std::pair<const key_type &, const mapped_type &>;
+  using iterator = Iterator<false>;
+  using const_iterator = Iterator<true>;
+  using size_type = size_t;
+  using key_compare = Compare;
+  using key_container_type = s21::vector<key_type>;
+  using mapped_container_type = s21::vector<mapped_type>;
+
+  flat_map() : flat_map(Compare()) {}
+
+  explicit flat_map(const Compare &compare) : compare_(compare) {}
+
+  flat_map(std::initializer_list<value_type> const &items,
+           const Compare &compare = Compare())
+      : compare_(compare) {
+    insert(items.begin(), items.end());
+  }
+
+  // Takes over the two containers and sorts them by key in one go; of
+  // equal keys the first one is kept.
+  flat_map(key_container_type keys, mapped_container_type values,
+           const Compare &compare = Compare())
+      : compare_(compare), keys_(std::move(keys)), values_(std::move(values)) {
+    if (keys_.size() != values_.size()) {
+      throw std::invalid_argument("keys and values differ in size");
+    }
+    mergeTail(0);
+  }
+
+  // Adopts containers already sorted in strictly ascending key order
+  // without copying or sorting them; the order is only checked.
+  static flat_map from_sorted(key_container_type keys,
+                              mapped_container_type values,
+                              const Compare &compare = Compare()) {
+    if (keys.size() != values.size()) {
+      throw std::invalid_argument("keys and values differ in size");
+    }
+    flat_map result(compare);
+    result.keys_ = std::move(keys);
+    result.values_ = std::move(values);
+    for (size_type i = 1; i < result.keys_.size(); ++i) {
+      if (!compare(result.keys_[i - 1], result.keys_[i])) {
+        throw std::invalid_argument(
+            "from_sorted needs strictly ascending keys");
+      }
+    }
+    return result;
+  }
+
+  template <typename ForwardIt>
+  static flat_map from_sorted(ForwardIt first, ForwardIt last,
+                              const Compare &compare = Compare()) {
+    flat_map result(compare);
+    size_type count = static_cast<size_type>(std::distance(first, last));
+    result.keys_.reserve(count);
+    result.values_.reserve(count);
+    for (; first != last; ++first) {
+      if (!result.keys_.empty() &&
+          !compare(result.keys_[result.keys_.size() - 1], first->first)) {
+        throw std::invalid_argument(
+            "from_sorted needs strictly ascending keys");
+      }
+      result.keys_.push_back(first->first);
+      result.values_.push_back(first->second);
+    }
+    return result;
+  }
+
+  template <typename Range>
+  static flat_map from_sorted(const Range &range) {
+    return from_sorted(std::begin(range), std::end(range));
+  }
+
+  mapped_type &at(const key_type &key) {
+    size_type index = findIndex(key);
+    if (index == size()) {
+      throw std::out_of_range("Key not in map");
+    }
+    return values_[index];
+  }
+
+  const mapped_type &at(const key_type &key) const {
+    size_type index = findIndex(key);
+    if (index == size()) {
+      throw std::out_of_range("Key not in map");
+    }
+    return values_[index];
+  }
+
+  // Inserts a value-initialised element when key is missing.
+  mapped_type &operator[](const key_type &key) {
+    return values_[tryEmplace(key).first];
+  }
+
+  mapped_type &operator[](key_type &&key) {
+    return values_[tryEmplace(std::move(key)).first];
+  }
+
+  std::pair<iterator, bool> insert(const value_type &value) {
+    return toIterator(tryEmplace(value.first, value.second));
+  }
+
+  std::pair<iterator, bool> insert(value_type &&value) {
+    return toIterator(
+        tryEmplace(std::move(value.first), std::move(value.second)));
+  }
+
+  std::pair<iterator, bool> insert(const key_type &key,
+                                   const mapped_type &obj) {
+    return toIterator(tryEmplace(key, obj));
+  }
+
+  // Appends the whole range, sorts just the new part and merges it with
+  // the old contents in a single pass, which costs O(n + m log m) for m
+  // new elements instead of O(n) shifting per element. Keys already here
+  // and repeated keys in the range keep their first value.
+  template <typename InputIt>
+  void insert(InputIt first, InputIt last) {
+    size_type old_size = size();
+    try {
+      for (; first != last; ++first) {
+        keys_.push_back(first->first);
+        try {
+          values_.push_back(first->second);
+        } catch (...) {
+          keys_.pop_back();
+          throw;
+        }
+      }
+    } catch (...) {
+      truncate(old_size);
+      throw;
+    }
+    mergeTail(old_size);
+  }
+
+  void insert(std::initializer_list<value_type> items) {
+    insert(items.begin(), items.end());
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args) {
+    value_type value(std::forward<Args>(args)...);
+    return insert(std::move(value));
+  }
+
+  // Builds the mapped value from args only if key is missing; when it is
+  // present, args are not touched (so nothing is moved from).
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const key_type &key, Args &&...args) {
+    return toIterator(tryEmplace(key, std::forward<Args>(args)...));
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(key_type &&key, Args &&...args) {
+    return toIterator(tryEmplace(std::move(key), std::forward<Args>(args)...));
+  }
+
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(const key_type &key, M &&obj) {
+    std::pair<size_type, bool> result = tryEmplace(key, std::forward<M>(obj));
+    if (!result.second) {
+      values_[result.first] = std::forward<M>(obj);
+    }
+    return toIterator(result);
+  }
+
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(key_type &&key, M &&obj) {
+    std::pair<size_type, bool> result =
+        tryEmplace(std::move(key), std::forward<M>(obj));
+    if (!result.second) {
+      values_[result.first] = std::forward<M>(obj);
+    }
+    return toIterator(result);
+  }
+
+  iterator find(const key_type &key) { return iteratorAt(findIndex(key)); }
+  const_iterator find(const key_type &key) const {
+    return iteratorAt(findIndex(key));
+  }
+
+  template <typename K, typename C = Compare,
+            std::enable_if_t<is_transparent_v<C>, int> = 0>
+  iterator find(const K &key) {
+    return iteratorAt(findIndex(key));
+  }
+
+  template <typename K, typename C = Compare,
+            std::enable_if_t<is_transparent_v<C>, int> = 0>
+  const_iterator find(const K &key) const {
+    return iteratorAt(findIndex(key));
+  }
+
+  bool contains(const key_type &key) const { return findIndex(key) != size(); }
+
+  template <typename K, typename C = Compare,
+            std::enable_if_t<is_transparent_v<C>, int> = 0>
+  bool contains(const K &key) const {
+    return findIndex(key) != size();
+  }
+
+  size_type count(const key_type &key) const { return contains(key) ? 1 : 0; }
+
+  template <typename K, typename C = Compare,
+            std::enable_if_t<is_transparent_v<C>, int> = 0>
+  size_type count(const K &key) const {
+    return contains(key) ? 1 : 0;
+  }
+
+  iterator lower_bound(const key_type &key) {
+    return iteratorAt(lowerIndex(key));
+  }
+  const_iterator lower_bound(const key_type &key) const {
+    return iteratorAt(lowerIndex(key));
+  }
+
+  template <typename K, typename C = Compare,
+            std::enable_if_t<is_transparent_v<C>, int> = 0>
+  const_iterator lower_bound(const K &key) const {
+    return iteratorAt(lowerIndex(key));
+  }
+
+  iterator upper_bound(const key_type &key) {
+    return iteratorAt(upperIndex(key));
+  }
+  const_iterator upper_bound(const key_type &key) const {
+    return iteratorAt(upperIndex(key));
+  }
+
+  template <typename K, typename C = Compare,
+            std::enable_if_t<is_transparent_v<C>, int> = 0>
+  const_iterator upper_bound(const K &key) const {
+    return iteratorAt(upperIndex(key));
+  }
+
+  std::pair<iterator, iterator> equal_range(const key_type &key) {
+    size_type index = lowerIndex(key);
+    size_type next = index;
+    if (next != size() && !compare_(key, keys_[next])) {
+      ++next;
+    }
+    return std::make_pair(iteratorAt(index), iteratorAt(next));
+  }
+
+  std::pair<const_iterator, const_iterator> equal_range(
+      const key_type &key) const {
+    size_type index = lowerIndex(key);
+    size_type next = index;
+    if (next != size() && !compare_(key, keys_[next])) {
+      ++next;
+    }
+    return std::make_pair(iteratorAt(index), iteratorAt(next));
+  }
+
+  iterator erase(const_iterator pos) {
+    size_type index = pos.key_ - keys_.data();
+    keys_.erase(keys_.begin() + index);
+    values_.erase(values_.begin() + index);
+    return iteratorAt(index);
+  }
+
+  size_type erase(const key_type &key) {
+    size_type index = findIndex(key);
+    if (index == size()) {
+      return 0;
+    }
+    erase(iteratorAt(index));
+    return 1;
+  }
+
+  iterator begin() noexcept { return iteratorAt(0); }
+  const_iterator begin() const noexcept { return iteratorAt(0); }
+  iterator end() noexcept { return iteratorAt(size()); }
+  const_iterator end() const noexcept { return iteratorAt(size()); }
+
+  bool empty() const noexcept { return keys_.empty(); }
+  size_type size() const noexcept { return keys_.size(); }
+  size_type max_size() const noexcept {
+    return std::min(keys_.max_size(), values_.max_size());
+  }
+
+  void reserve(size_type count) {
+    keys_.reserve(count);
+    values_.reserve(count);
+  }
+
+  void clear() noexcept {
+    keys_.clear();
+    values_.clear();
+  }
+
+  void swap(flat_map &other) noexcept {
+    std::swap(compare_, other.compare_);
+    keys_.swap(other.keys_);
+    values_.swap(other.values_);
+  }
+
+  // The sorted keys and the values in the same order.
+  const key_container_type &keys() const noexcept { return keys_; }
+  const mapped_container_type &values() const noexcept { return values_; }
+
+  Compare key_comp() const { return compare_; }
+
+ private:
+  template <typename K>
+  size_type lowerIndex(const K &key) const {
+    const key_type *first = keys_.data();
+    return std::lower_bound(first, first + size(), key, compare_) - first;
+  }
+
+  template <typename K>
+  size_type upperIndex(const K &key) const {
+    const key_type *first = keys_.data();
+    return std::upper_bound(first, first + size(), key, compare_) - first;
+  }
+
+  // size() when key is missing.
+  template <typename K>
+  size_type findIndex(const K &key) const {
+    size_type index = lowerIndex(key);
+    if (index != size() && !compare_(key, keys_[index])) {
+      return index;
+    }
+    return size();
+  }
+
+  iterator iteratorAt(size_type index) noexcept {
+    return iterator(keys_.data() + index, values_.data() + index);
+  }
+
+  const_iterator iteratorAt(size_type index) const noexcept {
+    return const_iterator(keys_.data() + index, values_.data() + index);
+  }
+
+  std::pair<iterator, bool> toIterator(std::pair<size_type, bool> result) {
+    return std::make_pair(iteratorAt(result.first), result.second);
+  }
+
+  // The index of key and whether it was inserted, with the mapped value
+  // built from args.
+  template <typename K, typename... Args>
+  std::pair<size_type, bool> tryEmplace(K &&key, Args &&...args) {
+    size_type index = lowerIndex(key);
+    if (index != size() && !compare_(key, keys_[index])) {
+      return std::make_pair(index, false);
+    }
+    mapped_type value = makeMapped(std::forward<Args>(args)...);
+    keys_.emplace(keys_.begin() + index, std::forward<K>(key));
+    try {
+      values_.emplace(values_.begin() + index, std::move(value));
+    } catch (...) {
+      keys_.erase(keys_.begin() + index);
+      throw;
+    }
+    return std::make_pair(index, true);
+  }
+
+  // Without arguments the value is value-initialised, as in std::map.
+  template <typename... Args>
+  static mapped_type makeMapped(Args &&...args) {
+    if constexpr (sizeof...(Args) == 0) {
+      return mapped_type();
+    } else {
+      return mapped_type(std::forward<Args>(args)...);
+    }
+  }
+
+  void truncate(size_type count) noexcept {
+    while (keys_.size() > count) {
+      keys_.pop_back();
+    }
+    while (values_.size() > count) {
+      values_.pop_back();
+    }
+  }
+
+  // Sorts the elements from old_size on by key and merges them with the
+  // sorted ones before, dropping repeated keys. On failure the map is
+  // restored to its first old_size elements: every comparison is made
+  // before anything is taken out of keys_ and values_, and elements are
+  // only moved when neither half of them can throw while moving.
+  void mergeTail(size_type old_size) {
+    constexpr bool kMove = std::is_nothrow_move_constructible_v<key_type> &&
+                           std::is_nothrow_move_constructible_v<mapped_type>;
+    size_type added = size() - old_size;
+    if (added == 0) {
+      return;
+    }
+    s21::vector<size_type> order;
+    s21::vector<size_type> plan;
+    key_container_type keys;
+    mapped_container_type values;
+    try {
+      order.reserve(added);
+      for (size_type i = 0; i < added; ++i) {
+        order.push_back(old_size + i);
+      }
+      std::stable_sort(order.data(), order.data() + added,
+                       [this](size_type lhs, size_type rhs) {
+                         return compare_(keys_[lhs], keys_[rhs]);
+                       });
+      plan.reserve(size());
+      size_type old_index = 0;
+      size_type new_index = 0;
+      while (old_index < old_size || new_index < added) {
+        size_type source;
+        if (new_index == added ||
+            (old_index < old_size &&
+             !compare_(keys_[order[new_index]], keys_[old_index]))) {
+          source = old_index++;
+        } else {
+          source = order[new_index++];
+        }
+        while (new_index < added &&
+               !compare_(keys_[source], keys_[order[new_index]])) {
+          ++new_index;
+        }
+        plan.push_back(source);
+      }
+      keys.reserve(plan.size());
+      values.reserve(plan.size());
+      for (size_type i = 0; i < plan.size(); ++i) {
+        if constexpr (kMove) {
+          keys.push_back(std::move(keys_[plan[i]]));
+          values.push_back(std::move(values_[plan[i]]));
+        } else {
+          keys.push_back(keys_[plan[i]]);
+          values.push_back(values_[plan[i]]);
+        }
+      }
+    } catch (...) {
+      truncate(old_size);
+      throw;
+    }
+    keys_.swap(keys);
+    values_.swap(values);
+  }
+
+  template <bool kConst>
+  class Iterator {
+    friend class flat_map;
+    template <bool>
+    friend class Iterator;
+
+    using mapped_pointer =
+        std::conditional_t<kConst, const mapped_type *, mapped_type *>;
+
+   public:
+    using value_type = flat_map::value_type;
+    using difference_type = ptrdiff_t;
+    using reference = std::conditional_t<kConst, const_reference,
+                                         flat_map::reference>;
+    using iterator_category = std::random_access_iterator_tag;
+
+    // operator-> has no stored pair to point at, so it hands out one
+    // holding the references.
+    class pointer {
+     public:
+      explicit pointer(reference ref) : ref_(ref) {}
+      const reference *operator->() const noexcept { return &ref_; }
+
+     private:
+      reference ref_;
+    };
+
+    Iterator() : key_(nullptr), value_(nullptr) {}
+
+    template <bool kOther, std::enable_if_t<kConst && !kOther, int> = 0>
+    Iterator(const Iterator<kOther> &other)
+        : key_(other.key_), value_(other.value_) {}
+
+    reference operator*() const { return reference(*key_, *value_); }
+    pointer operator->() const { return pointer(**this); }
+    reference operator[](difference_type n) const { return *(*this + n); }
+
+    Iterator &operator++() {
+      ++key_;
+      ++value_;
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      Iterator temp = *this;
+      ++(*this);
+      return temp;
+    }
+
+    Iterator &operator--() {
+      --key_;
+      --value_;
+      return *this;
+    }
+
+    Iterator operator--(int) {
+      Iterator temp = *this;
+      --(*this);
+      return temp;
+    }
+
+    Iterator &operator+=(difference_type n) {
+      key_ += n;
+      value_ += n;
+      return *this;
+    }
+
+    Iterator &operator-=(difference_type n) { return *this += -n; }
+
+    Iterator operator+(difference_type n) const {
+      Iterator temp = *this;
+      return temp += n;
+    }
+
+    Iterator operator-(difference_type n) const {
+      Iterator temp = *this;
+      return temp -= n;
+    }
+
+    difference_type operator-(const Iterator &rhs) const noexcept {
+      return key_ - rhs.key_;
+    }
+
+    bool operator==(const Iterator &rhs) const noexcept {
+      return key_ == rhs.key_;
+    }
+    bool operator!=(const Iterator &rhs) const noexcept {
+      return key_ != rhs.key_;
+    }
+    bool operator<(const Iterator &rhs) const noexcept {
+      return key_ < rhs.key_;
+    }
+    bool operator>(const Iterator &rhs) const noexcept {
+      return key_ > rhs.key_;
+    }
+    bool operator<=(const Iterator &rhs) const noexcept {
+      return key_ <= rhs.key_;
+    }
+    bool operator>=(const Iterator &rhs) const noexcept {
+      return key_ >= rhs.key_;
+    }
+
+   private:
+    Iterator(const key_type *key, mapped_pointer value)
+        : key_(key), value_(value) {}
+
+    const key_type *key_;
+    mapped_pointer value_;
+  };
+
+ private:
+  Compare compare_;
+  key_container_type keys_;
+  mapped_container_type values_;
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_FLAT_FLAT_MAP_H_
@@ -0,0 +1,302 @@
+#ifndef CPP2_S21_CONTAINERS_1_FLAT_FLAT_SET_H_
+#define CPP2_S21_CONTAINERS_1_FLAT_FLAT_SET_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "../../utils/is_transparent.h"
+#include "../vector/vector.h"
+
+namespace s21 {
+
+// A set kept as one sorted s21::vector of keys; the flat_map counterpart
+// for read-mostly key sets. Any insertion or erasure invalidates
+// iterators.
+template <class Key, class Compare = std::less<Key>>
+class flat_set {
+ public:
+  using key_type = Key;
+  using value_type = Key;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using container_type = s21::vector<key_type>;
+  using iterator = typename container_type::const_iterator;
+  using const_iterator = typename container_type::const_iterator;
+  using size_type = size_t;
+  using key_compare = Compare;
+
+  flat_set() : flat_set(Compare()) {}
+
+  explicit flat_set(const Compare &compare) : compare_(compare) {}
+
+  flat_set(std::initializer_list<value_type> const &items,
+           const Compare &compare = Compare())
+      : compare_(compare) {
+    insert(items.begin(), items.end());
+  }
+
+  // Takes over keys and sorts them in one go, dropping repeats.
+  explicit flat_set(container_type keys, const Compare &compare = Compare())
+      : compare_(compare), keys_(std::move(keys)) {
+    mergeTail(0);
+  }
+
+  // Adopts keys already sorted in strictly ascending order without
+  // copying or sorting them; the order is only checked.
+  static flat_set from_sorted(container_type keys,
+                              const Compare &compare = Compare()) {
+    flat_set result(compare);
+    result.keys_ = std::move(keys);
+    for (size_type i = 1; i < result.keys_.size(); ++i) {
+      if (!compare(result.keys_[i - 1], result.keys_[i])) {
+        throw std::invalid_argument(
+            "from_sorted needs strictly ascending keys");
+      }
+    }
+    return result;
+  }
+
+  template <typename ForwardIt>
+  static flat_set from_sorted(ForwardIt first, ForwardIt last,
+                              const Compare &compare = Compare()) {
+    flat_set result(compare);
+    result.keys_.reserve(static_cast<size_type>(std::distance(first, last)));
+    for (; first != last; ++first) {
+      if (!result.keys_.empty() &&
+          !compare(result.keys_[result.keys_.size() - 1], *first)) {
+        throw std::invalid_argument(
+            "from_sorted needs strictly ascending keys");
+      }
+      result.keys_.push_back(*first);
+    }
+    return result;
+  }
+
+  template <typename Range>
+  static flat_set from_sorted(const Range &range) {
+    return from_sorted(std::begin(range), std::end(range));
+  }
+
+  std::pair<iterator, bool> insert(const value_type &value) {
+    return emplaceKey(value);
+  }
+
+  std::pair<iterator, bool> insert(value_type &&value) {
+    return emplaceKey(std::move(value));
+  }
+
+  // Appends the whole range, sorts just the new part and merges it with
+  // the old keys in a single pass: O(n + m log m) for m new keys.
+  template <typename InputIt>
+  void insert(InputIt first, InputIt last) {
+    size_type old_size = size();
+    try {
+      for (; first != last; ++first) {
+        keys_.push_back(*first);
+      }
+    } catch (...) {
+      truncate(old_size);
+      throw;
+    }
+    mergeTail(old_size);
+  }
+
+  void insert(std::initializer_list<value_type> items) {
+    insert(items.begin(), items.end());
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args) {
+    value_type value(std::forward<Args>(args)...);
+    return emplaceKey(std::move(value));
+  }
+
+  iterator find(const key_type &key) const {
+    return iteratorAt(findIndex(key));
+  }
+
+  template <typename K, typename C = Compare,
+            std::enable_if_t<is_transparent_v<C>, int> = 0>
+  iterator find(const K &key) const {
+    return iteratorAt(findIndex(key));
+  }
+
+  bool contains(const key_type &key) const { return findIndex(key) != size(); }
+
+  template <typename K, typename C = Compare,
+            std::enable_if_t<is_transparent_v<C>, int> = 0>
+  bool contains(const K &key) const {
+    return findIndex(key) != size();
+  }
+
+  size_type count(const key_type &key) const { return contains(key) ? 1 : 0; }
+
+  template <typename K, typename C = Compare,
+            std::enable_if_t<is_transparent_v<C>, int> = 0>
+  size_type count(const K &key) const {
+    return contains(key) ? 1 : 0;
+  }
+
+  iterator lower_bound(const key_type &key) const {
+    return iteratorAt(lowerIndex(key));
+  }
+
+  template <typename K, typename C = Compare,
+            std::enable_if_t<is_transparent_v<C>, int> = 0>
+  iterator lower_bound(const K &key) const {
+    return iteratorAt(lowerIndex(key));
+  }
+
+  iterator upper_bound(const key_type &key) const {
+    return iteratorAt(upperIndex(key));
+  }
+
+  template <typename K, typename C = Compare,
+            std::enable_if_t<is_transparent_v<C>, int> = 0>
+  iterator upper_bound(const K &key) const {
+    return iteratorAt(upperIndex(key));
+  }
+
+  std::pair<iterator, iterator> equal_range(const key_type &key) const {
+    size_type index = lowerIndex(key);
+    size_type next = index;
+    if (next != size() && !compare_(key, keys_[next])) {
+      ++next;
+    }
+    return std::make_pair(iteratorAt(index), iteratorAt(next));
+  }
+
+  iterator erase(iterator pos) {
+    size_type index = &*pos - keys_.data();
+    keys_.erase(keys_.begin() + index);
+    return iteratorAt(index);
+  }
+
+  size_type erase(const key_type &key) {
+    size_type index = findIndex(key);
+    if (index == size()) {
+      return 0;
+    }
+    keys_.erase(keys_.begin() + index);
+    return 1;
+  }
+
+  iterator begin() const noexcept { return iteratorAt(0); }
+  iterator end() const noexcept { return iteratorAt(size()); }
+
+  bool empty() const noexcept { return keys_.empty(); }
+  size_type size() const noexcept { return keys_.size(); }
+  size_type max_size() const noexcept { return keys_.max_size(); }
+
+  void reserve(size_type count) { keys_.reserve(count); }
+
+  void clear() noexcept { keys_.clear(); }
+
+  void swap(flat_set &other) noexcept {
+    std::swap(compare_, other.compare_);
+    keys_.swap(other.keys_);
+  }
+
+  // The keys in ascending order.
+  const container_type &keys() const noexcept { return keys_; }
+
+  Compare key_comp() const { return compare_; }
+
+ private:
+  template <typename K>
+  size_type lowerIndex(const K &key) const {
+    const key_type *first = keys_.data();
+    return std::lower_bound(first, first + size(), key, compare_) - first;
+  }
+
+  template <typename K>
+  size_type upperIndex(const K &key) const {
+    const key_type *first = keys_.data();
+    return std::upper_bound(first, first + size(), key, compare_) - first;
+  }
+
+  // size() when key is missing.
+  template <typename K>
+  size_type findIndex(const K &key) const {
+    size_type index = lowerIndex(key);
+    if (index != size() && !compare_(key, keys_[index])) {
+      return index;
+    }
+    return size();
+  }
+
+  iterator iteratorAt(size_type index) const noexcept {
+    return iterator(keys_.data() + index);
+  }
+
+  template <typename K>
+  std::pair<iterator, bool> emplaceKey(K &&key) {
+    size_type index = lowerIndex(key);
+    if (index != size() && !compare_(key, keys_[index])) {
+      return std::make_pair(iteratorAt(index), false);
+    }
+    keys_.emplace(keys_.begin() + index, std::forward<K>(key));
+    return std::make_pair(iteratorAt(index), true);
+  }
+
+  void truncate(size_type count) noexcept {
+    while (keys_.size() > count) {
+      keys_.pop_back();
+    }
+  }
+
+  // Sorts the keys from old_size on and merges them with the sorted ones
+  // before, dropping repeats. On failure only the first old_size keys
+  // remain: every comparison is made before any key is taken out.
+  void mergeTail(size_type old_size) {
+    size_type added = size() - old_size;
+    if (added == 0) {
+      return;
+    }
+    s21::vector<size_type> plan;
+    container_type keys;
+    try {
+      key_type *tail = keys_.data() + old_size;
+      std::stable_sort(tail, tail + added, compare_);
+      plan.reserve(size());
+      size_type old_index = 0;
+      size_type new_index = old_size;
+      while (old_index < old_size || new_index < size()) {
+        size_type source;
+        if (new_index == size() ||
+            (old_index < old_size &&
+             !compare_(keys_[new_index], keys_[old_index]))) {
+          source = old_index++;
+        } else {
+          source = new_index++;
+        }
+        while (new_index < size() &&
+               !compare_(keys_[source], keys_[new_index])) {
+          ++new_index;
+        }
+        plan.push_back(source);
+      }
+      keys.reserve(plan.size());
+      for (size_type i = 0; i < plan.size(); ++i) {
+        keys.push_back(std::move_if_noexcept(keys_[plan[i]]));
+      }
+    } catch (...) {
+      truncate(old_size);
+      throw;
+    }
+    keys_.swap(keys);
+  }
+
+  Compare compare_;
+  container_type keys_;
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_FLAT_FLAT_SET_H_
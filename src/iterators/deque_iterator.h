@@ -0,0 +1,108 @@
+#ifndef CPP2_S21_CONTAINERS_1_ITERATORS_DEQUE_ITERATOR_H_
+#define CPP2_S21_CONTAINERS_1_ITERATORS_DEQUE_ITERATOR_H_
+
+#include <cstddef>
+
+#include "iterators_traits.h"
+
+namespace s21 {
+
+// Position-based iterator: element pos_ lives in block pos_ / BlockSize of the
+// block map. BlockSize is a power of two so both are a shift and a mask.
+template <typename T, typename IteratorTraits, size_t BlockSize>
+class DequeIterator {
+ public:
+  using value_type = typename IteratorTraits::value_type;
+  using difference_type = typename IteratorTraits::difference_type;
+  using pointer = typename IteratorTraits::pointer;
+  using reference = typename IteratorTraits::reference;
+  using iterator_category = typename IteratorTraits::iterator_category;
+
+  DequeIterator() = delete;
+  DequeIterator(T **map, size_t pos) : map_(map), pos_(pos) {}
+
+  DequeIterator &operator++() {
+    ++pos_;
+    return *this;
+  }
+
+  DequeIterator &operator--() {
+    --pos_;
+    return *this;
+  }
+
+  DequeIterator operator++(int) {
+    DequeIterator copy = *this;
+    ++pos_;
+    return copy;
+  }
+
+  DequeIterator operator--(int) {
+    DequeIterator copy = *this;
+    --pos_;
+    return copy;
+  }
+
+  DequeIterator &operator+=(difference_type step) {
+    pos_ += step;
+    return *this;
+  }
+
+  DequeIterator &operator-=(difference_type step) {
+    pos_ -= step;
+    return *this;
+  }
+
+  DequeIterator operator+(difference_type step) const {
+    return DequeIterator(map_, pos_ + step);
+  }
+
+  DequeIterator operator-(difference_type step) const {
+    return DequeIterator(map_, pos_ - step);
+  }
+
+  difference_type operator-(const DequeIterator &rhs) const noexcept {
+    return static_cast<difference_type>(pos_) -
+           static_cast<difference_type>(rhs.pos_);
+  }
+
+  reference operator*() const {
+    return map_[pos_ / BlockSize][pos_ % BlockSize];
+  }
+
+  pointer operator->() const { return &**this; }
+
+  reference operator[](difference_type index) const { return *(*this + index); }
+
+  bool operator==(const DequeIterator &rhs) const noexcept {
+    return pos_ == rhs.pos_;
+  }
+
+  bool operator!=(const DequeIterator &rhs) const noexcept {
+    return pos_ != rhs.pos_;
+  }
+
+  bool operator<(const DequeIterator &rhs) const noexcept {
+    return pos_ < rhs.pos_;
+  }
+
+  bool operator>(const DequeIterator &rhs) const noexcept {
+    return pos_ > rhs.pos_;
+  }
+
+  bool operator<=(const DequeIterator &rhs) const noexcept {
+    return pos_ <= rhs.pos_;
+  }
+
+  bool operator>=(const DequeIterator &rhs) const noexcept {
+    return pos_ >= rhs.pos_;
+  }
+
+ private:
+  T **map_;
+  size_t pos_;
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_ITERATORS_DEQUE_ITERATOR_H_
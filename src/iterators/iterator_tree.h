@@ -1,19 +1,45 @@
 #ifndef CPP2_S21_CONTAINERS_1_ITERATORS_ITERATOR_TREE_H_
 #define CPP2_S21_CONTAINERS_1_ITERATORS_ITERATOR_TREE_H_
 
+#include <cstddef>
+#include <utility>
+
 #include "iterators_traits.h"
 
 namespace s21 {
 
-template <typename Data>
+// Summary of a tree that keeps no aggregate; it fits in the padding after
+// height_, so plain nodes do not grow.
+struct NoSummary {};
+
+// The aggregate a tree kept with Monoid stores in each node.
+template <typename Monoid>
+struct TreeSummary {
+  using type = typename Monoid::value_type;
+};
+
+template <>
+struct TreeSummary<void> {
+  using type = NoSummary;
+};
+
+// count_ is the number of elements in the subtree and summary_ the
+// monoid fold of their values in order; AvlBalance keeps both current.
+template <typename Data, typename Summary = NoSummary>
 struct TreeNode {
-  TreeNode() : left_(nullptr), right_(nullptr), parent_(nullptr), height_(0) {}
+  TreeNode()
+      : left_(nullptr),
+        right_(nullptr),
+        parent_(nullptr),
+        count_(0),
+        height_(0) {}
 
   TreeNode(Data data)
       : data_(data),
         left_(nullptr),
         right_(nullptr),
         parent_(nullptr),
+        count_(0),
         height_(0) {}
 
   TreeNode(Data data, TreeNode* parent)
@@ -21,6 +47,7 @@ struct TreeNode {
         left_(nullptr),
         right_(nullptr),
         parent_(parent),
+        count_(1),
         height_(1) {}
 
   TreeNode(const TreeNode&& rhs)
@@ -28,16 +55,21 @@ struct TreeNode {
         left_(std::exchange(rhs.left_, nullptr)),
         right_(std::exchange(rhs.right_, nullptr)),
         parent_(std::exchange(rhs.parent_, nullptr)),
-        height_(std::exchange(rhs.height_, 0)) {}
+        count_(std::exchange(rhs.count_, 0)),
+        height_(std::exchange(rhs.height_, 0)),
+        summary_(std::move(rhs.summary_)) {}
 
   Data data_;
   TreeNode* left_;
   TreeNode* right_;
   TreeNode* parent_;
+  size_t count_;
   int height_;
+  Summary summary_;
 };
 
-template <typename T, typename IteratorTraits, typename Container>
+template <typename T, typename IteratorTraits, typename Container,
+          typename Node = TreeNode<typename IteratorTraits::value_type>>
 class TreeIterator {
   friend Container;
 
@@ -49,7 +81,7 @@ class TreeIterator {
   using iterator_category = typename IteratorTraits::iterator_category;
 
   TreeIterator() = delete;
-  TreeIterator(TreeNode<value_type>* ptr) : ptr_(ptr) {}
+  TreeIterator(Node* ptr) : ptr_(ptr) {}
 
   TreeIterator& operator++() {
     if (ptr_->right_) {
@@ -70,7 +102,10 @@ class TreeIterator {
   }
 
   TreeIterator& operator--() {
-    if (ptr_->left_) {
+    if (ptr_->parent_ == nullptr) {
+      // end(): the header caches the last node in its right_.
+      ptr_ = ptr_->right_;
+    } else if (ptr_->left_) {
       ptr_ = getMax(ptr_->left_);
     } else {
       while (ptr_->parent_->parent_ && ptr_->parent_->left_ == ptr_) {
@@ -100,20 +135,38 @@ class TreeIterator {
   }
 
  private:
-  TreeNode<value_type>* getMin(TreeNode<value_type>* node) {
-    if (node == nullptr) return nullptr;
-    if (node->left_ == nullptr) return node;
-    return getMin(node->left_);
+  Node* getMin(Node* node) {
+    while (node && node->left_) {
+      node = node->left_;
+    }
+    return node;
   }
 
-  TreeNode<value_type>* getMax(TreeNode<value_type>* node) {
-    if (node == nullptr) return nullptr;
-    if (node->right_ == nullptr) return node;
-    return getMax(node->right_);
+  Node* getMax(Node* node) {
+    while (node && node->right_) {
+      node = node->right_;
+    }
+    return node;
   }
 
  private:
-  TreeNode<value_type>* ptr_;
+  Node* ptr_;
+};
+
+// A half-open run of tree elements, as returned by map::range and
+// set::range, that can be walked with a range-for.
+template <typename Iterator>
+class TreeRange {
+ public:
+  TreeRange(Iterator first, Iterator last) : first_(first), last_(last) {}
+
+  Iterator begin() const { return first_; }
+  Iterator end() const { return last_; }
+  bool empty() const { return first_ == last_; }
+
+ private:
+  Iterator first_;
+  Iterator last_;
 };
 
 }  // namespace s21
@@ -154,34 +154,23 @@ class list {
   }
 
   iterator insert(iterator pos, const_reference value) {
-    ListNode<T> *newNode = create_node(value);
-    if (size_) {
-      setup_connections(newNode, pos.ptr_, pos.ptr_->prev_);
-      setup_next(pos.ptr_->prev_, newNode);
-      setup_prev(pos.ptr_, newNode);
-    } else {
-      setup_connections(phantom_node_, newNode, newNode);
-      setup_connections(newNode, phantom_node_, phantom_node_);
-    }
-    ++size_;
-
+    link_node(pos, create_node(value));
     return pos;
   }
 
-  void erase(iterator pos) {
-    if (size_ == 1) {
-      delete_node(pos.ptr_);
-      setup_connections(phantom_node_, nullptr, nullptr);
-    } else {
-      setup_next(pos.ptr_->prev_, pos.ptr_->next_);
-      setup_prev(pos.ptr_->next_, pos.ptr_->prev_);
-      delete_node(pos.ptr_);
-    }
-    --size_;
-  }
+  void erase(iterator pos) { delete_node(unlink_node(pos)); }
 
   void push_back(const_reference value) { insert(end(), value); }
 
+  void push_back(value_type &&value) { emplace_back(std::move(value)); }
+
+  template <typename... Args>
+  reference emplace_back(Args &&...args) {
+    ListNode<T> *node = create_node(std::forward<Args>(args)...);
+    link_node(end(), node);
+    return node->data_;
+  }
+
   void pop_back() { erase(end().ptr_->prev_); }
 
   void push_front(const_reference value) { insert(begin(), value); }
@@ -312,12 +301,43 @@ class list {
   }
 
  private:
-  ListNode<T> *create_node(const_reference value) {
+  // multiset moves nodes in and out for its node handles.
+  template <typename, typename, typename>
+  friend class multiset;
+
+  // Hangs an existing node before pos and counts it in.
+  void link_node(iterator pos, ListNode<T> *node) {
+    if (size_) {
+      setup_connections(node, pos.ptr_, pos.ptr_->prev_);
+      setup_next(pos.ptr_->prev_, node);
+      setup_prev(pos.ptr_, node);
+    } else {
+      setup_connections(phantom_node_, node, node);
+      setup_connections(node, phantom_node_, phantom_node_);
+    }
+    ++size_;
+  }
+
+  // Takes the node at pos out of the list without freeing it.
+  ListNode<T> *unlink_node(iterator pos) {
+    ListNode<T> *node = pos.ptr_;
+    if (size_ == 1) {
+      setup_connections(phantom_node_, nullptr, nullptr);
+    } else {
+      setup_next(node->prev_, node->next_);
+      setup_prev(node->next_, node->prev_);
+    }
+    --size_;
+    return node;
+  }
+
+  template <typename... Args>
+  ListNode<T> *create_node(Args &&...args) {
     ListNode<T> *newNode =
         std::allocator_traits<node_allocator>::allocate(allocator_node_, 1);
     try {
       std::allocator_traits<allocator_type>::construct(
-          allocator_, &(newNode->data_), value);
+          allocator_, &(newNode->data_), std::forward<Args>(args)...);
     } catch (...) {
       std::allocator_traits<node_allocator>::deallocate(allocator_node_,
                                                         newNode, 1);
@@ -0,0 +1,295 @@
+#ifndef CPP2_S21_CONTAINERS_1_MAP_CONCURRENT_MAP_H_
+#define CPP2_S21_CONTAINERS_1_MAP_CONCURRENT_MAP_H_
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "../../utils/cache_line.h"
+#include "../thread_pool/thread_pool.h"
+#include "map.h"
+
+namespace s21 {
+
+// Thread-safe map split by key hash into shards, each an s21::map behind
+// its own reader-writer lock, so threads working on different shards never
+// wait for each other and readers of one shard share it. Shards sit on
+// separate cache lines so their locks do not false-share.
+//
+// Elements are handed out only inside callbacks or as copies, never as
+// references that outlive the lock. Order holds within a shard; snapshot()
+// returns the whole content as one ordered s21::map, taken with every
+// shard locked at once so no concurrent update is half visible. size(),
+// for_each() and the parallel walks lock one shard at a time and so see
+// each shard at a different moment.
+template <typename Key, typename T, typename Compare = std::less<Key>,
+          typename Hash = std::hash<Key>>
+class concurrent_map {
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using size_type = size_t;
+  using map_type = s21::map<key_type, mapped_type, Compare>;
+
+  static constexpr size_type kDefaultShards = 16;
+
+  explicit concurrent_map(size_type shards = kDefaultShards,
+                          const Hash &hash = Hash())
+      : hash_(hash), shard_count_(shards) {
+    if (shards == 0) {
+      throw std::invalid_argument("concurrent_map needs at least one shard");
+    }
+    shards_ = std::make_unique<Shard[]>(shards);
+  }
+
+  concurrent_map(const concurrent_map &) = delete;
+  concurrent_map &operator=(const concurrent_map &) = delete;
+
+  // Returns false, leaving the element alone, if key is already present.
+  bool insert(const key_type &key, const mapped_type &obj) {
+    Shard &shard = shardFor(key);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex_);
+    return shard.map_.try_emplace(key, obj).second;
+  }
+
+  template <typename... Args>
+  bool try_emplace(const key_type &key, Args &&...args) {
+    Shard &shard = shardFor(key);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex_);
+    return shard.map_.try_emplace(key, std::forward<Args>(args)...).second;
+  }
+
+  // Returns true if key was inserted, false if its value was replaced.
+  template <typename M>
+  bool insert_or_assign(const key_type &key, M &&obj) {
+    Shard &shard = shardFor(key);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex_);
+    return shard.map_.insert_or_assign(key, std::forward<M>(obj)).second;
+  }
+
+  size_type erase(const key_type &key) {
+    Shard &shard = shardFor(key);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex_);
+    auto it = shard.map_.find(key);
+    if (it == shard.map_.end()) {
+      return 0;
+    }
+    shard.map_.erase(it);
+    return 1;
+  }
+
+  // A copy of the value, taken under the shard's shared lock.
+  std::optional<mapped_type> find(const key_type &key) const {
+    const Shard &shard = shardFor(key);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex_);
+    auto it = shard.map_.find(key);
+    if (it == shard.map_.end()) {
+      return std::nullopt;
+    }
+    return it->second;
+  }
+
+  bool contains(const key_type &key) const {
+    const Shard &shard = shardFor(key);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex_);
+    return shard.map_.contains(key);
+  }
+
+  size_type count(const key_type &key) const { return contains(key) ? 1 : 0; }
+
+  // Calls f(mapped_type &) under the shard's exclusive lock if key is
+  // present; f must not call back into this map.
+  template <typename F>
+  bool visit(const key_type &key, F &&f) {
+    Shard &shard = shardFor(key);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex_);
+    auto it = shard.map_.find(key);
+    if (it == shard.map_.end()) {
+      return false;
+    }
+    f(it->second);
+    return true;
+  }
+
+  // Calls f(const mapped_type &) under the shard's shared lock.
+  template <typename F>
+  bool cvisit(const key_type &key, F &&f) const {
+    const Shard &shard = shardFor(key);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex_);
+    auto it = shard.map_.find(key);
+    if (it == shard.map_.end()) {
+      return false;
+    }
+    f(static_cast<const mapped_type &>(it->second));
+    return true;
+  }
+
+  size_type size() const {
+    size_type total = 0;
+    for (size_type i = 0; i < shard_count_; ++i) {
+      std::shared_lock<std::shared_mutex> lock(shards_[i].mutex_);
+      total += shards_[i].map_.size();
+    }
+    return total;
+  }
+
+  bool empty() const { return size() == 0; }
+
+  void clear() {
+    for (size_type i = 0; i < shard_count_; ++i) {
+      std::unique_lock<std::shared_mutex> lock(shards_[i].mutex_);
+      shards_[i].map_.clear();
+    }
+  }
+
+  size_type shard_count() const noexcept { return shard_count_; }
+
+  // Calls f(const value_type &) on the elements of one shard, in key
+  // order, under its shared lock.
+  template <typename F>
+  void for_each_in_shard(size_type shard, F &&f) const {
+    const Shard &target = shards_[shard];
+    std::shared_lock<std::shared_mutex> lock(target.mutex_);
+    for (const value_type &item : target.map_) {
+      f(item);
+    }
+  }
+
+  // Visits every shard in turn, each one under its shared lock.
+  template <typename F>
+  void for_each(F &&f) const {
+    for (size_type i = 0; i < shard_count_; ++i) {
+      for_each_in_shard(i, f);
+    }
+  }
+
+  // Runs f(value_type &) over every element with one pool task per shard,
+  // each holding its shard's exclusive lock, and returns once those tasks
+  // are done, rethrowing the first exception f threw. Other tasks in the
+  // pool are not waited for. f must be safe to call from several threads
+  // at once. Call it from outside the pool: a worker blocked here cannot
+  // run the shard tasks queued behind it.
+  template <typename F>
+  void for_each_parallel(thread_pool &pool, F f) {
+    runPerShard(pool, [this, &f](size_type i) {
+      std::unique_lock<std::shared_mutex> lock(shards_[i].mutex_);
+      for (auto &item : shards_[i].map_) {
+        f(item);
+      }
+    });
+  }
+
+  // As for_each_parallel, but f(const value_type &) runs under shared
+  // locks, so lookups proceed meanwhile.
+  template <typename F>
+  void cfor_each_parallel(thread_pool &pool, F f) const {
+    runPerShard(pool, [this, &f](size_type i) { for_each_in_shard(i, f); });
+  }
+
+  // Copies every shard while holding all their shared locks, taken in
+  // shard order so concurrent snapshots cannot deadlock, then merges the
+  // copies into one ordered map after the locks are released.
+  map_type snapshot() const {
+    std::vector<map_type> copies;
+    copies.reserve(shard_count_);
+    {
+      std::vector<std::shared_lock<std::shared_mutex>> locks;
+      locks.reserve(shard_count_);
+      for (size_type i = 0; i < shard_count_; ++i) {
+        locks.emplace_back(shards_[i].mutex_);
+      }
+      for (size_type i = 0; i < shard_count_; ++i) {
+        copies.push_back(shards_[i].map_);
+      }
+    }
+    map_type result(std::move(copies[0]));
+    for (size_type i = 1; i < shard_count_; ++i) {
+      result.merge(copies[i]);
+    }
+    return result;
+  }
+
+ private:
+  struct alignas(kCacheLineSize) Shard {
+    mutable std::shared_mutex mutex_;
+    map_type map_;
+  };
+
+  // The hash is mixed first: std::hash is the identity for integers, and
+  // keys with a common stride would otherwise crowd a few shards.
+  size_type shardIndex(const key_type &key) const {
+    uint64_t hash = static_cast<uint64_t>(hash_(key)) * 0x9E3779B97F4A7C15ull;
+    return static_cast<size_type>((hash >> 32) % shard_count_);
+  }
+
+  Shard &shardFor(const key_type &key) { return shards_[shardIndex(key)]; }
+
+  // Submits visit(i) for every shard and waits for exactly those tasks.
+  // If a submit throws, the tasks already queued still finish first, as
+  // they refer to this frame.
+  template <typename Visit>
+  void runPerShard(thread_pool &pool, const Visit &visit) const {
+    struct Batch {
+      std::mutex mutex_;
+      std::condition_variable done_;
+      size_type remaining_;
+      std::exception_ptr error_;
+    } batch;
+    batch.remaining_ = shard_count_;
+    std::exception_ptr submit_error;
+    for (size_type i = 0; i < shard_count_; ++i) {
+      try {
+        pool.submit([&batch, &visit, i]() {
+          std::exception_ptr error;
+          try {
+            visit(i);
+          } catch (...) {
+            error = std::current_exception();
+          }
+          std::lock_guard<std::mutex> lock(batch.mutex_);
+          if (error && !batch.error_) {
+            batch.error_ = error;
+          }
+          if (--batch.remaining_ == 0) {
+            batch.done_.notify_one();
+          }
+        });
+      } catch (...) {
+        submit_error = std::current_exception();
+        std::lock_guard<std::mutex> lock(batch.mutex_);
+        batch.remaining_ -= shard_count_ - i;
+        break;
+      }
+    }
+    std::unique_lock<std::mutex> lock(batch.mutex_);
+    batch.done_.wait(lock, [&batch]() { return batch.remaining_ == 0; });
+    if (submit_error) {
+      std::rethrow_exception(submit_error);
+    }
+    if (batch.error_) {
+      std::rethrow_exception(batch.error_);
+    }
+  }
+
+  const Shard &shardFor(const key_type &key) const {
+    return shards_[shardIndex(key)];
+  }
+
+  Hash hash_;
+  size_type shard_count_;
+  std::unique_ptr<Shard[]> shards_;
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_MAP_CONCURRENT_MAP_H_
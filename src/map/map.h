@@ -2,14 +2,21 @@
 #define CPP2_S21_CONTAINERS_1_MAP_MAP_H_
 
 #include <functional>
+#include <iterator>
 #include <limits>
 #include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
+#include "../adt/avl_balance.h"
+#include "../adt/node_handle.h"
 #include "../iterators/iterator_tree.h"
 #include "../../utils/allocator.h"
 #include "../../utils/compare_for_map.h"
+#include "../../utils/is_transparent.h"
 
 namespace s21 {
 
@@ -30,8 +37,38 @@ class map {
       allocator_type>::template rebind_alloc<TreeNode<value_type>>;
 
  public:
-  map(const Allocator& alloc = Allocator())
-      : comparator_(MapCompare<value_type, Compare>()),
+  // An element extract()ed from a map. Its key can be changed before the
+  // node is inserted again, which rekeys an entry without reallocating it.
+  class node_type : public NodeHandle<TreeNode<value_type>, allocator_type,
+                                      node_allocator> {
+    using Base =
+        NodeHandle<TreeNode<value_type>, allocator_type, node_allocator>;
+
+   public:
+    using key_type = Key;
+    using mapped_type = T;
+
+    node_type() noexcept = default;
+
+    // The key is only const while the node is in a map; detached, nothing
+    // orders by it, so it is handed out writable (as std::map does).
+    key_type& key() const {
+      return const_cast<key_type&>(this->node_->data_.first);
+    }
+    mapped_type& mapped() const { return this->node_->data_.second; }
+
+   private:
+    friend class map;
+
+    using Base::Base;
+  };
+
+  using insert_return_type = InsertReturnType<iterator, node_type>;
+
+  map(const Allocator& alloc = Allocator()) : map(Compare(), alloc) {}
+
+  explicit map(const Compare& compare, const Allocator& alloc = Allocator())
+      : comparator_(compare),
         allocator_(
             std::allocator_traits<
                 allocator_type>::select_on_container_copy_construction(alloc)),
@@ -41,14 +78,14 @@ class map {
         size_(0),
         phantom_node_(std::allocator_traits<node_allocator>::allocate(
             allocator_node_, 1)) {
-    initNode(phantom_node_);
+    initHeader();
   }
 
   map(std::initializer_list<value_type> const& items,
       const Allocator& alloc = Allocator())
       : map(alloc) {
     for (auto& item : items) {
-      insert(item);
+      insert(end(), item);
     }
   }
 
@@ -59,10 +96,16 @@ class map {
         size_(0),
         phantom_node_(std::allocator_traits<node_allocator>::allocate(
             allocator_node_, 1)) {
-    initNode(phantom_node_);
-    // can be optimization (insert(root) insert(root->left) insert(root->right))
-    for (auto& item : other) {
-      insert(item);
+    initHeader();
+    try {
+      copySubtree(other.phantom_node_->left_, phantom_node_,
+                  phantom_node_->left_);
+      updateExtremes();
+    } catch (...) {
+      clear();
+      std::allocator_traits<node_allocator>::deallocate(allocator_node_,
+                                                        phantom_node_, 1);
+      throw;
     }
   }
 
@@ -71,7 +114,8 @@ class map {
         allocator_(std::move(other.allocator_)),
         allocator_node_(std::move(other.allocator_node_)),
         size_(std::exchange(other.size_, 0)),
-        phantom_node_(std::exchange(other.phantom_node_, nullptr)) {}
+        phantom_node_(std::exchange(other.phantom_node_, nullptr)),
+        leftmost_(other.leftmost_) {}
 
   ~map() noexcept {
     if (phantom_node_) {
@@ -81,6 +125,29 @@ class map {
     }
   }
 
+  // Builds a perfectly balanced tree straight from a range sorted in
+  // strictly ascending key order, in O(n) and without any rotation or
+  // comparison beyond checking that order.
+  template <typename ForwardIt>
+  static map from_sorted(ForwardIt first, ForwardIt last,
+                         const Allocator& alloc = Allocator()) {
+    map result(alloc);
+    TreeNode<value_type>* previous = nullptr;
+    TreeNode<value_type>* root = result.buildSorted(
+        first, static_cast<size_type>(std::distance(first, last)), previous);
+    result.phantom_node_->left_ = root;
+    if (root) {
+      root->parent_ = result.phantom_node_;
+    }
+    result.updateExtremes();
+    return result;
+  }
+
+  template <typename Range>
+  static map from_sorted(const Range& range) {
+    return from_sorted(std::begin(range), std::end(range));
+  }
+
   map operator=(const map& other) {
     if (this == &other) {
       return *this;
@@ -100,34 +167,65 @@ class map {
   }
 
   mapped_type& at(const key_type& key) const {
-    TreeNode<value_type>* node = _find(phantom_node_->left_, key);
+    TreeNode<value_type>* node = findNode(key);
     if (node == nullptr) {
       throw std::out_of_range("Key not in map");
     }
     return node->data_.second;
   }
 
+  // Inserts a value-initialised element when key is missing.
   mapped_type& operator[](const key_type& key) {
-    return _find(phantom_node_->left_, key)->data_.second;
+    return tryEmplace(key).first->second;
+  }
+
+  mapped_type& operator[](key_type&& key) {
+    return tryEmplace(std::move(key)).first->second;
   }
 
   std::pair<iterator, bool> insert(const_reference value) {
-    bool is_append = true;
-    auto it = iterator(phantom_node_->left_);
-    if (empty()) {
-      phantom_node_->left_ = allocateAndConstruct(value);
-      phantom_node_->left_->parent_ = phantom_node_;
-    } else {
-      size_t old_size = size_;
-      phantom_node_->left_ = _insert(phantom_node_->left_, nullptr, value);
-      if (size_ == old_size) {
-        is_append = false;
-        it = end();
-      } else {
-        it = find(value.first);
-      }
+    TreeNode<value_type>* parent = nullptr;
+    bool as_left = true;
+    TreeNode<value_type>* node =
+        findInsertPosition(value.first, parent, as_left);
+    if (node) {
+      return std::make_pair(iterator(node), false);
+    }
+    node = allocateAndConstruct(value);
+    linkLeaf(node, parent, as_left);
+    return std::make_pair(iterator(node), true);
+  }
+
+  // The hint is the element the new one should precede (end() to append).
+  // When it is right, only the one or two neighbours are compared instead
+  // of descending from the root.
+  iterator insert(iterator hint, const_reference value) {
+    TreeNode<value_type>* parent = nullptr;
+    bool as_left = true;
+    TreeNode<value_type>* node =
+        findHintPosition(hint.ptr_, value.first, parent, as_left);
+    if (node) {
+      return iterator(node);
+    }
+    node = allocateAndConstruct(value);
+    linkLeaf(node, parent, as_left);
+    return iterator(node);
+  }
+
+  template <typename... Args>
+  iterator emplace_hint(iterator hint, Args&&... args) {
+    TreeNode<value_type>* node =
+        allocateAndConstruct(std::forward<Args>(args)...);
+    TreeNode<value_type>* parent = nullptr;
+    bool as_left = true;
+    TreeNode<value_type>* existing =
+        findHintPosition(hint.ptr_, node->data_.first, parent, as_left);
+    if (existing) {
+      destroyAndDeallocate(node);
+      return iterator(existing);
     }
-    return std::make_pair(it, is_append);
+    linkLeaf(node, parent, as_left);
+    return iterator(node);
   }
 
   std::pair<iterator, bool> insert(const key_type& key,
@@ -135,29 +233,156 @@ class map {
     return insert(std::make_pair(key, obj));
   }
 
-  std::pair<iterator, bool> insert_or_assign(const key_type& key,
-                                             const mapped_type& obj) {
-    iterator it = find(key);
-    if (it == end()) {
-      return insert(key, obj);
+  // Builds the mapped value from args only if key is missing; when it is
+  // present, args are not touched (so nothing is moved from).
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const key_type& key, Args&&... args) {
+    return tryEmplace(key, std::forward<Args>(args)...);
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(key_type&& key, Args&&... args) {
+    return tryEmplace(std::move(key), std::forward<Args>(args)...);
+  }
+
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(const key_type& key, M&& obj) {
+    std::pair<iterator, bool> result = tryEmplace(key, std::forward<M>(obj));
+    if (!result.second) {
+      result.first->second = std::forward<M>(obj);
+    }
+    return result;
+  }
+
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(key_type&& key, M&& obj) {
+    std::pair<iterator, bool> result =
+        tryEmplace(std::move(key), std::forward<M>(obj));
+    if (!result.second) {
+      result.first->second = std::forward<M>(obj);
     }
-    operator[](key) = obj;
-    return std::make_pair(it, true);
+    return result;
   }
 
   iterator find(const key_type& key) const {
-    TreeNode<value_type>* node = _find(phantom_node_->left_, key);
+    TreeNode<value_type>* node = findNode(key);
     if (node == nullptr) {
       return end();
     }
     return iterator(node);
   }
 
-  iterator begin() noexcept { return iterator(findMin(phantom_node_->left_)); }
-  iterator end() noexcept { return iterator(phantom_node_); }
-  iterator begin() const noexcept {
-    return iterator(findMin(phantom_node_->left_));
+  // The K overloads only exist for a transparent Compare and look up
+  // anything it orders against key_type without converting it to a key.
+  template <typename K, typename C = Compare,
+            std::enable_if_t<is_transparent_v<C>, int> = 0>
+  iterator find(const K& key) const {
+    TreeNode<value_type>* node = findNode(key);
+    if (node == nullptr) {
+      return end();
+    }
+    return iterator(node);
   }
+
+  bool contains(const key_type& key) const { return findNode(key) != nullptr; }
+
+  template <typename K, typename C = Compare,
+            std::enable_if_t<is_transparent_v<C>, int> = 0>
+  bool contains(const K& key) const {
+    return findNode(key) != nullptr;
+  }
+
+  size_type count(const key_type& key) const { return contains(key) ? 1 : 0; }
+
+  template <typename K, typename C = Compare,
+            std::enable_if_t<is_transparent_v<C>, int> = 0>
+  size_type count(const K& key) const {
+    return contains(key) ? 1 : 0;
+  }
+
+  // The first element whose key is not less than key.
+  iterator lower_bound(const key_type& key) const {
+    return iterator(lowerBoundNode(key));
+  }
+
+  template <typename K, typename C = Compare,
+            std::enable_if_t<is_transparent_v<C>, int> = 0>
+  iterator lower_bound(const K& key) const {
+    return iterator(lowerBoundNode(key));
+  }
+
+  // The first element whose key is greater than key.
+  iterator upper_bound(const key_type& key) const {
+    return iterator(upperBoundNode(key));
+  }
+
+  template <typename K, typename C = Compare,
+            std::enable_if_t<is_transparent_v<C>, int> = 0>
+  iterator upper_bound(const K& key) const {
+    return iterator(upperBoundNode(key));
+  }
+
+  // Keys are unique, so the range is empty or a single element and both
+  // ends come out of one descent.
+  std::pair<iterator, iterator> equal_range(const key_type& key) const {
+    return equalRange(key);
+  }
+
+  template <typename K, typename C = Compare,
+            std::enable_if_t<is_transparent_v<C>, int> = 0>
+  std::pair<iterator, iterator> equal_range(const K& key) const {
+    return equalRange(key);
+  }
+
+  // The elements with keys in [low, high); empty when high is not after
+  // low. Both ends are found by a descent, so the view costs O(log n) to
+  // build and iterating it visits only the matching elements.
+  TreeRange<iterator> range(const key_type& low, const key_type& high) const {
+    return keyRange(low, high);
+  }
+
+  template <typename K1, typename K2, typename C = Compare,
+            std::enable_if_t<is_transparent_v<C>, int> = 0>
+  TreeRange<iterator> range(const K1& low, const K2& high) const {
+    return keyRange(low, high);
+  }
+
+  // The number of elements whose key is less than key. Nodes know their
+  // subtree sizes, so rank, select and count_range take one descent each.
+  size_type rank(const key_type& key) const { return rankOf(key); }
+
+  // The element with index position in key order, or end().
+  iterator select(size_type position) const {
+    TreeNode<value_type>* node = phantom_node_->left_;
+    if (position >= size_) {
+      return end();
+    }
+    for (;;) {
+      size_type left = AvlBalance<TreeNode<value_type>>::count(node->left_);
+      if (position < left) {
+        node = node->left_;
+      } else if (position > left) {
+        position -= left + 1;
+        node = node->right_;
+      } else {
+        return iterator(node);
+      }
+    }
+  }
+
+  // The number of elements with keys in [low, high).
+  size_type count_range(const key_type& low, const key_type& high) const {
+    if (!comparator_.key_comp()(low, high)) {
+      return 0;
+    }
+    return rankOf(high) - rankOf(low);
+  }
+
+  Compare key_comp() const { return comparator_.key_comp(); }
+
+  iterator begin() noexcept { return iterator(leftmost_); }
+  iterator end() noexcept { return iterator(phantom_node_); }
+  iterator begin() const noexcept { return iterator(leftmost_); }
   iterator end() const noexcept { return iterator(phantom_node_); }
   size_type size() const noexcept { return size_; }
   bool empty() const noexcept { return size_ == 0; }
@@ -167,7 +392,7 @@ class map {
 
   void clear() noexcept {
     _clear(phantom_node_->left_);
-    initNode(phantom_node_);
+    initHeader();
   }
 
   void swap(map& rhs) noexcept {
@@ -176,24 +401,99 @@ class map {
     std::swap(allocator_node_, rhs.allocator_node_);
     std::swap(size_, rhs.size_);
     std::swap(phantom_node_, rhs.phantom_node_);
+    std::swap(leftmost_, rhs.leftmost_);
   }
 
-  void erase(iterator pos) { deleteNode(pos.ptr_); }
+  void erase(iterator pos) { eraseNode(pos.ptr_); }
+
+  // Takes the element out of the map without destroying it. Iterators to
+  // other elements stay valid.
+  node_type extract(iterator pos) {
+    unlinkNode(pos.ptr_);
+    --size_;
+    return node_type(pos.ptr_, allocator_, allocator_node_);
+  }
+
+  // An empty handle if key is missing.
+  node_type extract(const key_type& key) {
+    TreeNode<value_type>* node = findNode(key);
+    if (node == nullptr) {
+      return node_type();
+    }
+    return extract(iterator(node));
+  }
 
-  bool contains(const key_type& key) { return find(key) != end(); }
+  // Links the extracted node in as it is: nothing is allocated or copied.
+  // If the key is already present the node is handed back in the result.
+  // The node must come from a container with an equal allocator.
+  insert_return_type insert(node_type&& handle) {
+    if (handle.empty()) {
+      return {end(), false, node_type()};
+    }
+    TreeNode<value_type>* parent = nullptr;
+    bool as_left = true;
+    TreeNode<value_type>* existing =
+        findInsertPosition(handle.key(), parent, as_left);
+    if (existing) {
+      return {iterator(existing), false, std::move(handle)};
+    }
+    TreeNode<value_type>* node = handle.release();
+    linkLeaf(node, parent, as_left);
+    ++size_;
+    return {iterator(node), true, node_type()};
+  }
 
+  // As insert(hint, value). If the key is already present, handle keeps
+  // the node.
+  iterator insert(iterator hint, node_type&& handle) {
+    if (handle.empty()) {
+      return end();
+    }
+    TreeNode<value_type>* parent = nullptr;
+    bool as_left = true;
+    TreeNode<value_type>* existing =
+        findHintPosition(hint.ptr_, handle.key(), parent, as_left);
+    if (existing) {
+      return iterator(existing);
+    }
+    TreeNode<value_type>* node = handle.release();
+    linkLeaf(node, parent, as_left);
+    ++size_;
+    return iterator(node);
+  }
+
+  // Moves the elements whose keys are missing here out of other by
+  // relinking their nodes: nothing is allocated or copied, and iterators
+  // to moved elements stay valid, now pointing into this map. A small
+  // other is spliced in node by node; when the sizes are comparable both
+  // trees are rebuilt from one linear merge instead. The allocators must
+  // compare equal.
   void merge(map& other) {
-    map new_other;
-    for (auto& item : other) {
-      if (!contains(item.first)) {
-        insert(item);
-      } else {
-        new_other.insert(item);
+    if (this == &other || other.empty()) {
+      return;
+    }
+    if (AvlBalance<TreeNode<value_type>>::preferLinearMerge(size_,
+                                                            other.size_)) {
+      mergeLinear(other);
+      return;
+    }
+    TreeNode<value_type>* node = other.leftmost_;
+    while (node != other.phantom_node_) {
+      TreeNode<value_type>* next = (++iterator(node)).ptr_;
+      TreeNode<value_type>* parent = nullptr;
+      bool as_left = true;
+      if (!findInsertPosition(node->data_.first, parent, as_left)) {
+        other.unlinkNode(node);
+        --other.size_;
+        linkLeaf(node, parent, as_left);
+        ++size_;
       }
+      node = next;
     }
-    other = new_other;
   }
 
+  void merge(map&& other) { merge(other); }
+
   template <typename... Args>
   std::vector<std::pair<iterator, bool>> insert_many(Args&&... args) {
     std::vector<std::pair<iterator, bool>> return_vector;
@@ -210,323 +510,303 @@ class map {
     node->parent_ = nullptr;
   }
 
-  void _clear(TreeNode<value_type>* node) noexcept {
-    if (node == nullptr) {
-      return;
-    }
-    if (node->left_) {
-      _clear(node->left_);
-    }
-    if (node->right_) {
-      _clear(node->right_);
-    }
-    destroyAndDeallocate(node);
+  // The header's left_ is the root and its right_ the last node; leftmost_
+  // is the first one. Both extremes point back at the header when the map
+  // is empty, so begin() == end() and --end() needs no special case.
+  void initHeader() noexcept {
+    phantom_node_->left_ = nullptr;
+    phantom_node_->right_ = phantom_node_;
+    phantom_node_->parent_ = nullptr;
+    phantom_node_->height_ = 0;
+    leftmost_ = phantom_node_;
   }
 
-  void updateHeight(TreeNode<value_type>* root) {
-    if (root == nullptr) return;
-    int val = 1;
-    if (root->left_ != nullptr) val = root->left_->height_ + 1;
-    if (root->right_ != nullptr) val = std::max(val, root->right_->height_ + 1);
-    root->height_ = val;
+  // Recomputes both extremes after a whole tree was built at once.
+  void updateExtremes() noexcept {
+    TreeNode<value_type>* root = phantom_node_->left_;
+    leftmost_ = root ? findMin(root) : phantom_node_;
+    phantom_node_->right_ = root ? findMax(root) : phantom_node_;
   }
 
-  TreeNode<value_type>* leftRotate(TreeNode<value_type>* root) {
-    TreeNode<value_type>* tmp_node = root->left_;
-    if (tmp_node->right_ != nullptr) {
-      tmp_node->right_->parent_ = root;
-    }
-    root->left_ = tmp_node->right_;
-    if (root->left_ != nullptr) {
-      root->left_->parent_ = root;
-    }
-    tmp_node->right_ = root;
-    tmp_node->parent_ = root->parent_;
-    root->parent_ = tmp_node;
-    if (tmp_node->parent_ != phantom_node_ &&
-        comparator_(root->data_, tmp_node->parent_->data_)) {
-      tmp_node->parent_->left_ = tmp_node;
-    } else {
-      if (tmp_node->parent_ != phantom_node_) {
-        tmp_node->parent_->right_ = tmp_node;
-      }
-    }
-    root = tmp_node;
-    updateHeight(root->left_);
-    updateHeight(root->right_);
-    updateHeight(root);
-    updateHeight(root->parent_);
-    return root;
-  }
-
-  TreeNode<value_type>* rightRotate(TreeNode<value_type>* root) {
-    TreeNode<value_type>* tmp_node = root->right_;
-    root->right_ = tmp_node->left_;
-    if (tmp_node->left_ != nullptr) {
-      tmp_node->left_->parent_ = root;
-    }
-    tmp_node->left_ = root;
-    tmp_node->parent_ = root->parent_;
-    root->parent_ = tmp_node;
-    if (tmp_node->parent_ != nullptr && tmp_node->parent_ != phantom_node_ &&
-        comparator_(root->data_, tmp_node->parent_->data_)) {
-      tmp_node->parent_->left_ = tmp_node;
-    } else {
-      if (tmp_node->parent_ != nullptr && tmp_node->parent_ != phantom_node_) {
-        tmp_node->parent_->right_ = tmp_node;
-      }
+  // A new leaf can only become an extreme by hanging off the old one on
+  // the outer side, so keeping them up to date costs one comparison.
+  void linkLeaf(TreeNode<value_type>* node, TreeNode<value_type>* parent,
+                bool as_left) noexcept {
+    if (parent == phantom_node_) {
+      leftmost_ = node;
+      phantom_node_->right_ = node;
+    } else if (as_left && parent == leftmost_) {
+      leftmost_ = node;
+    } else if (!as_left && parent == phantom_node_->right_) {
+      phantom_node_->right_ = node;
     }
-    root = tmp_node;
-    updateHeight(root->left_);
-    updateHeight(root->right_);
-    updateHeight(root);
-    updateHeight(root->parent_);
-    return root;
+    AvlBalance<TreeNode<value_type>>::insertLeaf(node, parent, as_left,
+                                                 phantom_node_);
   }
 
-  TreeNode<value_type>* rightLeftRotate(TreeNode<value_type>* root) {
-    root->left_ = rightRotate(root->left_);
-    return leftRotate(root);
-  }
-
-  TreeNode<value_type>* leftRightRotate(TreeNode<value_type>* root) {
-    root->right_ = leftRotate(root->right_);
-    return rightRotate(root);
+  void eraseNode(TreeNode<value_type>* node) {
+    unlinkNode(node);
+    destroyAndDeallocate(node);
   }
 
-  TreeNode<value_type>* balance(TreeNode<value_type>* root) {
-    int first_height = 0;
-    int second_height = 0;
-    if (root->left_ != nullptr) {
-      first_height = root->left_->height_;
-    }
-    if (root->right_ != nullptr) {
-      second_height = root->right_->height_;
-    }
-    if (std::abs(first_height - second_height) == 2) {
-      if (first_height < second_height) {
-        int right_height1 = 0;
-        int right_height2 = 0;
-        if (root->right_->right_ != nullptr) {
-          right_height2 = root->right_->right_->height_;
-        }
-        if (root->right_->left_ != nullptr) {
-          right_height1 = root->right_->left_->height_;
-        }
-        if (right_height1 > right_height2) {
-          root = leftRightRotate(root);
+  // Takes node out of the tree without freeing it or counting it out.
+  void unlinkNode(TreeNode<value_type>* node) {
+    if (node == leftmost_) {
+      leftmost_ = (++iterator(node)).ptr_;
+    }
+    if (node == phantom_node_->right_) {
+      phantom_node_->right_ = (--iterator(node)).ptr_;
+    }
+    AvlBalance<TreeNode<value_type>>::erase(node, phantom_node_);
+  }
+
+  // Flattens both trees into sorted lists, merges them in one pass while
+  // other's duplicates go to a list of their own, and rebuilds both trees
+  // balanced: O(n + m) comparisons and relinks. If a comparison throws,
+  // the unmerged rest of each list stays with its own tree, so both come
+  // out valid with part of other moved.
+  void mergeLinear(map& other) {
+    using Balance = AvlBalance<TreeNode<value_type>>;
+    const Compare& compare = comparator_.key_comp();
+    TreeNode<value_type>* mine =
+        Balance::flatten(phantom_node_->left_, nullptr);
+    TreeNode<value_type>* theirs =
+        Balance::flatten(other.phantom_node_->left_, nullptr);
+    TreeNode<value_type>* kept = nullptr;
+    TreeNode<value_type>* rejected = nullptr;
+    TreeNode<value_type>** kept_tail = &kept;
+    TreeNode<value_type>** rejected_tail = &rejected;
+    size_type moved = 0;
+    auto take = [](TreeNode<value_type>**& tail,
+                   TreeNode<value_type>*& list) noexcept {
+      *tail = list;
+      tail = &list->right_;
+      list = list->right_;
+    };
+    auto rebuild = [&]() {
+      *kept_tail = mine;
+      *rejected_tail = theirs;
+      size_ += moved;
+      other.size_ -= moved;
+      phantom_node_->left_ = Balance::buildFromList(kept, size_, phantom_node_);
+      other.phantom_node_->left_ =
+          Balance::buildFromList(rejected, other.size_, other.phantom_node_);
+      updateExtremes();
+      other.updateExtremes();
+    };
+    try {
+      while (mine && theirs) {
+        if (compare(theirs->data_.first, mine->data_.first)) {
+          take(kept_tail, theirs);
+          ++moved;
         } else {
-          root = rightRotate(root);
-        }
-      } else {
-        int left_height1 = 0;
-        int left_height2 = 0;
-        if (root->left_->right_ != nullptr) {
-          left_height2 = root->left_->right_->height_;
-        }
-        if (root->left_->left_ != nullptr) {
-          left_height1 = root->left_->left_->height_;
-        }
-        if (left_height1 > left_height2) {
-          root = leftRotate(root);
-        } else {
-          root = rightLeftRotate(root);
+          if (!compare(mine->data_.first, theirs->data_.first)) {
+            take(rejected_tail, theirs);
+          }
+          take(kept_tail, mine);
         }
       }
+    } catch (...) {
+      rebuild();
+      throw;
     }
-    return root;
-  }
-
-  TreeNode<value_type>* _insert(TreeNode<value_type>* root,
-                                TreeNode<value_type>* parent,
-                                const_reference value) {
-    if (root == nullptr) {
-      root = allocateAndConstruct(value);
-      root->height_ = 1;
-      root->parent_ = parent;
-    } else if (comparator_(value, root->data_)) {
-      root->left_ = _insert(root->left_, root, value);
-      int first_height = 0;
-      int second_height = 0;
-      if (root->left_ != nullptr) {
-        first_height = root->left_->height_;
-      }
-      if (root->right_ != nullptr) {
-        second_height = root->right_->height_;
-      }
-      if (std::abs(first_height - second_height) == 2) {
-        if (root->left_ != nullptr && comparator_(value, root->left_->data_)) {
-          root = leftRotate(root);
-        } else {
-          root = rightLeftRotate(root);
-        }
-      }
-    } else if (comparator_(root->data_, value)) {
-      root->right_ = _insert(root->right_, root, value);
-      int first_height = 0;
-      int second_height = 0;
-      if (root->left_ != nullptr) {
-        first_height = root->left_->height_;
-      }
-      if (root->right_ != nullptr) {
-        second_height = root->right_->height_;
-      }
-      if (std::abs(first_height - second_height) == 2) {
-        if (root->right_ != nullptr &&
-            comparator_(value, root->right_->data_)) {
-          root = leftRightRotate(root);
-        } else {
-          root = rightRotate(root);
-        }
-      }
-    } else {
+    for (; theirs; ++moved) {
+      take(kept_tail, theirs);
     }
-    updateHeight(root);
-    return root;
+    rebuild();
   }
 
-  TreeNode<value_type>* _find(TreeNode<value_type>* node,
-                              const key_type& key) const {
+  void _clear(TreeNode<value_type>* node) noexcept {
     if (node == nullptr) {
-      return nullptr;
-    }
-    if (Compare{}(key, node->data_.first)) {
-      return _find(node->left_, key);
+      return;
     }
-    if (Compare{}(node->data_.first, key)) {
-      return _find(node->right_, key);
+    if (node->left_) {
+      _clear(node->left_);
     }
-    return node;
-  }
-
-  TreeNode<value_type>* findMin(TreeNode<value_type>* node) const {
-    while (node && node->left_) {
-      node = node->left_;
+    if (node->right_) {
+      _clear(node->right_);
     }
-    return node;
+    destroyAndDeallocate(node);
   }
 
-  void deleteNode(TreeNode<value_type>*& node) {
-    if (node == nullptr) {
-      return;
-    }
-    size_t count_childs = howMuchChildren(node);
-    switch (count_childs) {
-      case 0:
-        deleteLeaf(node);
-        break;
-      case 1:
-        deleteNodeWithOneChild(node);
-        break;
-      case 2:
-        node = deleteNodeWitchTwoChildren(node);
-        break;
-    }
-  }
-
-  TreeNode<value_type>* deleteNodeWitchTwoChildren(
-      TreeNode<value_type>*& node) {
-    TreeNode<value_type>* min = findMin(node->right_);
-    if (node->right_ == min) {
-      min->parent_ = node->parent_;
-      node->parent_ = setupParent(min, node->parent_);
-      min->left_ = node->left_;
-      node->left_->parent_ = min;
-      destroyAndDeallocate(node);
-    } else if (howMuchChildren(min) == 0) {
-      min->parent_->left_ = nullptr;
-      min->parent_ = node->parent_;
-      node->parent_ = setupParent(min, node->parent_);
-      min->left_ = node->left_;
-      min->right_ = node->right_;
-      node->left_->parent_ = min;
-      node->right_->parent_ = min;
-      destroyAndDeallocate(node);
-    } else {
-      min->parent_->left_ = min->right_;
-      min->right_->parent_ = min->parent_;
-      min->parent_ = node->parent_;
-      node->parent_ = setupParent(min, node->parent_);
-      min->left_ = node->left_;
-      min->right_ = node->right_;
-      node->left_->parent_ = min;
-      node->right_->parent_ = min;
-      destroyAndDeallocate(node);
+  // One comparison chain from the root: the node holding key, or nullptr.
+  template <typename K>
+  TreeNode<value_type>* findNode(const K& key) const {
+    const Compare& compare = comparator_.key_comp();
+    TreeNode<value_type>* node = phantom_node_->left_;
+    while (node) {
+      if (compare(key, node->data_.first)) {
+        node = node->left_;
+      } else if (compare(node->data_.first, key)) {
+        node = node->right_;
+      } else {
+        return node;
+      }
     }
-    return min;
+    return nullptr;
   }
 
-  TreeNode<value_type>* setupParent(TreeNode<value_type>* node,
-                                    TreeNode<value_type>* parent) {
-    if (parent == end().ptr_) {
-      parent->left_ = node;
-    } else {
-      if (comparator_(node->data_, parent->data_)) {
-        parent->left_ = node;
+  template <typename K>
+  TreeNode<value_type>* lowerBoundNode(const K& key) const {
+    const Compare& compare = comparator_.key_comp();
+    TreeNode<value_type>* node = phantom_node_->left_;
+    TreeNode<value_type>* bound = phantom_node_;
+    while (node) {
+      if (compare(node->data_.first, key)) {
+        node = node->right_;
       } else {
-        parent->right_ = node;
+        bound = node;
+        node = node->left_;
       }
     }
-    node->parent_ = parent;
-    return parent;
+    return bound;
   }
 
-  void deleteNodeWithOneChild(TreeNode<value_type>* node) {
-    if (node->right_) {
-      deleteNodeWithRightChild(node);
-    } else if (node->left_) {
-      deleteNodeWithLeftChild(node);
+  template <typename K>
+  TreeNode<value_type>* upperBoundNode(const K& key) const {
+    const Compare& compare = comparator_.key_comp();
+    TreeNode<value_type>* node = phantom_node_->left_;
+    TreeNode<value_type>* bound = phantom_node_;
+    while (node) {
+      if (compare(key, node->data_.first)) {
+        bound = node;
+        node = node->left_;
+      } else {
+        node = node->right_;
+      }
     }
+    return bound;
   }
 
-  void deleteNodeWithRightChild(TreeNode<value_type>* node) {
-    TreeNode<value_type>* child = node->right_;
-    TreeNode<value_type>* parent = node->parent_;
-    child->parent_ = parent;
-    if (comparator_(parent->data_, child->data_)) {
-      parent->right_ = child;
-    } else if (comparator_(child->data_, parent->data_)) {
-      parent->left_ = child;
+  template <typename K>
+  std::pair<iterator, iterator> equalRange(const K& key) const {
+    const Compare& compare = comparator_.key_comp();
+    iterator first(lowerBoundNode(key));
+    iterator last = first;
+    if (first.ptr_ != phantom_node_ && !compare(key, first.ptr_->data_.first)) {
+      ++last;
     }
-    destroyAndDeallocate(node);
+    return std::make_pair(first, last);
   }
 
-  void deleteNodeWithLeftChild(TreeNode<value_type>* node) {
-    TreeNode<value_type>* child = node->left_;
-    TreeNode<value_type>* parent = node->parent_;
-    child->parent_ = parent;
-    if (comparator_(parent->data_, child->data_) && parent != phantom_node_) {
-      parent->right_ = child;
-
-    } else if (comparator_(child->data_, parent->data_)) {
-      parent->left_ = child;
+  size_type rankOf(const key_type& key) const {
+    const Compare& compare = comparator_.key_comp();
+    size_type rank = 0;
+    TreeNode<value_type>* node = phantom_node_->left_;
+    while (node) {
+      if (compare(node->data_.first, key)) {
+        rank += AvlBalance<TreeNode<value_type>>::count(node->left_) + 1;
+        node = node->right_;
+      } else {
+        node = node->left_;
+      }
     }
-    destroyAndDeallocate(node);
-  }
-
-  void deleteLeaf(TreeNode<value_type>* node) {
-    TreeNode<value_type>* parent = node->parent_;
-    if (parent == phantom_node_) {
-      destroyAndDeallocate(node);
-      phantom_node_->left_ = nullptr;
-      return;
+    return rank;
+  }
+
+  template <typename K1, typename K2>
+  TreeRange<iterator> keyRange(const K1& low, const K2& high) const {
+    const Compare& compare = comparator_.key_comp();
+    iterator first(lowerBoundNode(low));
+    if (!compare(low, high)) {
+      return TreeRange<iterator>(first, first);
+    }
+    return TreeRange<iterator>(first, iterator(lowerBoundNode(high)));
+  }
+
+  // Returns the node holding key, or nullptr together with the leaf slot
+  // (parent and side) where key belongs.
+  TreeNode<value_type>* findInsertPosition(const key_type& key,
+                                           TreeNode<value_type>*& parent,
+                                           bool& as_left) const {
+    const Compare& compare = comparator_.key_comp();
+    TreeNode<value_type>* node = phantom_node_->left_;
+    parent = phantom_node_;
+    as_left = true;
+    while (node) {
+      parent = node;
+      if (compare(key, node->data_.first)) {
+        as_left = true;
+        node = node->left_;
+      } else if (compare(node->data_.first, key)) {
+        as_left = false;
+        node = node->right_;
+      } else {
+        return node;
+      }
     }
-    if (comparator_(node->data_, parent->data_)) {
-      parent->left_ = nullptr;
+    return nullptr;
+  }
+
+  // The one descent behind try_emplace, operator[] and insert_or_assign:
+  // the node is only built once the key is known to be missing.
+  template <typename K, typename... Args>
+  std::pair<iterator, bool> tryEmplace(K&& key, Args&&... args) {
+    TreeNode<value_type>* parent = nullptr;
+    bool as_left = true;
+    TreeNode<value_type>* node = findInsertPosition(key, parent, as_left);
+    if (node) {
+      return std::make_pair(iterator(node), false);
+    }
+    node = allocateAndConstruct(
+        std::piecewise_construct, std::forward_as_tuple(std::forward<K>(key)),
+        std::forward_as_tuple(std::forward<Args>(args)...));
+    linkLeaf(node, parent, as_left);
+    return std::make_pair(iterator(node), true);
+  }
+
+  // Like findInsertPosition, but first checks whether key fits between the
+  // hint and its predecessor (or successor). Two in-order neighbours always
+  // have a free child slot facing each other, so a correct hint needs no
+  // descent; a wrong one falls back to the full search.
+  TreeNode<value_type>* findHintPosition(TreeNode<value_type>* hint,
+                                         const key_type& key,
+                                         TreeNode<value_type>*& parent,
+                                         bool& as_left) const {
+    const Compare& compare = comparator_.key_comp();
+    if (hint == phantom_node_) {
+      TreeNode<value_type>* last = phantom_node_->right_;
+      if (last != phantom_node_ && compare(last->data_.first, key)) {
+        parent = last;
+        as_left = false;
+        return nullptr;
+      }
+    } else if (compare(key, hint->data_.first)) {
+      TreeNode<value_type>* before =
+          hint == leftmost_ ? phantom_node_ : (--iterator(hint)).ptr_;
+      if (before == phantom_node_ || compare(before->data_.first, key)) {
+        as_left = hint->left_ == nullptr;
+        parent = as_left ? hint : before;
+        return nullptr;
+      }
+    } else if (compare(hint->data_.first, key)) {
+      TreeNode<value_type>* after = hint == phantom_node_->right_
+                                        ? phantom_node_
+                                        : (++iterator(hint)).ptr_;
+      if (after == phantom_node_ || compare(key, after->data_.first)) {
+        as_left = hint->right_ != nullptr;
+        parent = as_left ? after : hint;
+        return nullptr;
+      }
     } else {
-      parent->right_ = nullptr;
+      return hint;
     }
-    destroyAndDeallocate(node);
+    return findInsertPosition(key, parent, as_left);
   }
 
-  size_t howMuchChildren(TreeNode<value_type>* node) const {
-    size_t count = 0;
-    if (node->right_) ++count;
-    if (node->left_) ++count;
-    return count;
+  TreeNode<value_type>* findMax(TreeNode<value_type>* node) const {
+    while (node && node->right_) {
+      node = node->right_;
+    }
+    return node;
   }
 
-  // #############################################
+  TreeNode<value_type>* findMin(TreeNode<value_type>* node) const {
+    while (node && node->left_) {
+      node = node->left_;
+    }
+    return node;
+  }
 
   void destroyAndDeallocate(TreeNode<value_type>* node) {
     std::allocator_traits<allocator_type>::destroy(allocator_, &(node->data_));
@@ -534,22 +814,88 @@ class map {
     --size_;
   }
 
-  TreeNode<value_type>* allocateAndConstruct(const_reference value) {
+  template <typename... Args>
+  TreeNode<value_type>* allocateAndConstruct(Args&&... args) {
     TreeNode<value_type>* node =
         std::allocator_traits<node_allocator>::allocate(allocator_node_, 1);
-    std::allocator_traits<allocator_type>::construct(allocator_, &(node->data_),
-                                                     value);
+    try {
+      std::allocator_traits<allocator_type>::construct(
+          allocator_, &(node->data_), std::forward<Args>(args)...);
+    } catch (...) {
+      std::allocator_traits<node_allocator>::deallocate(allocator_node_, node,
+                                                        1);
+      throw;
+    }
     ++size_;
     initNode(node);
     return node;
   }
 
+  // Clones source under parent, linking every node before descending so
+  // that a throwing copy leaves a well-formed partial tree to clear().
+  void copySubtree(const TreeNode<value_type>* source,
+                   TreeNode<value_type>* parent, TreeNode<value_type>*& slot) {
+    if (source == nullptr) {
+      return;
+    }
+    TreeNode<value_type>* node = allocateAndConstruct(source->data_);
+    node->parent_ = parent;
+    node->count_ = source->count_;
+    node->height_ = source->height_;
+    slot = node;
+    copySubtree(source->left_, node, node->left_);
+    copySubtree(source->right_, node, node->right_);
+  }
+
+  // Takes count elements from first in order: the left half becomes the
+  // left subtree, the next element the root, the rest the right subtree.
+  template <typename ForwardIt>
+  TreeNode<value_type>* buildSorted(ForwardIt& first, size_type count,
+                                    TreeNode<value_type>*& previous) {
+    if (count == 0) {
+      return nullptr;
+    }
+    const Compare& compare = comparator_.key_comp();
+    size_type left_count = count / 2;
+    TreeNode<value_type>* left = buildSorted(first, left_count, previous);
+    TreeNode<value_type>* node = nullptr;
+    try {
+      node = allocateAndConstruct(*first);
+      ++first;
+      if (previous && !compare(previous->data_.first, node->data_.first)) {
+        destroyAndDeallocate(node);
+        throw std::invalid_argument(
+            "from_sorted needs strictly ascending keys");
+      }
+    } catch (...) {
+      _clear(left);
+      throw;
+    }
+    previous = node;
+    node->left_ = left;
+    if (left) {
+      left->parent_ = node;
+    }
+    try {
+      node->right_ = buildSorted(first, count - left_count - 1, previous);
+    } catch (...) {
+      _clear(node);
+      throw;
+    }
+    if (node->right_) {
+      node->right_->parent_ = node;
+    }
+    AvlBalance<TreeNode<value_type>>::update(node);
+    return node;
+  }
+
  private:
   MapCompare<value_type, Compare> comparator_;
   allocator_type allocator_;
   node_allocator allocator_node_;
   size_t size_;
   TreeNode<value_type>* phantom_node_;
+  TreeNode<value_type>* leftmost_;
 };
 
 }  // namespace s21
@@ -0,0 +1,456 @@
+#ifndef CPP2_S21_CONTAINERS_1_MAP_SKIPLIST_MAP_H_
+#define CPP2_S21_CONTAINERS_1_MAP_SKIPLIST_MAP_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <optional>
+#include <utility>
+
+#include "../../utils/allocator.h"
+#include "../../utils/cache_line.h"
+#include "../../utils/epoch_reclamation.h"
+
+namespace s21 {
+
+// Lock-free ordered map: a skip list whose links are updated with CAS
+// only. Erasing is logical, then physical: the low bit of a node's
+// outgoing links marks it deleted, and any thread that later walks past
+// it unlinks it. Lookups and iteration never write and never retry, so
+// they finish in a bounded number of steps whatever other threads do.
+//
+// Memory is reclaimed through EpochReclamation; every operation pins the
+// domain, and iterators keep it pinned while they live, so they can keep
+// walking forward through nodes that are erased or inserted meanwhile.
+// An iterator must stay on the thread that created it.
+//
+// Values are fixed once inserted. The allocator must be stateless (see
+// EpochReclamation).
+template <typename Key, typename T, typename Compare = std::less<Key>,
+          typename Allocator = Allocator<std::pair<const Key, T>>>
+class skiplist_map {
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using reference = const value_type &;
+  using const_reference = const value_type &;
+  using size_type = size_t;
+  using allocator_type = Allocator;
+
+  static constexpr int kMaxLevel = 16;
+
+ private:
+  using Link = std::atomic<uintptr_t>;
+
+  // The links follow the node in the same allocation, one per level.
+  struct Node {
+    explicit Node(int height) : height_(height), refs_(2) {}
+
+    value_type &data() noexcept {
+      return *std::launder(reinterpret_cast<value_type *>(storage_));
+    }
+
+    const key_type &key() noexcept { return data().first; }
+
+    Link *links() noexcept {
+      return reinterpret_cast<Link *>(reinterpret_cast<char *>(this) +
+                                      kLinkOffset);
+    }
+
+    alignas(value_type) unsigned char storage_[sizeof(value_type)];
+    int height_;
+    // Held by the inserting and by the erasing thread; whichever lets go
+    // last retires the node, as only then is it unlinked on every level.
+    std::atomic<int> refs_;
+  };
+
+  static constexpr size_t kLinkOffset =
+      (sizeof(Node) + alignof(Link) - 1) / alignof(Link) * alignof(Link);
+
+  using block_type = std::max_align_t;
+  using block_allocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<block_type>;
+
+ public:
+  class const_iterator {
+    friend class skiplist_map;
+
+   public:
+    using value_type = skiplist_map::value_type;
+    using difference_type = ptrdiff_t;
+    using pointer = const value_type *;
+    using reference = const value_type &;
+    using iterator_category = std::forward_iterator_tag;
+
+    const_iterator() : node_(nullptr) {}
+
+    reference operator*() const { return node_->data(); }
+    pointer operator->() const { return &node_->data(); }
+
+    // Steps over nodes that were erased after this one was reached.
+    const_iterator &operator++() {
+      node_ = firstLive(nodeOf(node_->links()[0].load(
+          std::memory_order_acquire)));
+      if (node_ == nullptr) {
+        guard_.reset();
+      }
+      return *this;
+    }
+
+    const_iterator operator++(int) {
+      const_iterator temp = *this;
+      ++(*this);
+      return temp;
+    }
+
+    bool operator==(const const_iterator &rhs) const noexcept {
+      return node_ == rhs.node_;
+    }
+
+    bool operator!=(const const_iterator &rhs) const noexcept {
+      return node_ != rhs.node_;
+    }
+
+   private:
+    using guard_type = EpochReclamation::Guard;
+
+    const_iterator(Node *node, std::shared_ptr<guard_type> guard)
+        : node_(node), guard_(node ? std::move(guard) : nullptr) {}
+
+    Node *node_;
+    std::shared_ptr<guard_type> guard_;
+  };
+
+  using iterator = const_iterator;
+
+  explicit skiplist_map(const Compare &compare = Compare())
+      : compare_(compare), head_(createHead()), size_(0) {}
+
+  skiplist_map(const skiplist_map &) = delete;
+  skiplist_map &operator=(const skiplist_map &) = delete;
+
+  // Must not run concurrently with any other operation.
+  ~skiplist_map() {
+    Node *node = nodeOf(head_->links()[0].load(std::memory_order_acquire));
+    while (node) {
+      Node *next = nodeOf(node->links()[0].load(std::memory_order_relaxed));
+      destroyNode(node);
+      node = next;
+    }
+    deallocate(head_);
+  }
+
+  // Returns false, leaving the element alone, if key is already present.
+  bool insert(const key_type &key, const mapped_type &obj) {
+    return emplace(key, obj);
+  }
+
+  template <typename... Args>
+  bool emplace(const key_type &key, Args &&...args) {
+    EpochReclamation::Guard guard(EpochReclamation::instance());
+    Node *preds[kMaxLevel];
+    Node *succs[kMaxLevel];
+    Node *node = nullptr;
+    for (;;) {
+      if (search(key, preds, succs)) {
+        if (node) {
+          destroyNode(node);
+        }
+        return false;
+      }
+      if (node == nullptr) {
+        node = createNode(randomHeight(), key, std::forward<Args>(args)...);
+      }
+      for (int level = 0; level < node->height_; ++level) {
+        node->links()[level].store(link(succs[level]),
+                                   std::memory_order_relaxed);
+      }
+      uintptr_t expected = link(succs[0]);
+      if (preds[0]->links()[0].compare_exchange_strong(
+              expected, link(node), std::memory_order_release,
+              std::memory_order_relaxed)) {
+        break;
+      }
+    }
+    size_.fetch_add(1, std::memory_order_relaxed);
+    linkUpperLevels(node, preds, succs);
+    release(node);
+    return true;
+  }
+
+  size_type erase(const key_type &key) {
+    EpochReclamation::Guard guard(EpochReclamation::instance());
+    Node *preds[kMaxLevel];
+    Node *succs[kMaxLevel];
+    if (!search(key, preds, succs)) {
+      return 0;
+    }
+    Node *node = succs[0];
+    for (int level = node->height_ - 1; level > 0; --level) {
+      uintptr_t next = node->links()[level].load(std::memory_order_relaxed);
+      while (!marked(next) &&
+             !node->links()[level].compare_exchange_weak(
+                 next, next | kMark, std::memory_order_acq_rel,
+                 std::memory_order_relaxed)) {
+      }
+    }
+    uintptr_t next = node->links()[0].load(std::memory_order_relaxed);
+    for (;;) {
+      if (marked(next)) {
+        // Another thread erased it first.
+        return 0;
+      }
+      if (node->links()[0].compare_exchange_weak(next, next | kMark,
+                                                 std::memory_order_acq_rel,
+                                                 std::memory_order_relaxed)) {
+        break;
+      }
+    }
+    size_.fetch_sub(1, std::memory_order_relaxed);
+    search(key, preds, succs);
+    release(node);
+    return 1;
+  }
+
+  // A copy of the value; it cannot change once inserted, only be erased.
+  std::optional<mapped_type> find(const key_type &key) const {
+    EpochReclamation::Guard guard(EpochReclamation::instance());
+    Node *node = lowerBoundNode(key);
+    if (node && !compare_(key, node->key())) {
+      return node->data().second;
+    }
+    return std::nullopt;
+  }
+
+  bool contains(const key_type &key) const {
+    EpochReclamation::Guard guard(EpochReclamation::instance());
+    Node *node = lowerBoundNode(key);
+    return node && !compare_(key, node->key());
+  }
+
+  size_type count(const key_type &key) const { return contains(key) ? 1 : 0; }
+
+  const_iterator begin() const {
+    auto guard = pin();
+    return const_iterator(
+        firstLive(nodeOf(head_->links()[0].load(std::memory_order_acquire))),
+        std::move(guard));
+  }
+
+  const_iterator end() const noexcept { return const_iterator(); }
+
+  // The first element not less than key.
+  const_iterator lower_bound(const key_type &key) const {
+    auto guard = pin();
+    return const_iterator(lowerBoundNode(key), std::move(guard));
+  }
+
+  // Counted apart from the links, so only a snapshot under concurrency.
+  size_type size() const noexcept {
+    return size_.load(std::memory_order_relaxed);
+  }
+
+  bool empty() const noexcept { return size() == 0; }
+
+  Compare key_comp() const { return compare_; }
+
+ private:
+  static constexpr uintptr_t kMark = 1;
+
+  static bool marked(uintptr_t link) noexcept { return link & kMark; }
+
+  static Node *nodeOf(uintptr_t link) noexcept {
+    return reinterpret_cast<Node *>(link & ~kMark);
+  }
+
+  static uintptr_t link(Node *node) noexcept {
+    return reinterpret_cast<uintptr_t>(node);
+  }
+
+  static std::shared_ptr<EpochReclamation::Guard> pin() {
+    return std::make_shared<EpochReclamation::Guard>(
+        EpochReclamation::instance());
+  }
+
+  // node itself if it is not erased, otherwise the next one that is not.
+  static Node *firstLive(Node *node) noexcept {
+    while (node) {
+      uintptr_t next = node->links()[0].load(std::memory_order_acquire);
+      if (!marked(next)) {
+        return node;
+      }
+      node = nodeOf(next);
+    }
+    return nullptr;
+  }
+
+  // Fills preds and succs with the neighbours key would have on every
+  // level, unlinking each erased node met on the way, and reports whether
+  // succs[0] holds key. A failed unlink means the predecessor changed
+  // under us, so the search starts over.
+  bool search(const key_type &key, Node **preds, Node **succs) {
+  retry:
+    Node *pred = head_;
+    for (int level = kMaxLevel - 1; level >= 0; --level) {
+      Node *curr =
+          nodeOf(pred->links()[level].load(std::memory_order_acquire));
+      while (curr) {
+        uintptr_t next = curr->links()[level].load(std::memory_order_acquire);
+        if (marked(next)) {
+          uintptr_t expected = link(curr);
+          if (!pred->links()[level].compare_exchange_strong(
+                  expected, next & ~kMark, std::memory_order_acq_rel,
+                  std::memory_order_relaxed)) {
+            goto retry;
+          }
+          curr = nodeOf(next);
+        } else if (compare_(curr->key(), key)) {
+          pred = curr;
+          curr = nodeOf(next);
+        } else {
+          break;
+        }
+      }
+      preds[level] = pred;
+      succs[level] = curr;
+    }
+    return succs[0] && !compare_(key, succs[0]->key());
+  }
+
+  // Read-only search: erased nodes are stepped over, not unlinked.
+  Node *lowerBoundNode(const key_type &key) const {
+    Node *pred = head_;
+    Node *curr = nullptr;
+    for (int level = kMaxLevel - 1; level >= 0; --level) {
+      curr = nodeOf(pred->links()[level].load(std::memory_order_acquire));
+      while (curr) {
+        uintptr_t next = curr->links()[level].load(std::memory_order_acquire);
+        if (!marked(next) && !compare_(curr->key(), key)) {
+          break;
+        }
+        if (!marked(next)) {
+          pred = curr;
+        }
+        curr = nodeOf(next);
+      }
+    }
+    return curr;
+  }
+
+  // Links node into the levels above the bottom one. Stops early once the
+  // node is erased; anything linked by then is unlinked again by a last
+  // search, since the eraser's own search may have run before it.
+  void linkUpperLevels(Node *node, Node **preds, Node **succs) {
+    for (int level = 1; level < node->height_; ++level) {
+      for (;;) {
+        uintptr_t next = node->links()[level].load(std::memory_order_acquire);
+        if (marked(next)) {
+          search(node->key(), preds, succs);
+          return;
+        }
+        if (nodeOf(next) != succs[level] &&
+            !node->links()[level].compare_exchange_strong(
+                next, link(succs[level]), std::memory_order_acq_rel,
+                std::memory_order_relaxed)) {
+          continue;
+        }
+        uintptr_t expected = link(succs[level]);
+        if (preds[level]->links()[level].compare_exchange_strong(
+                expected, link(node), std::memory_order_release,
+                std::memory_order_relaxed)) {
+          break;
+        }
+        search(node->key(), preds, succs);
+      }
+    }
+    if (marked(node->links()[0].load(std::memory_order_acquire))) {
+      search(node->key(), preds, succs);
+    }
+  }
+
+  void release(Node *node) {
+    if (node->refs_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      EpochReclamation::instance().retire(node, &destroyNode);
+    }
+  }
+
+  // One in four nodes of a level reaches the next.
+  static int randomHeight() noexcept {
+    static std::atomic<uint64_t> seeds{0};
+    thread_local uint64_t state =
+        0x9E3779B97F4A7C15ull *
+        (seeds.fetch_add(1, std::memory_order_relaxed) + 1);
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    uint64_t bits = state;
+    int height = 1;
+    while (height < kMaxLevel && (bits & 3) == 0) {
+      ++height;
+      bits >>= 2;
+    }
+    return height;
+  }
+
+  static size_t blocksFor(int height) noexcept {
+    size_t bytes = kLinkOffset + sizeof(Link) * static_cast<size_t>(height);
+    return (bytes + sizeof(block_type) - 1) / sizeof(block_type);
+  }
+
+  static Node *allocate(int height) {
+    block_allocator blocks;
+    block_type *memory = std::allocator_traits<block_allocator>::allocate(
+        blocks, blocksFor(height));
+    Node *node = ::new (static_cast<void *>(memory)) Node(height);
+    for (int level = 0; level < height; ++level) {
+      ::new (static_cast<void *>(node->links() + level)) Link(0);
+    }
+    return node;
+  }
+
+  static void deallocate(Node *node) noexcept {
+    int height = node->height_;
+    node->~Node();
+    block_allocator blocks;
+    std::allocator_traits<block_allocator>::deallocate(
+        blocks, reinterpret_cast<block_type *>(node), blocksFor(height));
+  }
+
+  static Node *createHead() { return allocate(kMaxLevel); }
+
+  template <typename... Args>
+  static Node *createNode(int height, const key_type &key, Args &&...args) {
+    Node *node = allocate(height);
+    try {
+      Allocator allocator;
+      std::allocator_traits<Allocator>::construct(
+          allocator, &node->data(), std::piecewise_construct,
+          std::forward_as_tuple(key),
+          std::forward_as_tuple(std::forward<Args>(args)...));
+    } catch (...) {
+      deallocate(node);
+      throw;
+    }
+    return node;
+  }
+
+  static void destroyNode(void *ptr) {
+    Node *node = static_cast<Node *>(ptr);
+    Allocator allocator;
+    std::allocator_traits<Allocator>::destroy(allocator, &node->data());
+    deallocate(node);
+  }
+
+  Compare compare_;
+  Node *head_;
+  alignas(kCacheLineSize) std::atomic<size_t> size_;
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_MAP_SKIPLIST_MAP_H_
@@ -3,6 +3,7 @@
 
 #include <initializer_list>
 
+#include "../adt/node_handle.h"
 #include "../list/list.h"
 
 namespace s21 {
@@ -19,6 +20,29 @@ class multiset {
   using size_type = typename s21::list<Key>::size_type;
 
  public:
+  // A key extract()ed from a multiset, which insert() links back in
+  // without reallocating it.
+  class node_type
+      : public NodeHandle<ListNode<Key>,
+                          typename s21::list<Key>::allocator_type,
+                          typename s21::list<Key>::node_allocator> {
+    using Base = NodeHandle<ListNode<Key>,
+                            typename s21::list<Key>::allocator_type,
+                            typename s21::list<Key>::node_allocator>;
+
+   public:
+    using value_type = Key;
+
+    node_type() noexcept = default;
+
+    value_type &value() const { return this->node_->data_; }
+
+   private:
+    friend class multiset;
+
+    using Base::Base;
+  };
+
   multiset(const Allocator &alloc = Allocator()) : list_(alloc) {}
 
   multiset(std::initializer_list<value_type> const &items,
@@ -80,6 +104,37 @@ class multiset {
     list_.sort();
   }
 
+  // Takes the key out of the multiset without destroying it.
+  node_type extract(iterator pos) {
+    return node_type(list_.unlink_node(pos), list_.allocator_,
+                     list_.allocator_node_);
+  }
+
+  // Extracts the first key equal to key, or returns an empty handle.
+  node_type extract(const_reference key) {
+    if (empty()) {
+      return node_type();
+    }
+    iterator pos = find(key);
+    if (pos == end()) {
+      return node_type();
+    }
+    return extract(pos);
+  }
+
+  // Links the extracted node in after the keys not greater than its own,
+  // as insert(value) would place it; nothing is allocated or copied.
+  iterator insert(node_type &&handle) {
+    if (handle.empty()) {
+      return end();
+    }
+    // An emptied list has no begin() to search from.
+    iterator pos = empty() ? end() : upper_bound(handle.value());
+    ListNode<Key> *node = handle.release();
+    list_.link_node(pos, node);
+    return iterator(node);
+  }
+
   void swap(multiset &other) { list_.swap(other.list_); }
 
   void merge(multiset &other) {
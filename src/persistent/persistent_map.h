@@ -0,0 +1,199 @@
+#ifndef CPP2_S21_CONTAINERS_1_PERSISTENT_PERSISTENT_MAP_H_
+#define CPP2_S21_CONTAINERS_1_PERSISTENT_PERSISTENT_MAP_H_
+
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+#include "persistent_tree.h"
+
+namespace s21 {
+
+template <typename Key, typename T>
+struct PersistentMapKey {
+  static const Key &of(const std::pair<const Key, T> &item) noexcept {
+    return item.first;
+  }
+};
+
+// Immutable ordered map. Every update leaves this version untouched and
+// returns a new one that shares all but O(log n) nodes with it, so
+// copying a version to hand to readers is O(1) and old versions stay
+// valid for as long as anyone holds them.
+//
+// A transient batches updates: it is changed in place like s21::map,
+// copying each shared node only the first time the batch touches it, and
+// persistent() then hands out the result as a new version.
+template <class Key, class T, class Compare = std::less<Key>,
+          class Allocator = std::allocator<std::pair<const Key, T>>>
+class persistent_map
+    : public PersistentTree<Key, std::pair<const Key, T>,
+                            PersistentMapKey<Key, T>, Compare, Allocator> {
+  using Base = PersistentTree<Key, std::pair<const Key, T>,
+                              PersistentMapKey<Key, T>, Compare, Allocator>;
+
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using reference = const value_type &;
+  using const_reference = const value_type &;
+  using iterator = typename Base::iterator;
+  using const_iterator = typename Base::const_iterator;
+  using size_type = size_t;
+  using allocator_type = Allocator;
+
+  class transient_type;
+
+  explicit persistent_map(const Compare &compare = Compare(),
+                          const Allocator &alloc = Allocator())
+      : Base(compare, alloc) {}
+
+  persistent_map(std::initializer_list<value_type> const &items,
+                 const Compare &compare = Compare(),
+                 const Allocator &alloc = Allocator())
+      : Base(compare, alloc) {
+    uint64_t edit = Base::newEdit();
+    for (auto &item : items) {
+      this->emplaceKey(edit, item.first, item);
+    }
+  }
+
+  const mapped_type &at(const key_type &key) const {
+    auto node = this->findNode(key);
+    if (node == nullptr) {
+      throw std::out_of_range("Key not in map");
+    }
+    return node->value_.second;
+  }
+
+  // This version plus value, or this version itself if its key is taken.
+  [[nodiscard]] persistent_map insert(const value_type &value) const {
+    return try_emplace(value.first, value.second);
+  }
+
+  template <typename... Args>
+  [[nodiscard]] persistent_map try_emplace(const key_type &key,
+                                           Args &&...args) const {
+    persistent_map result(*this);
+    result.emplaceKey(Base::newEdit(), key, std::piecewise_construct,
+                      std::forward_as_tuple(key),
+                      std::forward_as_tuple(std::forward<Args>(args)...));
+    return result;
+  }
+
+  template <typename M>
+  [[nodiscard]] persistent_map insert_or_assign(const key_type &key,
+                                                M &&obj) const {
+    persistent_map result(*this);
+    result.assign(Base::newEdit(), key, std::forward<M>(obj));
+    return result;
+  }
+
+  // This version without key.
+  [[nodiscard]] persistent_map erase(const key_type &key) const {
+    persistent_map result(*this);
+    result.eraseKey(Base::newEdit(), key);
+    return result;
+  }
+
+  transient_type transient() const { return transient_type(*this); }
+
+ private:
+  explicit persistent_map(const Base &tree) : Base(tree) {}
+
+  template <typename M>
+  bool assign(uint64_t edit, const key_type &key, M &&obj) {
+    if (this->contains(key)) {
+      this->editValue(edit, key).second = std::forward<M>(obj);
+      return false;
+    }
+    return this->emplaceKey(edit, key, key, std::forward<M>(obj));
+  }
+};
+
+// A persistent_map being built up in place. Any update invalidates its
+// iterators; versions taken with persistent() are never affected.
+template <class Key, class T, class Compare, class Allocator>
+class persistent_map<Key, T, Compare, Allocator>::transient_type
+    : public persistent_map<Key, T, Compare, Allocator>::Base {
+  using map_type = persistent_map<Key, T, Compare, Allocator>;
+  using Base = typename map_type::Base;
+
+ public:
+  using value_type = typename map_type::value_type;
+  using size_type = typename map_type::size_type;
+
+  explicit transient_type(const map_type &from)
+      : Base(from), edit_(Base::newEdit()) {}
+
+  transient_type(const transient_type &) = delete;
+  transient_type &operator=(const transient_type &) = delete;
+  transient_type(transient_type &&) noexcept = default;
+  transient_type &operator=(transient_type &&) noexcept = default;
+
+  const T &at(const Key &key) const {
+    auto node = this->findNode(key);
+    if (node == nullptr) {
+      throw std::out_of_range("Key not in map");
+    }
+    return node->value_.second;
+  }
+
+  // The value of key, copied out of the shared version first if needed.
+  T &at(const Key &key) {
+    if (!this->contains(key)) {
+      throw std::out_of_range("Key not in map");
+    }
+    return this->editValue(edit_, key).second;
+  }
+
+  bool insert(const value_type &value) {
+    return this->emplaceKey(edit_, value.first, value);
+  }
+
+  template <typename... Args>
+  bool try_emplace(const Key &key, Args &&...args) {
+    return this->emplaceKey(edit_, key, std::piecewise_construct,
+                            std::forward_as_tuple(key),
+                            std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+
+  // Returns true if key was inserted, false if its value was replaced.
+  template <typename M>
+  bool insert_or_assign(const Key &key, M &&obj) {
+    if (this->contains(key)) {
+      this->editValue(edit_, key).second = std::forward<M>(obj);
+      return false;
+    }
+    return this->emplaceKey(edit_, key, key, std::forward<M>(obj));
+  }
+
+  size_type erase(const Key &key) {
+    if (!this->contains(key)) {
+      return 0;
+    }
+    this->ownErasePath(edit_, key);
+    this->eraseKey(edit_, key);
+    return 1;
+  }
+
+  // The content so far as a version of its own. The transient stays
+  // usable, but later updates copy the nodes that version now shares.
+  map_type persistent() {
+    map_type result(static_cast<const Base &>(*this));
+    edit_ = Base::newEdit();
+    return result;
+  }
+
+ private:
+  uint64_t edit_;
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_PERSISTENT_PERSISTENT_MAP_H_
@@ -0,0 +1,122 @@
+#ifndef CPP2_S21_CONTAINERS_1_PERSISTENT_PERSISTENT_SET_H_
+#define CPP2_S21_CONTAINERS_1_PERSISTENT_PERSISTENT_SET_H_
+
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <utility>
+
+#include "persistent_tree.h"
+
+namespace s21 {
+
+template <typename Key>
+struct PersistentSetKey {
+  static const Key &of(const Key &item) noexcept { return item; }
+};
+
+// The persistent_map counterpart for key sets: updates return new
+// versions sharing all but O(log n) nodes, and a transient batches them.
+template <class Key, class Compare = std::less<Key>,
+          class Allocator = std::allocator<Key>>
+class persistent_set
+    : public PersistentTree<Key, Key, PersistentSetKey<Key>, Compare,
+                            Allocator> {
+  using Base =
+      PersistentTree<Key, Key, PersistentSetKey<Key>, Compare, Allocator>;
+
+ public:
+  using key_type = Key;
+  using value_type = Key;
+  using reference = const value_type &;
+  using const_reference = const value_type &;
+  using iterator = typename Base::iterator;
+  using const_iterator = typename Base::const_iterator;
+  using size_type = size_t;
+  using allocator_type = Allocator;
+
+  class transient_type;
+
+  explicit persistent_set(const Compare &compare = Compare(),
+                          const Allocator &alloc = Allocator())
+      : Base(compare, alloc) {}
+
+  persistent_set(std::initializer_list<value_type> const &items,
+                 const Compare &compare = Compare(),
+                 const Allocator &alloc = Allocator())
+      : Base(compare, alloc) {
+    uint64_t edit = Base::newEdit();
+    for (auto &item : items) {
+      this->emplaceKey(edit, item, item);
+    }
+  }
+
+  // This version plus value, or this version itself if already present.
+  [[nodiscard]] persistent_set insert(const value_type &value) const {
+    persistent_set result(*this);
+    result.emplaceKey(Base::newEdit(), value, value);
+    return result;
+  }
+
+  // This version without key.
+  [[nodiscard]] persistent_set erase(const key_type &key) const {
+    persistent_set result(*this);
+    result.eraseKey(Base::newEdit(), key);
+    return result;
+  }
+
+  transient_type transient() const { return transient_type(*this); }
+
+ private:
+  explicit persistent_set(const Base &tree) : Base(tree) {}
+};
+
+// A persistent_set being built up in place. Any update invalidates its
+// iterators; versions taken with persistent() are never affected.
+template <class Key, class Compare, class Allocator>
+class persistent_set<Key, Compare, Allocator>::transient_type
+    : public persistent_set<Key, Compare, Allocator>::Base {
+  using set_type = persistent_set<Key, Compare, Allocator>;
+  using Base = typename set_type::Base;
+
+ public:
+  using value_type = typename set_type::value_type;
+  using size_type = typename set_type::size_type;
+
+  explicit transient_type(const set_type &from)
+      : Base(from), edit_(Base::newEdit()) {}
+
+  transient_type(const transient_type &) = delete;
+  transient_type &operator=(const transient_type &) = delete;
+  transient_type(transient_type &&) noexcept = default;
+  transient_type &operator=(transient_type &&) noexcept = default;
+
+  bool insert(const value_type &value) {
+    return this->emplaceKey(edit_, value, value);
+  }
+
+  size_type erase(const Key &key) {
+    if (!this->contains(key)) {
+      return 0;
+    }
+    this->ownErasePath(edit_, key);
+    this->eraseKey(edit_, key);
+    return 1;
+  }
+
+  // The content so far as a version of its own. The transient stays
+  // usable, but later updates copy the nodes that version now shares.
+  set_type persistent() {
+    set_type result(static_cast<const Base &>(*this));
+    edit_ = Base::newEdit();
+    return result;
+  }
+
+ private:
+  uint64_t edit_;
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_PERSISTENT_PERSISTENT_SET_H_
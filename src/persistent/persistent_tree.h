@@ -0,0 +1,468 @@
+#ifndef CPP2_S21_CONTAINERS_1_PERSISTENT_PERSISTENT_TREE_H_
+#define CPP2_S21_CONTAINERS_1_PERSISTENT_PERSISTENT_TREE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+namespace s21 {
+
+// AVL tree shared between versions. Nodes are immutable once another
+// version can see them and carry an atomic reference count, so copying a
+// version is O(1) and an update copies only the O(log n) nodes on its
+// path, linking them to the untouched subtrees of the old version.
+//
+// Every update runs under an edit id. A node is changed in place only if
+// it was created under the same id, which holds for nodes the update
+// copied itself and, in a transient, for everything the batch copied so
+// far; any other node is copied first. Versions may be copied, read and
+// destroyed from several threads at once; one version object is no more
+// thread-safe than a shared_ptr.
+//
+// KeyOf maps an element to its key through a static of().
+template <typename Key, typename Value, typename KeyOf, typename Compare,
+          typename Allocator>
+class PersistentTree {
+ protected:
+  struct Node {
+    template <typename... Args>
+    explicit Node(uint64_t edit, Args &&...args)
+        : value_(std::forward<Args>(args)...),
+          left_(nullptr),
+          right_(nullptr),
+          refs_(1),
+          edit_(edit),
+          height_(1) {}
+
+    Value value_;
+    Node *left_;
+    Node *right_;
+    std::atomic<size_t> refs_;
+    uint64_t edit_;
+    int height_;
+  };
+
+  using node_allocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<Node>;
+
+ public:
+  using key_type = Key;
+  using value_type = Value;
+  using reference = const value_type &;
+  using const_reference = const value_type &;
+  using size_type = size_t;
+  using allocator_type = Allocator;
+
+  // An AVL tree of this height holds about 2.7e13 nodes, more than memory
+  // can, so the iterator's stack of ancestors never overflows.
+  static constexpr int kMaxHeight = 64;
+
+  class const_iterator {
+    friend class PersistentTree;
+
+   public:
+    using value_type = PersistentTree::value_type;
+    using difference_type = ptrdiff_t;
+    using pointer = const value_type *;
+    using reference = const value_type &;
+    using iterator_category = std::forward_iterator_tag;
+
+    const_iterator() noexcept : depth_(0) {}
+
+    reference operator*() const { return path_[depth_ - 1]->value_; }
+    pointer operator->() const { return &path_[depth_ - 1]->value_; }
+
+    const_iterator &operator++() {
+      const Node *node = path_[--depth_];
+      pushLeftmost(node->right_);
+      return *this;
+    }
+
+    const_iterator operator++(int) {
+      const_iterator temp = *this;
+      ++(*this);
+      return temp;
+    }
+
+    bool operator==(const const_iterator &rhs) const noexcept {
+      return top() == rhs.top();
+    }
+
+    bool operator!=(const const_iterator &rhs) const noexcept {
+      return top() != rhs.top();
+    }
+
+   private:
+    // The stack holds the current node on top and, below it, the
+    // ancestors whose left subtree it lies in: the nodes still to visit.
+    const Node *top() const noexcept {
+      return depth_ ? path_[depth_ - 1] : nullptr;
+    }
+
+    void push(const Node *node) noexcept { path_[depth_++] = node; }
+
+    void pushLeftmost(const Node *node) noexcept {
+      for (; node; node = node->left_) {
+        push(node);
+      }
+    }
+
+    const Node *path_[kMaxHeight];
+    int depth_;
+  };
+
+  using iterator = const_iterator;
+
+  PersistentTree(const PersistentTree &other) noexcept
+      : root_(retain(other.root_)),
+        size_(other.size_),
+        compare_(other.compare_),
+        allocator_(other.allocator_) {}
+
+  PersistentTree(PersistentTree &&other) noexcept
+      : root_(other.root_),
+        size_(other.size_),
+        compare_(std::move(other.compare_)),
+        allocator_(std::move(other.allocator_)) {
+    other.root_ = nullptr;
+    other.size_ = 0;
+  }
+
+  PersistentTree &operator=(const PersistentTree &other) noexcept {
+    PersistentTree copy(other);
+    swap(copy);
+    return *this;
+  }
+
+  PersistentTree &operator=(PersistentTree &&other) noexcept {
+    PersistentTree copy(std::move(other));
+    swap(copy);
+    return *this;
+  }
+
+  ~PersistentTree() { release(root_); }
+
+  const_iterator begin() const noexcept {
+    const_iterator it;
+    it.pushLeftmost(root_);
+    return it;
+  }
+
+  const_iterator end() const noexcept { return const_iterator(); }
+
+  const_iterator lower_bound(const key_type &key) const noexcept {
+    const_iterator it;
+    for (const Node *node = root_; node;) {
+      if (compare_(KeyOf::of(node->value_), key)) {
+        node = node->right_;
+      } else {
+        it.push(node);
+        node = node->left_;
+      }
+    }
+    return it;
+  }
+
+  const_iterator find(const key_type &key) const noexcept {
+    const_iterator it = lower_bound(key);
+    if (it != end() && compare_(key, KeyOf::of(*it))) {
+      return end();
+    }
+    return it;
+  }
+
+  bool contains(const key_type &key) const noexcept {
+    return findNode(key) != nullptr;
+  }
+
+  size_type count(const key_type &key) const noexcept {
+    return contains(key) ? 1 : 0;
+  }
+
+  bool empty() const noexcept { return size_ == 0; }
+  size_type size() const noexcept { return size_; }
+
+  void swap(PersistentTree &other) noexcept {
+    std::swap(root_, other.root_);
+    std::swap(size_, other.size_);
+    std::swap(compare_, other.compare_);
+    std::swap(allocator_, other.allocator_);
+  }
+
+  // True if both versions share one root, so neither has been changed
+  // since one was copied from the other: a cheap "has it changed" test.
+  bool identical(const PersistentTree &other) const noexcept {
+    return root_ == other.root_;
+  }
+
+  Compare key_comp() const { return compare_; }
+
+ protected:
+  PersistentTree(const Compare &compare, const Allocator &alloc)
+      : root_(nullptr), size_(0), compare_(compare), allocator_(alloc) {}
+
+  // A fresh edit id; ids are never reused, so nodes made under one stay
+  // frozen for every later edit.
+  static uint64_t newEdit() noexcept {
+    static std::atomic<uint64_t> next{1};
+    return next.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  const Node *findNode(const key_type &key) const noexcept {
+    const Node *node = root_;
+    while (node) {
+      if (compare_(key, KeyOf::of(node->value_))) {
+        node = node->left_;
+      } else if (compare_(KeyOf::of(node->value_), key)) {
+        node = node->right_;
+      } else {
+        return node;
+      }
+    }
+    return nullptr;
+  }
+
+  // Inserts an element built from args unless key is present. Nodes are
+  // copied top-down before anything is relinked and rotations after an
+  // insertion only touch the copied path, so a throw leaves the content
+  // as it was.
+  template <typename... Args>
+  bool emplaceKey(uint64_t edit, const key_type &key, Args &&...args) {
+    if (contains(key)) {
+      return false;
+    }
+    insertAt(root_, edit, key, std::forward<Args>(args)...);
+    ++size_;
+    return true;
+  }
+
+  // The element with key, which must be present, after making its path
+  // editable under edit.
+  Value &editValue(uint64_t edit, const key_type &key) {
+    Node **slot = &root_;
+    for (;;) {
+      Node *node = editable(*slot, edit);
+      if (compare_(key, KeyOf::of(node->value_))) {
+        slot = &node->left_;
+      } else if (compare_(KeyOf::of(node->value_), key)) {
+        slot = &node->right_;
+      } else {
+        return node->value_;
+      }
+    }
+  }
+
+  bool eraseKey(uint64_t edit, const key_type &key) {
+    if (!contains(key)) {
+      return false;
+    }
+    eraseAt(root_, edit, key);
+    --size_;
+    return true;
+  }
+
+  // Rebalancing after an erasure rotates nodes off the path, which may
+  // have to be copied. A transient that must not be left half-changed
+  // when such a copy throws calls this first: it makes editable the path
+  // to key and to its successor and every node a rotation there can move.
+  void ownErasePath(uint64_t edit, const key_type &key) {
+    Node **slot = &root_;
+    bool to_successor = false;
+    while (*slot) {
+      Node *node = editable(*slot, edit);
+      bool left = true;
+      if (!to_successor && !compare_(key, KeyOf::of(node->value_))) {
+        to_successor = !compare_(KeyOf::of(node->value_), key);
+        left = false;
+      }
+      Node *&sibling = left ? node->right_ : node->left_;
+      if (sibling) {
+        Node *other = editable(sibling, edit);
+        if (other->left_) {
+          editable(other->left_, edit);
+        }
+        if (other->right_) {
+          editable(other->right_, edit);
+        }
+      }
+      slot = left ? &node->left_ : &node->right_;
+    }
+  }
+
+ private:
+  static Node *retain(Node *node) noexcept {
+    if (node) {
+      node->refs_.fetch_add(1, std::memory_order_relaxed);
+    }
+    return node;
+  }
+
+  void release(Node *node) noexcept {
+    if (node && node->refs_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      release(node->left_);
+      release(node->right_);
+      std::allocator_traits<node_allocator>::destroy(allocator_, node);
+      std::allocator_traits<node_allocator>::deallocate(allocator_, node, 1);
+    }
+  }
+
+  template <typename... Args>
+  Node *createNode(uint64_t edit, Args &&...args) {
+    Node *node = std::allocator_traits<node_allocator>::allocate(allocator_, 1);
+    try {
+      std::allocator_traits<node_allocator>::construct(
+          allocator_, node, edit, std::forward<Args>(args)...);
+    } catch (...) {
+      std::allocator_traits<node_allocator>::deallocate(allocator_, node, 1);
+      throw;
+    }
+    return node;
+  }
+
+  // The node in slot, replaced by a copy sharing its children unless it
+  // was made under edit.
+  Node *editable(Node *&slot, uint64_t edit) {
+    if (slot->edit_ != edit) {
+      Node *copy = createNode(edit, slot->value_);
+      copy->left_ = retain(slot->left_);
+      copy->right_ = retain(slot->right_);
+      copy->height_ = slot->height_;
+      release(slot);
+      slot = copy;
+    }
+    return slot;
+  }
+
+  static int height(const Node *node) noexcept {
+    return node ? node->height_ : 0;
+  }
+
+  static void updateHeight(Node *node) noexcept {
+    int left = height(node->left_);
+    int right = height(node->right_);
+    node->height_ = (left > right ? left : right) + 1;
+  }
+
+  // The node in slot and the child rising in its place must be editable.
+  static void rotateLeft(Node *&slot) noexcept {
+    Node *node = slot;
+    Node *right = node->right_;
+    node->right_ = right->left_;
+    right->left_ = node;
+    updateHeight(node);
+    updateHeight(right);
+    slot = right;
+  }
+
+  static void rotateRight(Node *&slot) noexcept {
+    Node *node = slot;
+    Node *left = node->left_;
+    node->left_ = left->right_;
+    left->right_ = node;
+    updateHeight(node);
+    updateHeight(left);
+    slot = left;
+  }
+
+  // Restores the AVL invariant at the editable node in slot. Everything a
+  // rotation moves is made editable before any link changes.
+  void rebalance(Node *&slot, uint64_t edit) {
+    Node *node = slot;
+    int balance = height(node->left_) - height(node->right_);
+    if (balance > 1) {
+      Node *left = editable(node->left_, edit);
+      bool twice = height(left->left_) < height(left->right_);
+      if (twice) {
+        editable(left->right_, edit);
+        rotateLeft(node->left_);
+      }
+      rotateRight(slot);
+    } else if (balance < -1) {
+      Node *right = editable(node->right_, edit);
+      bool twice = height(right->right_) < height(right->left_);
+      if (twice) {
+        editable(right->left_, edit);
+        rotateRight(node->right_);
+      }
+      rotateLeft(slot);
+    } else {
+      updateHeight(node);
+    }
+  }
+
+  template <typename... Args>
+  void insertAt(Node *&slot, uint64_t edit, const key_type &key,
+                Args &&...args) {
+    if (slot == nullptr) {
+      slot = createNode(edit, std::forward<Args>(args)...);
+      return;
+    }
+    Node *node = editable(slot, edit);
+    if (compare_(key, KeyOf::of(node->value_))) {
+      insertAt(node->left_, edit, key, std::forward<Args>(args)...);
+    } else {
+      insertAt(node->right_, edit, key, std::forward<Args>(args)...);
+    }
+    rebalance(slot, edit);
+  }
+
+  // Unlinks the smallest node of the subtree in slot and returns it,
+  // editable and with no children.
+  Node *detachMin(Node *&slot, uint64_t edit) {
+    Node *node = editable(slot, edit);
+    if (node->left_ == nullptr) {
+      slot = node->right_;
+      node->right_ = nullptr;
+      return node;
+    }
+    Node *min = detachMin(node->left_, edit);
+    try {
+      rebalance(slot, edit);
+    } catch (...) {
+      release(min);
+      throw;
+    }
+    return min;
+  }
+
+  // The erased node itself is never copied: its place is taken by one of
+  // its children or by its successor, which keep their own references.
+  void eraseAt(Node *&slot, uint64_t edit, const key_type &key) {
+    Node *node = slot;
+    if (compare_(key, KeyOf::of(node->value_))) {
+      eraseAt(editable(slot, edit)->left_, edit, key);
+    } else if (compare_(KeyOf::of(node->value_), key)) {
+      eraseAt(editable(slot, edit)->right_, edit, key);
+    } else if (node->left_ == nullptr || node->right_ == nullptr) {
+      slot = retain(node->left_ ? node->left_ : node->right_);
+      release(node);
+      return;
+    } else {
+      Node *right = retain(node->right_);
+      Node *successor;
+      try {
+        successor = detachMin(right, edit);
+      } catch (...) {
+        release(right);
+        throw;
+      }
+      successor->left_ = retain(node->left_);
+      successor->right_ = right;
+      slot = successor;
+      release(node);
+    }
+    rebalance(slot, edit);
+  }
+
+  Node *root_;
+  size_type size_;
+  Compare compare_;
+  node_allocator allocator_;
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_PERSISTENT_PERSISTENT_TREE_H_
@@ -0,0 +1,196 @@
+#ifndef CPP2_S21_CONTAINERS_1_PRIORITY_QUEUE_INDEXED_PRIORITY_QUEUE_H_
+#define CPP2_S21_CONTAINERS_1_PRIORITY_QUEUE_INDEXED_PRIORITY_QUEUE_H_
+
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+#include "../vector/vector.h"
+
+namespace s21 {
+
+// d-ary heap of handles. push() returns a handle that stays valid until the
+// element leaves the queue; the handle -> heap position table lets
+// decrease_key, update and erase find the element in O(1) and restore the
+// heap in O(log n) without any search or allocation. Handles of popped or
+// erased elements are recycled by later pushes; the element itself is
+// destroyed as soon as it leaves the queue.
+template <typename T, typename Compare = std::less<T>, size_t Arity = 4>
+class indexed_priority_queue {
+  static_assert(Arity >= 2, "heap arity must be at least 2");
+
+ public:
+  using value_type = T;
+  using value_compare = Compare;
+  using reference = T &;
+  using const_reference = const T &;
+  using size_type = size_t;
+  using handle_type = size_t;
+
+  indexed_priority_queue() : comparator_() {}
+
+  explicit indexed_priority_queue(const Compare &compare)
+      : comparator_(compare) {}
+
+  const_reference top() const { return valueOf(heap_[0]); }
+
+  handle_type top_handle() const { return heap_[0]; }
+
+  bool empty() const noexcept { return heap_.empty(); }
+
+  size_type size() const noexcept { return heap_.size(); }
+
+  bool contains(handle_type handle) const noexcept {
+    return handle < position_.size() && position_[handle] != kNotInHeap;
+  }
+
+  const_reference get(handle_type handle) const {
+    checkHandle(handle);
+    return valueOf(handle);
+  }
+
+  handle_type push(const_reference value) { return emplace(value); }
+
+  handle_type push(value_type &&value) { return emplace(std::move(value)); }
+
+  template <typename... Args>
+  handle_type emplace(Args &&...args) {
+    handle_type handle = 0;
+    if (free_.empty()) {
+      handle = values_.size();
+      values_.emplace_back(std::in_place, std::forward<Args>(args)...);
+      position_.push_back(kNotInHeap);
+    } else {
+      handle = free_[free_.size() - 1];
+      values_[handle].emplace(std::forward<Args>(args)...);
+      free_.pop_back();
+    }
+    position_[handle] = heap_.size();
+    heap_.push_back(handle);
+    siftUp(heap_.size() - 1);
+    return handle;
+  }
+
+  void pop() { erase(heap_[0]); }
+
+  // The new value must not rank below the old one (for a min-heap built with
+  // std::greater this is the classic decrease-key), so it only sifts up.
+  void decrease_key(handle_type handle, const_reference value) {
+    checkHandle(handle);
+    if (comparator_(value, valueOf(handle))) {
+      throw std::invalid_argument("decrease_key would lower the priority");
+    }
+    *values_[handle] = value;
+    siftUp(position_[handle]);
+  }
+
+  // Replaces the value and moves it in whichever direction is needed.
+  void update(handle_type handle, const_reference value) {
+    checkHandle(handle);
+    bool raised = comparator_(valueOf(handle), value);
+    *values_[handle] = value;
+    if (raised) {
+      siftUp(position_[handle]);
+    } else {
+      siftDown(position_[handle]);
+    }
+  }
+
+  void erase(handle_type handle) {
+    checkHandle(handle);
+    size_type index = position_[handle];
+    size_type last = heap_.size() - 1;
+    position_[handle] = kNotInHeap;
+    free_.push_back(handle);
+    if (index != last) {
+      place(index, heap_[last]);
+      heap_.pop_back();
+      if (index > 0 && comparator_(valueOf(heap_[(index - 1) / Arity]),
+                                   valueOf(heap_[index]))) {
+        siftUp(index);
+      } else {
+        siftDown(index);
+      }
+    } else {
+      heap_.pop_back();
+    }
+    values_[handle].reset();
+  }
+
+  void clear() {
+    for (size_type i = 0; i < heap_.size(); ++i) {
+      position_[heap_[i]] = kNotInHeap;
+      values_[heap_[i]].reset();
+      free_.push_back(heap_[i]);
+    }
+    heap_.clear();
+  }
+
+ private:
+  static constexpr size_type kNotInHeap = std::numeric_limits<size_type>::max();
+
+  void checkHandle(handle_type handle) const {
+    if (!contains(handle)) {
+      throw std::out_of_range("handle is not in the queue");
+    }
+  }
+
+  const_reference valueOf(handle_type handle) const { return *values_[handle]; }
+
+  void place(size_type index, handle_type handle) {
+    heap_[index] = handle;
+    position_[handle] = index;
+  }
+
+  void siftUp(size_type index) {
+    handle_type handle = heap_[index];
+    while (index > 0) {
+      size_type parent = (index - 1) / Arity;
+      if (!comparator_(valueOf(heap_[parent]), valueOf(handle))) {
+        break;
+      }
+      place(index, heap_[parent]);
+      index = parent;
+    }
+    place(index, handle);
+  }
+
+  void siftDown(size_type index) {
+    size_type size = heap_.size();
+    handle_type handle = heap_[index];
+    for (;;) {
+      size_type first = index * Arity + 1;
+      if (first >= size) {
+        break;
+      }
+      size_type last = first + Arity < size ? first + Arity : size;
+      size_type best = first;
+      for (size_type child = first + 1; child < last; ++child) {
+        if (comparator_(valueOf(heap_[best]), valueOf(heap_[child]))) {
+          best = child;
+        }
+      }
+      if (!comparator_(valueOf(handle), valueOf(heap_[best]))) {
+        break;
+      }
+      place(index, heap_[best]);
+      index = best;
+    }
+    place(index, handle);
+  }
+
+ private:
+  // Slots of free handles are empty.
+  s21::vector<std::optional<value_type>> values_;
+  s21::vector<size_type> position_;
+  s21::vector<handle_type> heap_;
+  s21::vector<handle_type> free_;
+  Compare comparator_;
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_PRIORITY_QUEUE_INDEXED_PRIORITY_QUEUE_H_
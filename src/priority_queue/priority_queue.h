@@ -0,0 +1,164 @@
+#ifndef CPP2_S21_CONTAINERS_1_PRIORITY_QUEUE_PRIORITY_QUEUE_H_
+#define CPP2_S21_CONTAINERS_1_PRIORITY_QUEUE_PRIORITY_QUEUE_H_
+
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <utility>
+
+#include "../vector/vector.h"
+
+namespace s21 {
+
+// Implicit d-ary heap on top of a random-access Container. A wider node
+// makes the tree shallower, so push (sift up) does fewer moves and each pop
+// (sift down) scans Arity contiguous children instead of chasing two.
+// As with std::priority_queue, top() is the largest element by Compare.
+template <typename T, typename Container = s21::vector<T>,
+          typename Compare = std::less<typename Container::value_type>,
+          size_t Arity = 4>
+class priority_queue {
+  static_assert(Arity >= 2, "heap arity must be at least 2");
+
+ public:
+  using container_type = Container;
+  using value_compare = Compare;
+  using value_type = typename Container::value_type;
+  using reference = typename Container::reference;
+  using const_reference = typename Container::const_reference;
+  using size_type = typename Container::size_type;
+
+  priority_queue() : heap_(), comparator_() {}
+
+  explicit priority_queue(const Compare &compare)
+      : heap_(), comparator_(compare) {}
+
+  priority_queue(std::initializer_list<value_type> const &items,
+                 const Compare &compare = Compare())
+      : heap_(), comparator_(compare) {
+    for (auto &item : items) {
+      heap_.push_back(item);
+    }
+    makeHeap();
+  }
+
+  priority_queue(const priority_queue &other)
+      : heap_(other.heap_), comparator_(other.comparator_) {}
+
+  priority_queue(priority_queue &&other) noexcept
+      : heap_(std::move(other.heap_)),
+        comparator_(std::move(other.comparator_)) {}
+
+  priority_queue &operator=(const priority_queue &other) {
+    heap_ = other.heap_;
+    comparator_ = other.comparator_;
+    return *this;
+  }
+
+  priority_queue &operator=(priority_queue &&other) {
+    heap_ = std::move(other.heap_);
+    comparator_ = std::move(other.comparator_);
+    return *this;
+  }
+
+  const_reference top() const { return heap_[0]; }
+
+  bool empty() const noexcept { return heap_.empty(); }
+
+  size_type size() const noexcept { return heap_.size(); }
+
+  void push(const_reference value) {
+    heap_.push_back(value);
+    siftUp(heap_.size() - 1);
+  }
+
+  void push(value_type &&value) {
+    heap_.push_back(std::move(value));
+    siftUp(heap_.size() - 1);
+  }
+
+  template <typename... Args>
+  void emplace(Args &&...args) {
+    heap_.emplace_back(std::forward<Args>(args)...);
+    siftUp(heap_.size() - 1);
+  }
+
+  void pop() {
+    if (heap_.size() > 1) {
+      heap_[0] = std::move(heap_[heap_.size() - 1]);
+      heap_.pop_back();
+      siftDown(0);
+    } else {
+      heap_.pop_back();
+    }
+  }
+
+  void swap(priority_queue &other) {
+    heap_.swap(other.heap_);
+    std::swap(comparator_, other.comparator_);
+  }
+
+  template <typename... Args>
+  void insert_many(Args &&...args) {
+    (push(std::forward<Args>(args)), ...);
+  }
+
+ private:
+  // Floyd's bottom-up construction: O(n) instead of n pushes.
+  void makeHeap() {
+    size_type size = heap_.size();
+    if (size < 2) {
+      return;
+    }
+    for (size_type index = (size - 2) / Arity + 1; index > 0; --index) {
+      siftDown(index - 1);
+    }
+  }
+
+  // Both sifts carry the moving element in a local and shift the others
+  // into the hole, so every level costs one move instead of a swap.
+  void siftUp(size_type index) {
+    value_type value = std::move(heap_[index]);
+    while (index > 0) {
+      size_type parent = (index - 1) / Arity;
+      if (!comparator_(heap_[parent], value)) {
+        break;
+      }
+      heap_[index] = std::move(heap_[parent]);
+      index = parent;
+    }
+    heap_[index] = std::move(value);
+  }
+
+  void siftDown(size_type index) {
+    size_type size = heap_.size();
+    value_type value = std::move(heap_[index]);
+    for (;;) {
+      size_type first = index * Arity + 1;
+      if (first >= size) {
+        break;
+      }
+      size_type last = first + Arity < size ? first + Arity : size;
+      size_type best = first;
+      for (size_type child = first + 1; child < last; ++child) {
+        if (comparator_(heap_[best], heap_[child])) {
+          best = child;
+        }
+      }
+      if (!comparator_(value, heap_[best])) {
+        break;
+      }
+      heap_[index] = std::move(heap_[best]);
+      index = best;
+    }
+    heap_[index] = std::move(value);
+  }
+
+ private:
+  container_type heap_;
+  Compare comparator_;
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_PRIORITY_QUEUE_PRIORITY_QUEUE_H_
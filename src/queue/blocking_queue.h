@@ -0,0 +1,260 @@
+#ifndef CPP2_S21_CONTAINERS_1_QUEUE_BLOCKING_QUEUE_H_
+#define CPP2_S21_CONTAINERS_1_QUEUE_BLOCKING_QUEUE_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <utility>
+
+#include "../adt/ring_buffer.h"
+#include "../../utils/allocator.h"
+
+namespace s21 {
+
+// Bounded thread-safe queue for pipeline stages. Producers block while the
+// ring is full (backpressure), consumers block while it is empty; both park
+// on condition variables and are only signalled when someone is waiting.
+// The bulk operations move a whole batch under one lock acquisition.
+//
+// close() stops further pushes and wakes every waiter. Consumers keep
+// draining whatever is left and get false / 0 once the queue is both closed
+// and empty.
+template <typename T, typename Allocator = Allocator<T>>
+class blocking_queue {
+ public:
+  using value_type = T;
+  using reference = T &;
+  using const_reference = const T &;
+  using size_type = size_t;
+  using allocator_type = Allocator;
+
+  explicit blocking_queue(size_type capacity,
+                          const Allocator &alloc = Allocator())
+      : buffer_(capacity, alloc),
+        closed_(false),
+        waiting_producers_(0),
+        waiting_consumers_(0) {}
+
+  blocking_queue(const blocking_queue &) = delete;
+  blocking_queue &operator=(const blocking_queue &) = delete;
+
+  bool push(const_reference value) { return emplace(value); }
+
+  bool push(value_type &&value) { return emplace(std::move(value)); }
+
+  // Blocks while the queue is full. Returns false if it was closed.
+  template <typename... Args>
+  bool emplace(Args &&...args) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    waitWhile(lock, not_full_, waiting_producers_,
+              [this] { return buffer_.full() && !closed_; });
+    if (closed_) {
+      return false;
+    }
+    buffer_.emplace_back(std::forward<Args>(args)...);
+    wakeConsumers(lock, 1);
+    return true;
+  }
+
+  template <typename... Args>
+  bool try_emplace(Args &&...args) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (closed_ || buffer_.full()) {
+      return false;
+    }
+    buffer_.emplace_back(std::forward<Args>(args)...);
+    wakeConsumers(lock, 1);
+    return true;
+  }
+
+  bool try_push(const_reference value) { return try_emplace(value); }
+
+  bool try_push(value_type &&value) { return try_emplace(std::move(value)); }
+
+  // Pushes [first, last), blocking whenever the ring fills up. Each wakeup
+  // copies as many items as fit. Returns how many were pushed before the
+  // queue was closed. If copying an item throws, the items before it stay
+  // queued and consumers are woken for them before the exception passes on.
+  template <typename InputIt>
+  size_type push_bulk(InputIt first, InputIt last) {
+    size_type pushed = 0;
+    std::unique_lock<std::mutex> lock(mutex_, std::defer_lock);
+    while (first != last) {
+      lock.lock();
+      waitWhile(lock, not_full_, waiting_producers_,
+                [this] { return buffer_.full() && !closed_; });
+      if (closed_) {
+        return pushed;
+      }
+      size_type batch = 0;
+      try {
+        for (; first != last && !buffer_.full(); ++first, ++batch) {
+          buffer_.emplace_back(*first);
+        }
+      } catch (...) {
+        wakeConsumers(lock, batch);
+        throw;
+      }
+      pushed += batch;
+      wakeConsumers(lock, batch);
+    }
+    return pushed;
+  }
+
+  // Blocks until an item is available. Returns false once the queue is
+  // closed and drained.
+  bool pop(reference value) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    waitWhile(lock, not_empty_, waiting_consumers_,
+              [this] { return buffer_.empty() && !closed_; });
+    return takeOne(lock, value);
+  }
+
+  bool try_pop(reference value) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return takeOne(lock, value);
+  }
+
+  // Like pop(), but gives up after timeout.
+  template <typename Rep, typename Period>
+  bool pop_for(reference value,
+               const std::chrono::duration<Rep, Period> &timeout) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    waitWhileFor(lock, not_empty_, waiting_consumers_, timeout,
+                 [this] { return buffer_.empty() && !closed_; });
+    return takeOne(lock, value);
+  }
+
+  // Blocks until at least one item is available, then moves up to max_n
+  // items into out. Returns the number moved; 0 means closed and drained.
+  template <typename OutputIt>
+  size_type pop_bulk(OutputIt out, size_type max_n) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    waitWhile(lock, not_empty_, waiting_consumers_,
+              [this] { return buffer_.empty() && !closed_; });
+    return takeMany(lock, out, max_n);
+  }
+
+  // Like pop_bulk(), but returns 0 if nothing arrives within timeout.
+  template <typename OutputIt, typename Rep, typename Period>
+  size_type pop_bulk_for(OutputIt out, size_type max_n,
+                         const std::chrono::duration<Rep, Period> &timeout) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    waitWhileFor(lock, not_empty_, waiting_consumers_, timeout,
+                 [this] { return buffer_.empty() && !closed_; });
+    return takeMany(lock, out, max_n);
+  }
+
+  void close() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      closed_ = true;
+    }
+    not_full_.notify_all();
+    not_empty_.notify_all();
+  }
+
+  bool is_closed() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return closed_;
+  }
+
+  size_type size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return buffer_.size();
+  }
+
+  bool empty() const { return size() == 0; }
+
+  size_type capacity() const noexcept { return buffer_.capacity(); }
+
+ private:
+  template <typename Predicate>
+  void waitWhile(std::unique_lock<std::mutex> &lock,
+                 std::condition_variable &cv, size_type &waiting,
+                 Predicate predicate) {
+    while (predicate()) {
+      ++waiting;
+      cv.wait(lock);
+      --waiting;
+    }
+  }
+
+  template <typename Rep, typename Period, typename Predicate>
+  void waitWhileFor(std::unique_lock<std::mutex> &lock,
+                    std::condition_variable &cv, size_type &waiting,
+                    const std::chrono::duration<Rep, Period> &timeout,
+                    Predicate predicate) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (predicate()) {
+      ++waiting;
+      std::cv_status status = cv.wait_until(lock, deadline);
+      --waiting;
+      if (status == std::cv_status::timeout) {
+        break;
+      }
+    }
+  }
+
+  bool takeOne(std::unique_lock<std::mutex> &lock, reference value) {
+    if (buffer_.empty()) {
+      return false;
+    }
+    value = std::move(buffer_.front());
+    buffer_.pop_front();
+    wakeProducers(lock, 1);
+    return true;
+  }
+
+  template <typename OutputIt>
+  size_type takeMany(std::unique_lock<std::mutex> &lock, OutputIt out,
+                     size_type max_n) {
+    size_type count = 0;
+    for (; count < max_n && !buffer_.empty(); ++count, ++out) {
+      *out = std::move(buffer_.front());
+      buffer_.pop_front();
+    }
+    wakeProducers(lock, count);
+    return count;
+  }
+
+  // Signals after unlocking so the woken thread does not immediately block
+  // on the mutex we still hold.
+  void wakeConsumers(std::unique_lock<std::mutex> &lock, size_type items) {
+    size_type waiting = waiting_consumers_;
+    lock.unlock();
+    notifyWaiters(not_empty_, waiting, items);
+  }
+
+  void wakeProducers(std::unique_lock<std::mutex> &lock, size_type slots) {
+    size_type waiting = waiting_producers_;
+    lock.unlock();
+    notifyWaiters(not_full_, waiting, slots);
+  }
+
+  void notifyWaiters(std::condition_variable &cv, size_type waiting,
+                     size_type count) {
+    if (waiting == 0 || count == 0) {
+      return;
+    }
+    if (count == 1) {
+      cv.notify_one();
+    } else {
+      cv.notify_all();
+    }
+  }
+
+ private:
+  RingBuffer<T, Allocator> buffer_;
+  bool closed_;
+  size_type waiting_producers_;
+  size_type waiting_consumers_;
+  mutable std::mutex mutex_;
+  std::condition_variable not_full_;
+  std::condition_variable not_empty_;
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_QUEUE_BLOCKING_QUEUE_H_
@@ -0,0 +1,259 @@
+#ifndef CPP2_S21_CONTAINERS_1_QUEUE_MPMC_QUEUE_H_
+#define CPP2_S21_CONTAINERS_1_QUEUE_MPMC_QUEUE_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include "../../utils/allocator.h"
+#include "../../utils/cache_line.h"
+
+namespace s21 {
+
+// Bounded lock-free queue for any number of producers and consumers
+// (D. Vyukov's array queue). Every cell carries a sequence number: a cell
+// at index pos is free for the producer that claims ticket pos when
+// sequence == pos, and holds data for the consumer with ticket pos when
+// sequence == pos + 1. Producers and consumers only contend on their own
+// ticket counter, never on each other.
+template <typename T, typename Allocator = Allocator<T>>
+class mpmc_queue {
+  static_assert(std::is_nothrow_move_constructible_v<T>,
+                "mpmc_queue payload must be nothrow move constructible");
+
+  struct Cell {
+    explicit Cell(size_t sequence) : sequence_(sequence) {}
+
+    T *data() { return reinterpret_cast<T *>(storage_); }
+
+    std::atomic<size_t> sequence_;
+    alignas(T) unsigned char storage_[sizeof(T)];
+  };
+
+ public:
+  using value_type = T;
+  using reference = T &;
+  using const_reference = const T &;
+  using size_type = size_t;
+  using allocator_type = Allocator;
+  using cell_allocator = typename std::allocator_traits<
+      allocator_type>::template rebind_alloc<Cell>;
+
+  explicit mpmc_queue(size_type capacity, const Allocator &alloc = Allocator())
+      : allocator_(
+            std::allocator_traits<
+                allocator_type>::select_on_container_copy_construction(alloc)),
+        allocator_cell_(),
+        capacity_(roundUpToPowerOfTwo(capacity)),
+        mask_(capacity_ - 1),
+        cells_(std::allocator_traits<cell_allocator>::allocate(allocator_cell_,
+                                                               capacity_)),
+        enqueue_pos_(0),
+        dequeue_pos_(0),
+        waiting_producers_(0),
+        waiting_consumers_(0) {
+    for (size_type i = 0; i < capacity_; ++i) {
+      std::allocator_traits<cell_allocator>::construct(allocator_cell_,
+                                                       cells_ + i, i);
+    }
+  }
+
+  mpmc_queue(const mpmc_queue &) = delete;
+  mpmc_queue &operator=(const mpmc_queue &) = delete;
+
+  ~mpmc_queue() {
+    size_type end = enqueue_pos_.load(std::memory_order_relaxed);
+    for (size_type pos = dequeue_pos_.load(std::memory_order_relaxed);
+         pos != end; ++pos) {
+      Cell &cell = cells_[pos & mask_];
+      if (cell.sequence_.load(std::memory_order_relaxed) == pos + 1) {
+        std::allocator_traits<allocator_type>::destroy(allocator_,
+                                                       cell.data());
+      }
+    }
+    for (size_type i = 0; i < capacity_; ++i) {
+      std::allocator_traits<cell_allocator>::destroy(allocator_cell_,
+                                                     cells_ + i);
+    }
+    std::allocator_traits<cell_allocator>::deallocate(allocator_cell_, cells_,
+                                                      capacity_);
+  }
+
+  bool try_push(const_reference value) { return try_emplace(value); }
+
+  bool try_push(value_type &&value) { return try_emplace(std::move(value)); }
+
+  template <typename... Args>
+  bool try_emplace(Args &&...args) {
+    if (!enqueue(std::forward<Args>(args)...)) {
+      return false;
+    }
+    notify(waiting_consumers_, not_empty_);
+    return true;
+  }
+
+  bool try_pop(reference value) {
+    if (!dequeue(value)) {
+      return false;
+    }
+    notify(waiting_producers_, not_full_);
+    return true;
+  }
+
+  // Blocking variants: retry kSpinCount times, then sleep on a condition
+  // variable until the other side makes progress. The lock-free paths only
+  // touch the mutex when someone is actually parked.
+
+  void push(const_reference value) {
+    waitFor(waiting_producers_, not_full_, [&] { return enqueue(value); });
+    notify(waiting_consumers_, not_empty_);
+  }
+
+  void push(value_type &&value) {
+    waitFor(waiting_producers_, not_full_,
+            [&] { return enqueue(std::move(value)); });
+    notify(waiting_consumers_, not_empty_);
+  }
+
+  void pop(reference value) {
+    waitFor(waiting_consumers_, not_empty_, [&] { return dequeue(value); });
+    notify(waiting_producers_, not_full_);
+  }
+
+  // A snapshot; exact only while no other thread is using the queue.
+  size_type size() const noexcept {
+    size_type head = dequeue_pos_.load(std::memory_order_acquire);
+    size_type tail = enqueue_pos_.load(std::memory_order_acquire);
+    return tail > head ? tail - head : 0;
+  }
+
+  bool empty() const noexcept { return size() == 0; }
+
+  size_type capacity() const noexcept { return capacity_; }
+
+ private:
+  static constexpr int kSpinCount = 64;
+
+  static size_type roundUpToPowerOfTwo(size_type value) {
+    if (value == 0) {
+      throw std::invalid_argument("mpmc_queue capacity must be positive");
+    }
+    size_type power = 2;
+    while (power < value) {
+      power *= 2;
+    }
+    return power;
+  }
+
+  template <typename... Args>
+  bool enqueue(Args &&...args) {
+    if constexpr (!std::is_nothrow_constructible_v<T, Args &&...>) {
+      // A ticket cannot be given back once claimed, so anything that may
+      // throw is built before claiming one and then moved in.
+      return enqueue(T(std::forward<Args>(args)...));
+    } else {
+      size_type pos = enqueue_pos_.load(std::memory_order_relaxed);
+      Cell *cell = nullptr;
+      for (;;) {
+        cell = &cells_[pos & mask_];
+        size_type sequence = cell->sequence_.load(std::memory_order_acquire);
+        std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(sequence) -
+                              static_cast<std::ptrdiff_t>(pos);
+        if (diff == 0) {
+          if (enqueue_pos_.compare_exchange_weak(pos, pos + 1,
+                                                 std::memory_order_relaxed)) {
+            break;
+          }
+        } else if (diff < 0) {
+          return false;
+        } else {
+          pos = enqueue_pos_.load(std::memory_order_relaxed);
+        }
+      }
+      std::allocator_traits<allocator_type>::construct(
+          allocator_, cell->data(), std::forward<Args>(args)...);
+      cell->sequence_.store(pos + 1, std::memory_order_release);
+      return true;
+    }
+  }
+
+  bool dequeue(reference value) {
+    size_type pos = dequeue_pos_.load(std::memory_order_relaxed);
+    Cell *cell = nullptr;
+    for (;;) {
+      cell = &cells_[pos & mask_];
+      size_type sequence = cell->sequence_.load(std::memory_order_acquire);
+      std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(sequence) -
+                            static_cast<std::ptrdiff_t>(pos + 1);
+      if (diff == 0) {
+        if (dequeue_pos_.compare_exchange_weak(pos, pos + 1,
+                                               std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = dequeue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+    value = std::move(*cell->data());
+    std::allocator_traits<allocator_type>::destroy(allocator_, cell->data());
+    cell->sequence_.store(pos + mask_ + 1, std::memory_order_release);
+    return true;
+  }
+
+  template <typename TryOperation>
+  void waitFor(std::atomic<size_type> &waiting, std::condition_variable &cv,
+               TryOperation try_operation) {
+    for (int spin = 0; spin < kSpinCount; ++spin) {
+      if (try_operation()) {
+        return;
+      }
+      std::this_thread::yield();
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    waiting.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    while (!try_operation()) {
+      cv.wait(lock);
+    }
+    waiting.fetch_sub(1, std::memory_order_relaxed);
+  }
+
+  // Pairs with the fence in waitFor: either the parked thread sees the new
+  // state when it retries, or we see it registered here. Taking the mutex
+  // before notifying closes the gap between its retry and cv.wait().
+  void notify(std::atomic<size_type> &waiting, std::condition_variable &cv) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiting.load(std::memory_order_relaxed) != 0) {
+      { std::lock_guard<std::mutex> lock(mutex_); }
+      cv.notify_one();
+    }
+  }
+
+ private:
+  allocator_type allocator_;
+  cell_allocator allocator_cell_;
+  const size_type capacity_;
+  const size_type mask_;
+  Cell *const cells_;
+
+  alignas(kCacheLineSize) std::atomic<size_type> enqueue_pos_;
+  alignas(kCacheLineSize) std::atomic<size_type> dequeue_pos_;
+
+  alignas(kCacheLineSize) std::atomic<size_type> waiting_producers_;
+  std::atomic<size_type> waiting_consumers_;
+  std::mutex mutex_;
+  std::condition_variable not_full_;
+  std::condition_variable not_empty_;
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_QUEUE_MPMC_QUEUE_H_
@@ -26,11 +26,11 @@ class queue {
   const_reference front() const noexcept { return queue_.front(); }
   const_reference back() const noexcept { return queue_.back(); }
 
-  queue operator=(const queue &other) {
+  queue &operator=(const queue &other) {
     queue_ = other.queue_;
     return *this;
   }
-  queue operator=(queue &&other) {
+  queue &operator=(queue &&other) {
     queue_ = std::move(other.queue_);
     return *this;
   }
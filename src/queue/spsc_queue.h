@@ -0,0 +1,193 @@
+#ifndef CPP2_S21_CONTAINERS_1_QUEUE_SPSC_QUEUE_H_
+#define CPP2_S21_CONTAINERS_1_QUEUE_SPSC_QUEUE_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include "../../utils/allocator.h"
+#include "../../utils/cache_line.h"
+
+namespace s21 {
+
+// Bounded wait-free queue for exactly one producer thread and one consumer
+// thread. head_ and tail_ grow monotonically and are masked into the ring.
+// Each side keeps a private copy of the other side's index and only reloads
+// it (with acquire) when the copy says the ring is full or empty, so in the
+// steady state neither thread touches the other's cache line.
+template <typename T, typename Allocator = Allocator<T>>
+class spsc_queue {
+ public:
+  using value_type = T;
+  using reference = T &;
+  using const_reference = const T &;
+  using size_type = size_t;
+  using allocator_type = Allocator;
+
+  explicit spsc_queue(size_type capacity, const Allocator &alloc = Allocator())
+      : allocator_(
+            std::allocator_traits<
+                allocator_type>::select_on_container_copy_construction(alloc)),
+        capacity_(roundUpToPowerOfTwo(capacity)),
+        mask_(capacity_ - 1),
+        buffer_(std::allocator_traits<allocator_type>::allocate(allocator_,
+                                                                capacity_)),
+        head_(0),
+        cached_tail_(0),
+        tail_(0),
+        cached_head_(0) {}
+
+  spsc_queue(const spsc_queue &) = delete;
+  spsc_queue &operator=(const spsc_queue &) = delete;
+
+  ~spsc_queue() {
+    size_type tail = tail_.load(std::memory_order_relaxed);
+    for (size_type i = head_.load(std::memory_order_relaxed); i != tail; ++i) {
+      std::allocator_traits<allocator_type>::destroy(allocator_,
+                                                     buffer_ + (i & mask_));
+    }
+    std::allocator_traits<allocator_type>::deallocate(allocator_, buffer_,
+                                                      capacity_);
+  }
+
+  // Producer side.
+
+  bool try_push(const_reference value) { return try_emplace(value); }
+
+  bool try_push(value_type &&value) { return try_emplace(std::move(value)); }
+
+  template <typename... Args>
+  bool try_emplace(Args &&...args) {
+    size_type tail = tail_.load(std::memory_order_relaxed);
+    if (tail - cached_head_ == capacity_) {
+      cached_head_ = head_.load(std::memory_order_acquire);
+      if (tail - cached_head_ == capacity_) {
+        return false;
+      }
+    }
+    std::allocator_traits<allocator_type>::construct(
+        allocator_, buffer_ + (tail & mask_), std::forward<Args>(args)...);
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Copies up to n items from first and publishes them with a single
+  // release store. Returns how many were pushed. If copying an item throws,
+  // the items before it are published before the exception passes on.
+  template <typename InputIt>
+  size_type try_push_n(InputIt first, size_type n) {
+    size_type tail = tail_.load(std::memory_order_relaxed);
+    if (capacity_ - (tail - cached_head_) < n) {
+      cached_head_ = head_.load(std::memory_order_acquire);
+    }
+    size_type count = std::min(n, capacity_ - (tail - cached_head_));
+    size_type i = 0;
+    try {
+      for (; i < count; ++i, ++first) {
+        std::allocator_traits<allocator_type>::construct(
+            allocator_, buffer_ + ((tail + i) & mask_), *first);
+      }
+    } catch (...) {
+      if (i) {
+        tail_.store(tail + i, std::memory_order_release);
+      }
+      throw;
+    }
+    if (count) {
+      tail_.store(tail + count, std::memory_order_release);
+    }
+    return count;
+  }
+
+  // Consumer side.
+
+  bool try_pop(reference value) {
+    size_type head = head_.load(std::memory_order_relaxed);
+    if (head == cached_tail_) {
+      cached_tail_ = tail_.load(std::memory_order_acquire);
+      if (head == cached_tail_) {
+        return false;
+      }
+    }
+    T *item = buffer_ + (head & mask_);
+    value = std::move(*item);
+    std::allocator_traits<allocator_type>::destroy(allocator_, item);
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Moves up to max_n items into out and releases their slots with a single
+  // store. Returns how many were popped.
+  template <typename OutputIt>
+  size_type try_pop_n(OutputIt out, size_type max_n) {
+    size_type head = head_.load(std::memory_order_relaxed);
+    if (cached_tail_ - head < max_n) {
+      cached_tail_ = tail_.load(std::memory_order_acquire);
+    }
+    size_type count = std::min(max_n, cached_tail_ - head);
+    for (size_type i = 0; i < count; ++i, ++out) {
+      T *item = buffer_ + ((head + i) & mask_);
+      *out = std::move(*item);
+      std::allocator_traits<allocator_type>::destroy(allocator_, item);
+    }
+    if (count) {
+      head_.store(head + count, std::memory_order_release);
+    }
+    return count;
+  }
+
+  // Returns nullptr when the queue is empty. Consumer only.
+  T *front() {
+    size_type head = head_.load(std::memory_order_relaxed);
+    if (head == cached_tail_) {
+      cached_tail_ = tail_.load(std::memory_order_acquire);
+      if (head == cached_tail_) {
+        return nullptr;
+      }
+    }
+    return buffer_ + (head & mask_);
+  }
+
+  // Observers are exact only when called from one of the two owning threads
+  // while the other is idle; otherwise they are a snapshot.
+
+  size_type size() const noexcept {
+    size_type head = head_.load(std::memory_order_acquire);
+    return tail_.load(std::memory_order_acquire) - head;
+  }
+
+  bool empty() const noexcept { return size() == 0; }
+
+  size_type capacity() const noexcept { return capacity_; }
+
+ private:
+  static size_type roundUpToPowerOfTwo(size_type value) {
+    if (value == 0) {
+      throw std::invalid_argument("spsc_queue capacity must be positive");
+    }
+    size_type power = 1;
+    while (power < value) {
+      power *= 2;
+    }
+    return power;
+  }
+
+ private:
+  allocator_type allocator_;
+  const size_type capacity_;
+  const size_type mask_;
+  T *const buffer_;
+
+  alignas(kCacheLineSize) std::atomic<size_type> head_;
+  size_type cached_tail_;
+
+  alignas(kCacheLineSize) std::atomic<size_type> tail_;
+  size_type cached_head_;
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_QUEUE_SPSC_QUEUE_H_
@@ -2,32 +2,70 @@
 #define CPP2_S21_CONTAINERS_1_SET_SET_H_
 
 #include <cstddef>
+#include <iterator>
 #include <limits>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
 #include <utility>
 
+#include "../adt/avl_balance.h"
+#include "../adt/node_handle.h"
 #include "../iterators/iterator_tree.h"
 #include "../../utils/allocator.h"
+#include "../../utils/is_transparent.h"
 
 namespace s21 {
 
+// Every node knows its subtree size, which gives rank, select and
+// count_range in O(log n). With a Monoid (see AvlBalance) every node also
+// keeps the fold of its subtree and aggregate() folds any key range in
+// O(log n), e.g. a range sum or minimum.
 template <class Key, class Compare = std::less<Key>,
-          class Allocator = Allocator<Key>>
+          class Allocator = Allocator<Key>, class Monoid = void>
 class set {
  public:
   using key_type = Key;
   using value_type = Key;
   using reference = value_type&;
   using const_reference = const value_type&;
-  using iterator = TreeIterator<Key, iterator_traits<const Key*>, set>;
-  using const_iterator = TreeIterator<Key, iterator_traits<const Key*>, set>;
+  using summary_type = typename TreeSummary<Monoid>::type;
+  using tree_node = TreeNode<Key, summary_type>;
+  using iterator =
+      TreeIterator<Key, iterator_traits<const Key*>, set, tree_node>;
+  using const_iterator =
+      TreeIterator<Key, iterator_traits<const Key*>, set, tree_node>;
   using size_type = size_t;
   using allocator_type = Allocator;
   using node_allocator = typename std::allocator_traits<
-      allocator_type>::template rebind_alloc<TreeNode<Key>>;
+      allocator_type>::template rebind_alloc<tree_node>;
 
  public:
-  set(const Allocator& alloc = Allocator())
-      : comparator_(Compare()),
+  // A key extract()ed from a set. Detached, it can be changed and then
+  // inserted again without reallocating the node.
+  class node_type : public NodeHandle<tree_node, allocator_type,
+                                      node_allocator, Monoid> {
+    using Base = NodeHandle<tree_node, allocator_type, node_allocator, Monoid>;
+
+   public:
+    using value_type = Key;
+
+    node_type() noexcept = default;
+
+    value_type& value() const { return this->node_->data_; }
+
+   private:
+    friend class set;
+
+    using Base::Base;
+  };
+
+  using insert_return_type = InsertReturnType<iterator, node_type>;
+
+  set(const Allocator& alloc = Allocator()) : set(Compare(), alloc) {}
+
+  explicit set(const Compare& compare, const Allocator& alloc = Allocator())
+      : comparator_(compare),
         allocator_(
             std::allocator_traits<
                 allocator_type>::select_on_container_copy_construction(alloc)),
@@ -37,7 +75,7 @@ class set {
         size_(0),
         phantom_node_(std::allocator_traits<node_allocator>::allocate(
             allocator_node_, 1)) {
-    initNode(phantom_node_);
+    initHeader();
   }
 
   set(std::initializer_list<value_type> const& items,
@@ -52,9 +90,9 @@ class set {
         size_(0),
         phantom_node_(std::allocator_traits<node_allocator>::allocate(
             allocator_node_, 1)) {
-    initNode(phantom_node_);
+    initHeader();
     for (auto& item : items) {
-      insert(item);
+      insert(end(), item);
     }
   }
 
@@ -68,9 +106,16 @@ class set {
         size_(0),
         phantom_node_(std::allocator_traits<node_allocator>::allocate(
             allocator_node_, 1)) {
-    initNode(phantom_node_);
-    for (auto& item : rhs) {
-      insert(item);
+    initHeader();
+    try {
+      copySubtree(rhs.phantom_node_->left_, phantom_node_,
+                  phantom_node_->left_);
+      updateExtremes();
+    } catch (...) {
+      clear();
+      std::allocator_traits<node_allocator>::deallocate(allocator_node_,
+                                                        phantom_node_, 1);
+      throw;
     }
   }
 
@@ -79,7 +124,8 @@ class set {
         allocator_(std::move(rhs.allocator_)),
         allocator_node_(std::move(rhs.allocator_node_)),
         size_(std::exchange(rhs.size_, 0)),
-        phantom_node_(std::exchange(rhs.phantom_node_, nullptr)) {}
+        phantom_node_(std::exchange(rhs.phantom_node_, nullptr)),
+        leftmost_(rhs.leftmost_) {}
 
   ~set() {
     if (phantom_node_) {
@@ -89,6 +135,29 @@ class set {
     }
   }
 
+  // Builds a perfectly balanced tree straight from a range sorted in
+  // strictly ascending key order, in O(n) and without any rotation or
+  // comparison beyond checking that order.
+  template <typename ForwardIt>
+  static set from_sorted(ForwardIt first, ForwardIt last,
+                         const Allocator& alloc = Allocator()) {
+    set result(alloc);
+    tree_node* previous = nullptr;
+    tree_node* root = result.buildSorted(
+        first, static_cast<size_type>(std::distance(first, last)), previous);
+    result.phantom_node_->left_ = root;
+    if (root) {
+      root->parent_ = result.phantom_node_;
+    }
+    result.updateExtremes();
+    return result;
+  }
+
+  template <typename Range>
+  static set from_sorted(const Range& range) {
+    return from_sorted(std::begin(range), std::end(range));
+  }
+
   set& operator=(const set& rhs) {
     if (this == &rhs) {
       return *this;
@@ -108,64 +177,62 @@ class set {
   }
 
   std::pair<iterator, bool> insert(const_reference value) {
-    bool is_append = true;
-    auto it = iterator(phantom_node_->left_);
-    if (empty()) {
-      phantom_node_->left_ = allocateAndConstruct(value);
-      phantom_node_->left_->parent_ = phantom_node_;
-    } else {
-      size_t old_size = size_;
-      phantom_node_->left_ = _insert(phantom_node_->left_, nullptr, value);
-      if (size_ == old_size) {
-        is_append = false;
-        it = end();
-      } else {
-        it = find(value);
-      }
-    }
-    return std::make_pair(it, is_append);
+    tree_node* parent = nullptr;
+    bool as_left = true;
+    tree_node* node = findInsertPosition(value, parent, as_left);
+    if (node) {
+      return std::make_pair(iterator(node), false);
+    }
+    node = allocateAndConstruct(value);
+    linkLeaf(node, parent, as_left);
+    return std::make_pair(iterator(node), true);
+  }
+
+  // The hint is the element the new one should precede (end() to append).
+  // When it is right, only the one or two neighbours are compared instead
+  // of descending from the root.
+  iterator insert(iterator hint, const_reference value) {
+    tree_node* parent = nullptr;
+    bool as_left = true;
+    tree_node* node = findHintPosition(hint.ptr_, value, parent, as_left);
+    if (node) {
+      return iterator(node);
+    }
+    node = allocateAndConstruct(value);
+    linkLeaf(node, parent, as_left);
+    return iterator(node);
   }
 
-  TreeNode<Key>* find(TreeNode<Key>* node, const_reference value) const {
-    if (node == nullptr) {
-      return nullptr;
-    }
-    if (comparator_(value, node->data_)) {
-      return find(node->left_, value);
-    }
-    if (comparator_(node->data_, value)) {
-      return find(node->right_, value);
-    } else {
-      return node;
+  template <typename... Args>
+  iterator emplace_hint(iterator hint, Args&&... args) {
+    tree_node* node = allocateAndConstruct(std::forward<Args>(args)...);
+    tree_node* parent = nullptr;
+    bool as_left = true;
+    tree_node* existing =
+        findHintPosition(hint.ptr_, node->data_, parent, as_left);
+    if (existing) {
+      destroyAndDeallocate(node);
+      return iterator(existing);
     }
-    return nullptr;
+    linkLeaf(node, parent, as_left);
+    return iterator(node);
   }
 
+  Compare key_comp() const { return comparator_; }
+
   iterator end() { return iterator(phantom_node_); }
 
-  iterator begin() {
-    TreeNode<Key>* node = findMin(phantom_node_->left_);
-    return iterator(node);
-  }
+  iterator begin() { return iterator(leftmost_); }
 
-  iterator rbegin() {
-    TreeNode<Key>* node = findMax(phantom_node_->left_);
-    return iterator(node);
-  }
+  iterator rbegin() { return iterator(phantom_node_->right_); }
 
-  iterator rbegin() const {
-    TreeNode<Key>* node = findMax(phantom_node_->left_);
-    return iterator(node);
-  }
+  iterator rbegin() const { return iterator(phantom_node_->right_); }
 
   iterator rend() { return iterator(phantom_node_); }
 
   iterator end() const { return iterator(phantom_node_); }
 
-  iterator begin() const {
-    TreeNode<Key>* node = findMin(phantom_node_->left_);
-    return iterator(node);
-  }
+  iterator begin() const { return iterator(leftmost_); }
 
   size_t max_size() const noexcept {
     return std::numeric_limits<size_type>::max() / sizeof(value_type);
@@ -173,23 +240,75 @@ class set {
 
   size_type size() const noexcept { return size_; }
 
-  void erase(iterator pos) { deleteNode(pos.ptr_); }
+  void erase(iterator pos) { eraseNode(pos.ptr_); }
 
   void erase(const_reference value) {
-    TreeNode<Key>* node_for_delete = find(phantom_node_->left_, value);
-    if (node_for_delete) {
-      deleteNode(node_for_delete);
-      // if (size_ != 0) {
-      //   balance(phantom_node_->left_);
-      // }
+    tree_node* node = findNode(value);
+    if (node) {
+      eraseNode(node);
+    }
+  }
+
+  // Takes the key out of the set without destroying it. Iterators to
+  // other keys stay valid.
+  node_type extract(iterator pos) {
+    unlinkNode(pos.ptr_);
+    --size_;
+    return node_type(pos.ptr_, allocator_, allocator_node_);
+  }
+
+  // An empty handle if key is missing.
+  node_type extract(const key_type& key) {
+    tree_node* node = findNode(key);
+    if (node == nullptr) {
+      return node_type();
     }
+    return extract(iterator(node));
+  }
+
+  // Links the extracted node in as it is: nothing is allocated or copied.
+  // If the key is already present the node is handed back in the result.
+  // The node must come from a container with an equal allocator.
+  insert_return_type insert(node_type&& handle) {
+    if (handle.empty()) {
+      return {end(), false, node_type()};
+    }
+    tree_node* parent = nullptr;
+    bool as_left = true;
+    tree_node* existing = findInsertPosition(handle.value(), parent, as_left);
+    if (existing) {
+      return {iterator(existing), false, std::move(handle)};
+    }
+    tree_node* node = handle.release();
+    linkLeaf(node, parent, as_left);
+    ++size_;
+    return {iterator(node), true, node_type()};
+  }
+
+  // As insert(hint, value). If the key is already present, handle keeps
+  // the node.
+  iterator insert(iterator hint, node_type&& handle) {
+    if (handle.empty()) {
+      return end();
+    }
+    tree_node* parent = nullptr;
+    bool as_left = true;
+    tree_node* existing =
+        findHintPosition(hint.ptr_, handle.value(), parent, as_left);
+    if (existing) {
+      return iterator(existing);
+    }
+    tree_node* node = handle.release();
+    linkLeaf(node, parent, as_left);
+    ++size_;
+    return iterator(node);
   }
 
   bool empty() const noexcept { return size_ == 0; }
 
   void clear() {
     _clear(phantom_node_->left_);
-    phantom_node_->left_ = nullptr;
+    initHeader();
   }
 
   void swap(set& rhs) {
@@ -197,363 +316,567 @@ class set {
     std::swap(allocator_node_, rhs.allocator_node_);
     std::swap(size_, rhs.size_);
     std::swap(phantom_node_, rhs.phantom_node_);
+    std::swap(leftmost_, rhs.leftmost_);
     std::swap(comparator_, rhs.comparator_);
   }
 
+  // Moves the keys missing here out of rhs by relinking their nodes:
+  // nothing is allocated or copied, and iterators to moved keys stay
+  // valid, now pointing into this set. A small rhs is spliced in node by
+  // node; when the sizes are comparable both trees are rebuilt from one
+  // linear merge instead. The allocators must compare equal.
   void merge(set& rhs) {
-    set new_rhs;
-    for (auto& item : rhs) {
-      std::pair<iterator, bool> answer = insert(item);
-      if (answer.second == false) {
-        new_rhs.insert(item);
+    if (this == &rhs || rhs.empty()) {
+      return;
+    }
+    if (AvlBalance<tree_node, Monoid>::preferLinearMerge(size_, rhs.size_)) {
+      mergeLinear(rhs);
+      return;
+    }
+    tree_node* node = rhs.leftmost_;
+    while (node != rhs.phantom_node_) {
+      tree_node* next = (++iterator(node)).ptr_;
+      tree_node* parent = nullptr;
+      bool as_left = true;
+      if (!findInsertPosition(node->data_, parent, as_left)) {
+        rhs.unlinkNode(node);
+        --rhs.size_;
+        linkLeaf(node, parent, as_left);
+        ++size_;
       }
+      node = next;
     }
-    rhs = new_rhs;
   }
 
+  void merge(set&& rhs) { merge(rhs); }
+
   iterator find(const Key& key) const {
-    TreeNode<Key>* it = find(phantom_node_->left_, key);
+    tree_node* it = findNode(key);
     if (it == nullptr) {
       return end();
     }
     return iterator(it);
   }
 
-  bool contains(const Key& key) const { return find(key) != end(); }
-
- private:
-  void _clear(TreeNode<Key>* node) {
-    if (node == nullptr) {
-      return;
-    }
-    if (!node->left_ && !node->right_) {
-      deleteLeaf(node);
-      return;
-    }
-    if (node->left_) {
-      _clear(node->left_);
-    }
-    if (node->right_) {
-      _clear(node->right_);
+  // The K overloads only exist for a transparent Compare and look up
+  // anything it orders against Key without converting it to a Key.
+  template <typename K, typename C = Compare,
+            std::enable_if_t<is_transparent_v<C>, int> = 0>
+  iterator find(const K& key) const {
+    tree_node* it = findNode(key);
+    if (it == nullptr) {
+      return end();
     }
-    deleteLeaf(node);
+    return iterator(it);
   }
 
-  void deleteNode(TreeNode<Key>* node) {
-    if (node == nullptr) {
-      return;
+  bool contains(const Key& key) const { return findNode(key) != nullptr; }
+
+  template <typename K, typename C = Compare,
+            std::enable_if_t<is_transparent_v<C>, int> = 0>
+  bool contains(const K& key) const {
+    return findNode(key) != nullptr;
+  }
+
+  size_type count(const Key& key) const { return contains(key) ? 1 : 0; }
+
+  template <typename K, typename C = Compare,
+            std::enable_if_t<is_transparent_v<C>, int> = 0>
+  size_type count(const K& key) const {
+    return contains(key) ? 1 : 0;
+  }
+
+  // The first element not less than key.
+  iterator lower_bound(const Key& key) const {
+    return iterator(lowerBoundNode(key));
+  }
+
+  template <typename K, typename C = Compare,
+            std::enable_if_t<is_transparent_v<C>, int> = 0>
+  iterator lower_bound(const K& key) const {
+    return iterator(lowerBoundNode(key));
+  }
+
+  // The first element whose key is greater than key.
+  iterator upper_bound(const Key& key) const {
+    return iterator(upperBoundNode(key));
+  }
+
+  template <typename K, typename C = Compare,
+            std::enable_if_t<is_transparent_v<C>, int> = 0>
+  iterator upper_bound(const K& key) const {
+    return iterator(upperBoundNode(key));
+  }
+
+  // Keys are unique, so the range is empty or a single element and both
+  // ends come out of one descent.
+  std::pair<iterator, iterator> equal_range(const Key& key) const {
+    return equalRange(key);
+  }
+
+  template <typename K, typename C = Compare,
+            std::enable_if_t<is_transparent_v<C>, int> = 0>
+  std::pair<iterator, iterator> equal_range(const K& key) const {
+    return equalRange(key);
+  }
+
+  // The elements with keys in [low, high); empty when high is not after
+  // low. Both ends are found by a descent, so the view costs O(log n) to
+  // build and iterating it visits only the matching elements.
+  TreeRange<iterator> range(const Key& low, const Key& high) const {
+    return keyRange(low, high);
+  }
+
+  template <typename K1, typename K2, typename C = Compare,
+            std::enable_if_t<is_transparent_v<C>, int> = 0>
+  TreeRange<iterator> range(const K1& low, const K2& high) const {
+    return keyRange(low, high);
+  }
+
+  // The number of elements less than key.
+  size_type rank(const Key& key) const { return rankOf(key); }
+
+  // The element with index position in sorted order, or end().
+  iterator select(size_type position) const {
+    tree_node* node = phantom_node_->left_;
+    if (position >= size_) {
+      return end();
     }
-    size_t count_childs = howManyChildren(node);
-    switch (count_childs) {
-      case 0:
-        deleteLeaf(node);
-        break;
-      case 1:
-        deleteNodeWithOneChild(node);
-        break;
-      case 2:
-        node = deleteNodeWithTwoChildren(node);
-        break;
+    for (;;) {
+      size_type left = AvlBalance<tree_node, Monoid>::count(node->left_);
+      if (position < left) {
+        node = node->left_;
+      } else if (position > left) {
+        position -= left + 1;
+        node = node->right_;
+      } else {
+        return iterator(node);
+      }
     }
   }
 
-  TreeNode<Key>* deleteNodeWithTwoChildren(TreeNode<Key>*& node) {
-    TreeNode<Key>* min = findMin(node->right_);
-    if (node->right_ == min) {
-      min->parent_ = node->parent_;
-      node->parent_ = setupParent(min, node->parent_);
-      min->left_ = node->left_;
-      node->left_->parent_ = min;
-      destroyAndDeallocate(node);
-    } else if (howManyChildren(min) == 0) {
-      min->parent_->left_ = nullptr;
-      min->parent_ = node->parent_;
-      node->parent_ = setupParent(min, node->parent_);
-      min->left_ = node->left_;
-      min->right_ = node->right_;
-      node->left_->parent_ = min;
-      node->right_->parent_ = min;
-      destroyAndDeallocate(node);
-    } else {
-      min->parent_->left_ = min->right_;
-      min->right_->parent_ = min->parent_;
-      min->parent_ = node->parent_;
-      node->parent_ = setupParent(min, node->parent_);
-      min->left_ = node->left_;
-      min->right_ = node->right_;
-      node->left_->parent_ = min;
-      node->right_->parent_ = min;
-      destroyAndDeallocate(node);
+  // The number of elements in [low, high).
+  size_type count_range(const Key& low, const Key& high) const {
+    if (!comparator_(low, high)) {
+      return 0;
     }
-    return min;
+    return rankOf(high) - rankOf(low);
   }
 
-  TreeNode<Key>* setupParent(TreeNode<Key>* node, TreeNode<Key>* parent) {
-    if (parent == end().ptr_) {
-      parent->left_ = node;
-    } else {
-      if (comparator_(node->data_, parent->data_)) {
-        parent->left_ = node;
+  // The fold of every element, in order.
+  template <typename M = Monoid, std::enable_if_t<!std::is_void_v<M>, int> = 0>
+  summary_type aggregate() const {
+    tree_node* root = phantom_node_->left_;
+    return root ? root->summary_ : M::identity();
+  }
+
+  // The fold of the elements in [low, high), in order: one descent to
+  // where the two bounds part, then one along each bound.
+  template <typename M = Monoid, std::enable_if_t<!std::is_void_v<M>, int> = 0>
+  summary_type aggregate(const Key& low, const Key& high) const {
+    tree_node* node = phantom_node_->left_;
+    while (node) {
+      if (comparator_(node->data_, low)) {
+        node = node->right_;
+      } else if (!comparator_(node->data_, high)) {
+        node = node->left_;
       } else {
-        parent->right_ = node;
+        break;
       }
     }
-    node->parent_ = parent;
-    return parent;
-  }
-
-  void deleteNodeWithOneChild(TreeNode<Key>* node) {
-    if (node->right_) {
-      deleteNodeWithRightChild(node);
-    } else if (node->left_) {
-      deleteNodeWithLeftChild(node);
+    if (node == nullptr) {
+      return M::identity();
     }
+    summary_type before = M::identity();
+    for (tree_node* low_side = node->left_; low_side;) {
+      if (comparator_(low_side->data_, low)) {
+        low_side = low_side->right_;
+      } else {
+        summary_type taken = M::lift(low_side->data_);
+        if (low_side->right_) {
+          taken = M::combine(taken, low_side->right_->summary_);
+        }
+        before = M::combine(taken, before);
+        low_side = low_side->left_;
+      }
+    }
+    summary_type after = M::identity();
+    for (tree_node* high_side = node->right_; high_side;) {
+      if (comparator_(high_side->data_, high)) {
+        summary_type taken = M::lift(high_side->data_);
+        if (high_side->left_) {
+          taken = M::combine(high_side->left_->summary_, taken);
+        }
+        after = M::combine(after, taken);
+        high_side = high_side->right_;
+      } else {
+        high_side = high_side->left_;
+      }
+    }
+    return M::combine(M::combine(before, M::lift(node->data_)), after);
   }
 
-  void deleteNodeWithRightChild(TreeNode<Key>* node) {
-    TreeNode<Key>* child = node->right_;
-    TreeNode<Key>* parent = node->parent_;
-    child->parent_ = parent;
-    if (comparator_(parent->data_, child->data_)) {
-      parent->right_ = child;
-    } else if (comparator_(child->data_, parent->data_)) {
-      parent->left_ = child;
+ private:
+  void _clear(tree_node* node) {
+    if (node == nullptr) {
+      return;
     }
+    _clear(node->left_);
+    _clear(node->right_);
     destroyAndDeallocate(node);
   }
 
-  void deleteNodeWithLeftChild(TreeNode<Key>* node) {
-    TreeNode<Key>* child = node->left_;
-    TreeNode<Key>* parent = node->parent_;
-    child->parent_ = parent;
-    if (comparator_(parent->data_, child->data_) && parent != phantom_node_) {
-      parent->right_ = child;
-
-    } else if (comparator_(child->data_, parent->data_)) {
-      parent->left_ = child;
-    }
+  void eraseNode(tree_node* node) {
+    unlinkNode(node);
     destroyAndDeallocate(node);
   }
 
-  void deleteLeaf(TreeNode<Key>* node) {
-    TreeNode<Key>* parent = node->parent_;
-    if (parent == phantom_node_) {
-      destroyAndDeallocate(node);
-      phantom_node_->left_ = nullptr;
-      return;
+  // Takes node out of the tree without freeing it or counting it out.
+  void unlinkNode(tree_node* node) {
+    if (node == leftmost_) {
+      leftmost_ = (++iterator(node)).ptr_;
+    }
+    if (node == phantom_node_->right_) {
+      phantom_node_->right_ = (--iterator(node)).ptr_;
+    }
+    AvlBalance<tree_node, Monoid>::erase(node, phantom_node_);
+  }
+
+  // Flattens both trees into sorted lists, merges them in one pass while
+  // rhs's duplicates go to a list of their own, and rebuilds both trees
+  // balanced: O(n + m) comparisons and relinks. If a comparison throws,
+  // the unmerged rest of each list stays with its own tree, so both come
+  // out valid with part of rhs moved.
+  void mergeLinear(set& rhs) {
+    using Balance = AvlBalance<tree_node, Monoid>;
+    tree_node* mine = Balance::flatten(phantom_node_->left_, nullptr);
+    tree_node* theirs = Balance::flatten(rhs.phantom_node_->left_, nullptr);
+    tree_node* kept = nullptr;
+    tree_node* rejected = nullptr;
+    tree_node** kept_tail = &kept;
+    tree_node** rejected_tail = &rejected;
+    size_type moved = 0;
+    auto take = [](tree_node**& tail, tree_node*& list) noexcept {
+      *tail = list;
+      tail = &list->right_;
+      list = list->right_;
+    };
+    auto rebuild = [&]() {
+      *kept_tail = mine;
+      *rejected_tail = theirs;
+      size_ += moved;
+      rhs.size_ -= moved;
+      phantom_node_->left_ = Balance::buildFromList(kept, size_, phantom_node_);
+      rhs.phantom_node_->left_ =
+          Balance::buildFromList(rejected, rhs.size_, rhs.phantom_node_);
+      updateExtremes();
+      rhs.updateExtremes();
+    };
+    try {
+      while (mine && theirs) {
+        if (comparator_(theirs->data_, mine->data_)) {
+          take(kept_tail, theirs);
+          ++moved;
+        } else {
+          if (!comparator_(mine->data_, theirs->data_)) {
+            take(rejected_tail, theirs);
+          }
+          take(kept_tail, mine);
+        }
+      }
+    } catch (...) {
+      rebuild();
+      throw;
     }
-    if (comparator_(node->data_, parent->data_)) {
-      parent->left_ = nullptr;
-    } else {
-      parent->right_ = nullptr;
+    for (; theirs; ++moved) {
+      take(kept_tail, theirs);
     }
-
-    destroyAndDeallocate(node);
+    rebuild();
   }
 
-  size_t howManyChildren(TreeNode<Key>* node) const {
-    size_t count = 0;
-    if (node->right_) ++count;
-    if (node->left_) ++count;
-    return count;
+  // A new leaf can only become an extreme by hanging off the old one on
+  // the outer side, so keeping them up to date costs one comparison.
+  void linkLeaf(tree_node* node, tree_node* parent, bool as_left) {
+    if (parent == phantom_node_) {
+      leftmost_ = node;
+      phantom_node_->right_ = node;
+    } else if (as_left && parent == leftmost_) {
+      leftmost_ = node;
+    } else if (!as_left && parent == phantom_node_->right_) {
+      phantom_node_->right_ = node;
+    }
+    AvlBalance<tree_node, Monoid>::insertLeaf(node, parent, as_left,
+                                              phantom_node_);
   }
 
-  TreeNode<Key>* findMin(TreeNode<Key>* node) const {
+  tree_node* findMin(tree_node* node) const {
     while (node && node->left_) {
       node = node->left_;
     }
     return node;
   }
 
-  TreeNode<Key>* findMax(TreeNode<Key>* node) const {
+  tree_node* findMax(tree_node* node) const {
     while (node && node->right_) {
       node = node->right_;
     }
     return node;
   }
 
-  void destroyAndDeallocate(TreeNode<Key>* node) {
+  void destroyAndDeallocate(tree_node* node) {
+    if constexpr (!std::is_void_v<Monoid>) {
+      node->summary_.~summary_type();
+    }
     std::allocator_traits<allocator_type>::destroy(allocator_, &(node->data_));
     std::allocator_traits<node_allocator>::deallocate(allocator_node_, node, 1);
     --size_;
   }
 
-  TreeNode<Key>* allocateAndConstruct(const_reference value) {
-    TreeNode<Key>* node =
+  template <typename... Args>
+  tree_node* allocateAndConstruct(Args&&... args) {
+    tree_node* node =
         std::allocator_traits<node_allocator>::allocate(allocator_node_, 1);
-    std::allocator_traits<allocator_type>::construct(allocator_, &(node->data_),
-                                                     value);
+    try {
+      std::allocator_traits<allocator_type>::construct(
+          allocator_, &(node->data_), std::forward<Args>(args)...);
+    } catch (...) {
+      std::allocator_traits<node_allocator>::deallocate(allocator_node_, node,
+                                                        1);
+      throw;
+    }
+    if constexpr (!std::is_void_v<Monoid>) {
+      // Only data_ goes through the allocator; the summary is ours.
+      try {
+        ::new (static_cast<void*>(&node->summary_)) summary_type();
+      } catch (...) {
+        std::allocator_traits<allocator_type>::destroy(allocator_,
+                                                       &(node->data_));
+        std::allocator_traits<node_allocator>::deallocate(allocator_node_,
+                                                          node, 1);
+        throw;
+      }
+    }
     ++size_;
     initNode(node);
     return node;
   }
 
-  void initNode(TreeNode<Key>* node) {
+  void initNode(tree_node* node) {
     node->left_ = nullptr;
     node->right_ = nullptr;
     node->parent_ = nullptr;
     node->height_ = 0;
   }
 
-  TreeNode<Key>* leftRotate(TreeNode<Key>* node) {
-    TreeNode<Key>* tmp_node = node->left_;
-    if (tmp_node->right_ != nullptr) {
-      tmp_node->right_->parent_ = node;
-    }
-    node->left_ = tmp_node->right_;
-    if (node->left_ != nullptr) {
-      node->left_->parent_ = node;
-    }
-    tmp_node->right_ = node;
-    tmp_node->parent_ = node->parent_;
-    node->parent_ = tmp_node;
-    if (tmp_node->parent_ != phantom_node_ &&
-        comparator_(node->data_, tmp_node->parent_->data_)) {
-      tmp_node->parent_->left_ = tmp_node;
-    } else {
-      if (tmp_node->parent_ != phantom_node_) {
-        tmp_node->parent_->right_ = tmp_node;
+  // The header's left_ is the root and its right_ the last node; leftmost_
+  // is the first one. Both extremes point back at the header when the set
+  // is empty, so begin() == end() and --end() needs no special case.
+  void initHeader() noexcept {
+    initNode(phantom_node_);
+    phantom_node_->right_ = phantom_node_;
+    leftmost_ = phantom_node_;
+  }
+
+  // Recomputes both extremes after a whole tree was built at once.
+  void updateExtremes() noexcept {
+    tree_node* root = phantom_node_->left_;
+    leftmost_ = root ? findMin(root) : phantom_node_;
+    phantom_node_->right_ = root ? findMax(root) : phantom_node_;
+  }
+
+  // One comparison chain from the root: the node holding key, or nullptr.
+  template <typename K>
+  tree_node* findNode(const K& key) const {
+    tree_node* node = phantom_node_->left_;
+    while (node) {
+      if (comparator_(key, node->data_)) {
+        node = node->left_;
+      } else if (comparator_(node->data_, key)) {
+        node = node->right_;
+      } else {
+        return node;
       }
     }
-    node = tmp_node;
-    setHeight(node->left_);
-    setHeight(node->right_);
-    setHeight(node);
-    setHeight(node->parent_);
-    return node;
+    return nullptr;
   }
 
-  TreeNode<Key>* rightRotate(TreeNode<Key>* node) {
-    TreeNode<Key>* tmp_node = node->right_;
-    node->right_ = tmp_node->left_;
-    if (tmp_node->left_ != nullptr) {
-      tmp_node->left_->parent_ = node;
-    }
-    tmp_node->left_ = node;
-    tmp_node->parent_ = node->parent_;
-    node->parent_ = tmp_node;
-    if (tmp_node->parent_ != nullptr && tmp_node->parent_ != phantom_node_ &&
-        comparator_(node->data_, tmp_node->parent_->data_)) {
-      tmp_node->parent_->left_ = tmp_node;
-    } else {
-      if (tmp_node->parent_ != nullptr && tmp_node->parent_ != phantom_node_) {
-        tmp_node->parent_->right_ = tmp_node;
+  template <typename K>
+  tree_node* lowerBoundNode(const K& key) const {
+    tree_node* node = phantom_node_->left_;
+    tree_node* bound = phantom_node_;
+    while (node) {
+      if (comparator_(node->data_, key)) {
+        node = node->right_;
+      } else {
+        bound = node;
+        node = node->left_;
       }
     }
-    node = tmp_node;
-    setHeight(node->left_);
-    setHeight(node->right_);
-    setHeight(node);
-    setHeight(node->parent_);
-    return node;
+    return bound;
   }
 
-  TreeNode<Key>* rightLeftRotate(TreeNode<Key>* node) {
-    node->left_ = rightRotate(node->left_);
-    return leftRotate(node);
+  template <typename K>
+  tree_node* upperBoundNode(const K& key) const {
+    tree_node* node = phantom_node_->left_;
+    tree_node* bound = phantom_node_;
+    while (node) {
+      if (comparator_(key, node->data_)) {
+        bound = node;
+        node = node->left_;
+      } else {
+        node = node->right_;
+      }
+    }
+    return bound;
   }
 
-  TreeNode<Key>* leftRightRotate(TreeNode<Key>* node) {
-    node->right_ = leftRotate(node->right_);
-    return rightRotate(node);
+  template <typename K>
+  std::pair<iterator, iterator> equalRange(const K& key) const {
+    iterator first(lowerBoundNode(key));
+    iterator last = first;
+    if (first.ptr_ != phantom_node_ && !comparator_(key, first.ptr_->data_)) {
+      ++last;
+    }
+    return std::make_pair(first, last);
   }
 
-  TreeNode<Key>* balance(TreeNode<Key>* node) {
-    int first_height = 0;
-    int second_height = 0;
-    if (node->left_ != nullptr) {
-      first_height = node->left_->height_;
-    }
-    if (node->right_ != nullptr) {
-      second_height = node->right_->height_;
+  size_type rankOf(const Key& key) const {
+    size_type rank = 0;
+    tree_node* node = phantom_node_->left_;
+    while (node) {
+      if (comparator_(node->data_, key)) {
+        rank += AvlBalance<tree_node, Monoid>::count(node->left_) + 1;
+        node = node->right_;
+      } else {
+        node = node->left_;
+      }
     }
-    if (std::abs(first_height - second_height) == 2) {
-      if (first_height < second_height) {
-        int right_height1 = 0;
-        int right_height2 = 0;
-        if (node->right_->right_ != nullptr) {
-          right_height2 = node->right_->right_->height_;
-        }
-        if (node->right_->left_ != nullptr) {
-          right_height1 = node->right_->left_->height_;
-        }
-        if (right_height1 > right_height2) {
-          node = leftRightRotate(node);
-        } else {
-          node = rightRotate(node);
-        }
+    return rank;
+  }
+
+  template <typename K1, typename K2>
+  TreeRange<iterator> keyRange(const K1& low, const K2& high) const {
+    iterator first(lowerBoundNode(low));
+    if (!comparator_(low, high)) {
+      return TreeRange<iterator>(first, first);
+    }
+    return TreeRange<iterator>(first, iterator(lowerBoundNode(high)));
+  }
+
+  // Returns the node holding key, or nullptr together with the leaf slot
+  // (parent and side) where key belongs.
+  tree_node* findInsertPosition(const key_type& key, tree_node*& parent,
+                                bool& as_left) const {
+    tree_node* node = phantom_node_->left_;
+    parent = phantom_node_;
+    as_left = true;
+    while (node) {
+      parent = node;
+      if (comparator_(key, node->data_)) {
+        as_left = true;
+        node = node->left_;
+      } else if (comparator_(node->data_, key)) {
+        as_left = false;
+        node = node->right_;
       } else {
-        int left_height1 = 0;
-        int left_height2 = 0;
-        if (node->left_->right_ != nullptr) {
-          left_height2 = node->left_->right_->height_;
-        }
-        if (node->left_->left_ != nullptr) {
-          left_height1 = node->left_->left_->height_;
-        }
-        if (left_height1 > left_height2) {
-          node = leftRotate(node);
-        } else {
-          node = rightLeftRotate(node);
-        }
+        return node;
       }
     }
-    return node;
+    return nullptr;
   }
 
-  TreeNode<Key>* _insert(TreeNode<Key>* node, TreeNode<Key>* parent,
-                         const_reference value) {
-    if (node == nullptr) {
-      node = allocateAndConstruct(value);
-      node->height_ = 1;
-      node->parent_ = parent;
-    } else if (comparator_(value, node->data_)) {
-      node->left_ = _insert(node->left_, node, value);
-      int first_height = 0;
-      int second_height = 0;
-      if (node->left_ != nullptr) {
-        first_height = node->left_->height_;
-      }
-      if (node->right_ != nullptr) {
-        second_height = node->right_->height_;
-      }
-      if (std::abs(first_height - second_height) == 2) {
-        if (node->left_ != nullptr && comparator_(value, node->left_->data_)) {
-          node = leftRotate(node);
-        } else {
-          node = rightLeftRotate(node);
-        }
-      }
-    } else if (comparator_(node->data_, value)) {
-      node->right_ = _insert(node->right_, node, value);
-      int first_height = 0;
-      int second_height = 0;
-      if (node->left_ != nullptr) {
-        first_height = node->left_->height_;
+  // Like findInsertPosition, but first checks whether key fits between the
+  // hint and its predecessor (or successor). Two in-order neighbours always
+  // have a free child slot facing each other, so a correct hint needs no
+  // descent; a wrong one falls back to the full search.
+  tree_node* findHintPosition(tree_node* hint, const key_type& key,
+                              tree_node*& parent, bool& as_left) const {
+    if (hint == phantom_node_) {
+      tree_node* last = phantom_node_->right_;
+      if (last != phantom_node_ && comparator_(last->data_, key)) {
+        parent = last;
+        as_left = false;
+        return nullptr;
       }
-      if (node->right_ != nullptr) {
-        second_height = node->right_->height_;
+    } else if (comparator_(key, hint->data_)) {
+      tree_node* before =
+          hint == leftmost_ ? phantom_node_ : (--iterator(hint)).ptr_;
+      if (before == phantom_node_ || comparator_(before->data_, key)) {
+        as_left = hint->left_ == nullptr;
+        parent = as_left ? hint : before;
+        return nullptr;
       }
-      if (std::abs(first_height - second_height) == 2) {
-        if (node->right_ != nullptr &&
-            comparator_(value, node->right_->data_)) {
-          node = leftRightRotate(node);
-        } else {
-          node = rightRotate(node);
-        }
+    } else if (comparator_(hint->data_, key)) {
+      tree_node* after = hint == phantom_node_->right_
+                             ? phantom_node_
+                             : (++iterator(hint)).ptr_;
+      if (after == phantom_node_ || comparator_(key, after->data_)) {
+        as_left = hint->right_ != nullptr;
+        parent = as_left ? after : hint;
+        return nullptr;
       }
     } else {
+      return hint;
     }
-    setHeight(node);
-    return node;
+    return findInsertPosition(key, parent, as_left);
   }
 
-  void setHeight(TreeNode<Key>* node) {
-    if (node == nullptr) return;
-    int val = 1;
-    if (node->left_ != nullptr) val = node->left_->height_ + 1;
-    if (node->right_ != nullptr) val = std::max(val, node->right_->height_ + 1);
-    node->height_ = val;
+  // Clones source under parent, linking every node before descending so
+  // that a throwing copy leaves a well-formed partial tree to clear().
+  void copySubtree(const tree_node* source, tree_node* parent,
+                   tree_node*& slot) {
+    if (source == nullptr) {
+      return;
+    }
+    tree_node* node = allocateAndConstruct(source->data_);
+    node->parent_ = parent;
+    node->count_ = source->count_;
+    node->height_ = source->height_;
+    node->summary_ = source->summary_;
+    slot = node;
+    copySubtree(source->left_, node, node->left_);
+    copySubtree(source->right_, node, node->right_);
+  }
+
+  // Takes count elements from first in order: the left half becomes the
+  // left subtree, the next element the root, the rest the right subtree.
+  template <typename ForwardIt>
+  tree_node* buildSorted(ForwardIt& first, size_type count,
+                         tree_node*& previous) {
+    if (count == 0) {
+      return nullptr;
+    }
+    size_type left_count = count / 2;
+    tree_node* left = buildSorted(first, left_count, previous);
+    tree_node* node = nullptr;
+    try {
+      node = allocateAndConstruct(*first);
+      ++first;
+      if (previous && !comparator_(previous->data_, node->data_)) {
+        destroyAndDeallocate(node);
+        throw std::invalid_argument(
+            "from_sorted needs strictly ascending keys");
+      }
+    } catch (...) {
+      _clear(left);
+      throw;
+    }
+    previous = node;
+    node->left_ = left;
+    if (left) {
+      left->parent_ = node;
+    }
+    try {
+      node->right_ = buildSorted(first, count - left_count - 1, previous);
+    } catch (...) {
+      _clear(node);
+      throw;
+    }
+    if (node->right_) {
+      node->right_->parent_ = node;
+    }
+    AvlBalance<tree_node, Monoid>::update(node);
+    return node;
   }
 
  private:
@@ -561,7 +884,8 @@ class set {
   allocator_type allocator_;
   node_allocator allocator_node_;
   size_t size_;
-  TreeNode<Key>* phantom_node_;
+  tree_node* phantom_node_;
+  tree_node* leftmost_;
 };
 
 }  // namespace s21
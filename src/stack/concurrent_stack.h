@@ -0,0 +1,138 @@
+#ifndef CPP2_S21_CONTAINERS_1_STACK_CONCURRENT_STACK_H_
+#define CPP2_S21_CONTAINERS_1_STACK_CONCURRENT_STACK_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include "../../utils/allocator.h"
+#include "../../utils/epoch_reclamation.h"
+
+namespace s21 {
+
+// Lock-free Treiber stack. head_ packs the top node pointer with a 16-bit
+// modification tag in the unused upper bits of a 64-bit address, so a CAS
+// against a stale head fails even if the same address is pushed again.
+// Popped nodes are retired to EpochReclamation and only freed once no
+// thread can still be reading them, so pop never touches freed memory.
+template <typename T, typename Allocator = Allocator<T>>
+class concurrent_stack {
+  static_assert(sizeof(void *) == 8,
+                "tagged pointers need the spare bits of a 64-bit address");
+
+  struct Node {
+    T data_;
+    Node *next_;
+  };
+
+ public:
+  using value_type = T;
+  using reference = T &;
+  using const_reference = const T &;
+  using size_type = size_t;
+  using allocator_type = Allocator;
+  using node_allocator = typename std::allocator_traits<
+      allocator_type>::template rebind_alloc<Node>;
+
+  concurrent_stack() : head_(0) {}
+
+  concurrent_stack(const concurrent_stack &) = delete;
+  concurrent_stack &operator=(const concurrent_stack &) = delete;
+
+  // Must not run concurrently with any other operation.
+  ~concurrent_stack() {
+    Node *node = pointer(head_.load(std::memory_order_acquire));
+    while (node) {
+      Node *next = node->next_;
+      destroyNode(node);
+      node = next;
+    }
+  }
+
+  void push(const_reference value) { emplace(value); }
+
+  void push(value_type &&value) { emplace(std::move(value)); }
+
+  template <typename... Args>
+  void emplace(Args &&...args) {
+    Node *node = createNode(std::forward<Args>(args)...);
+    uintptr_t head = head_.load(std::memory_order_relaxed);
+    do {
+      node->next_ = pointer(head);
+    } while (!head_.compare_exchange_weak(head, pack(node, tag(head) + 1),
+                                          std::memory_order_release,
+                                          std::memory_order_relaxed));
+  }
+
+  bool try_pop(reference value) {
+    EpochReclamation &domain = EpochReclamation::instance();
+    EpochReclamation::Guard guard(domain);
+    uintptr_t head = head_.load(std::memory_order_acquire);
+    Node *node = nullptr;
+    do {
+      node = pointer(head);
+      if (node == nullptr) {
+        return false;
+      }
+    } while (!head_.compare_exchange_weak(head, pack(node->next_, tag(head) + 1),
+                                          std::memory_order_acquire,
+                                          std::memory_order_acquire));
+    value = std::move(node->data_);
+    domain.retire(node, &destroyNode);
+    return true;
+  }
+
+  // A snapshot; another thread may change it right after.
+  bool empty() const noexcept {
+    return pointer(head_.load(std::memory_order_acquire)) == nullptr;
+  }
+
+ private:
+  static constexpr int kTagShift = 48;
+  static constexpr uintptr_t kPointerMask =
+      (static_cast<uintptr_t>(1) << kTagShift) - 1;
+
+  static Node *pointer(uintptr_t value) noexcept {
+    return reinterpret_cast<Node *>(value & kPointerMask);
+  }
+
+  static uintptr_t tag(uintptr_t value) noexcept { return value >> kTagShift; }
+
+  static uintptr_t pack(Node *node, uintptr_t tag) noexcept {
+    return reinterpret_cast<uintptr_t>(node) | (tag << kTagShift);
+  }
+
+  template <typename... Args>
+  static Node *createNode(Args &&...args) {
+    node_allocator allocator_node;
+    allocator_type allocator;
+    Node *node =
+        std::allocator_traits<node_allocator>::allocate(allocator_node, 1);
+    try {
+      std::allocator_traits<allocator_type>::construct(
+          allocator, &(node->data_), std::forward<Args>(args)...);
+    } catch (...) {
+      std::allocator_traits<node_allocator>::deallocate(allocator_node, node,
+                                                        1);
+      throw;
+    }
+    return node;
+  }
+
+  static void destroyNode(void *ptr) {
+    Node *node = static_cast<Node *>(ptr);
+    node_allocator allocator_node;
+    allocator_type allocator;
+    std::allocator_traits<allocator_type>::destroy(allocator, &(node->data_));
+    std::allocator_traits<node_allocator>::deallocate(allocator_node, node, 1);
+  }
+
+ private:
+  alignas(kCacheLineSize) std::atomic<uintptr_t> head_;
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_STACK_CONCURRENT_STACK_H_
@@ -1,11 +1,18 @@
 #ifndef CPP2_S21_CONTAINERS_1_STACK_STACK2_H_
 #define CPP2_S21_CONTAINERS_1_STACK_STACK2_H_
 
-#include "../list/list.h"
+#include <initializer_list>
+#include <utility>
+
+#include "../vector/vector.h"
 
 namespace s21 {
 
-template <typename T, typename Container = s21::list<T>>
+// Defaults to contiguous storage: once the vector has grown to the working
+// depth, push and pop never touch the allocator. Any container with back,
+// push_back, emplace_back and pop_back works (s21::list, s21::deque);
+// reserve() additionally needs Container::reserve.
+template <typename T, typename Container = s21::vector<T>>
 class stack {
  private:
   using container_type = Container;
@@ -20,33 +27,40 @@ class stack {
   stack(const stack &other) : stack_(other.stack_) {}
   stack(stack &&other) noexcept : stack_(std::move(other.stack_)) {}
 
-  stack operator=(const stack &other) {
+  stack &operator=(const stack &other) {
     stack_ = other.stack_;
     return *this;
   }
 
-  stack operator=(stack &&other) {
+  stack &operator=(stack &&other) {
     stack_ = std::move(other.stack_);
     return *this;
   }
 
   void swap(stack &other) { return stack_.swap(other.stack_); }
 
-  size_type size() { return stack_.size(); }
+  size_type size() const { return stack_.size(); }
 
-  bool empty() { return stack_.empty(); }
+  bool empty() const { return stack_.empty(); }
 
-  const_reference top() { return stack_.back(); }
+  const_reference top() const { return stack_.back(); }
 
   void push(const_reference value) { stack_.push_back(value); }
 
+  void push(value_type &&value) { stack_.push_back(std::move(value)); }
+
+  template <typename... Args>
+  void emplace(Args &&...args) {
+    stack_.emplace_back(std::forward<Args>(args)...);
+  }
+
   void pop() { stack_.pop_back(); }
 
+  void reserve(size_type size) { stack_.reserve(size); }
+
   template <typename... Args>
   void insert_many_front(Args &&...args) {
-    for (auto &it : {args...}) {
-      push(it);
-    }
+    (push(std::forward<Args>(args)), ...);
   }
 
  private:
@@ -0,0 +1,289 @@
+#ifndef CPP2_S21_CONTAINERS_1_THREAD_POOL_THREAD_POOL_H_
+#define CPP2_S21_CONTAINERS_1_THREAD_POOL_THREAD_POOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../../utils/cache_line.h"
+#include "../deque/deque.h"
+#include "../deque/ws_deque.h"
+
+namespace s21 {
+
+// Work-stealing thread pool. Every worker owns a ws_deque: tasks submitted
+// from inside a task go to the submitting worker's own deque without any
+// locking, and the worker runs them newest first while idle workers steal
+// the oldest ones. Tasks submitted from other threads go through a shared
+// injection queue. Idle workers spin briefly, then sleep until new work is
+// announced.
+//
+// wait() blocks until every submitted task, including the ones they
+// submitted in turn, has finished, and rethrows the first exception a task
+// threw. It must be called from outside the pool.
+class thread_pool {
+  struct Task {
+    virtual ~Task() = default;
+    virtual void run() = 0;
+  };
+
+  template <typename F>
+  struct TaskImpl : Task {
+    explicit TaskImpl(F &&function) : function_(std::move(function)) {}
+    explicit TaskImpl(const F &function) : function_(function) {}
+    void run() override { function_(); }
+
+    F function_;
+  };
+
+  struct alignas(kCacheLineSize) Worker {
+    ws_deque<Task *> deque_;
+    uint64_t seed_ = 0;
+  };
+
+  struct Context {
+    thread_pool *pool_;
+    size_t index_;
+  };
+
+ public:
+  using size_type = size_t;
+
+  explicit thread_pool(size_type threads = defaultThreads())
+      : size_(threads),
+        injected_size_(0),
+        pending_(0),
+        sleeping_(0),
+        signals_(0),
+        stopping_(false) {
+    if (threads == 0) {
+      throw std::invalid_argument("thread_pool needs at least one thread");
+    }
+    workers_ = std::make_unique<Worker[]>(size_);
+    threads_.reserve(size_);
+    for (size_type i = 0; i < size_; ++i) {
+      workers_[i].seed_ = 0x9E3779B97F4A7C15ULL * (i + 1);
+      threads_.emplace_back([this, i]() { workerLoop(i); });
+    }
+  }
+
+  thread_pool(const thread_pool &) = delete;
+  thread_pool &operator=(const thread_pool &) = delete;
+
+  // Finishes the outstanding tasks first; their exceptions are dropped.
+  ~thread_pool() {
+    waitPending();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopping_ = true;
+    }
+    wake_.notify_all();
+    for (auto &thread : threads_) {
+      thread.join();
+    }
+  }
+
+  // If queueing the task throws, it is dropped and the exception passes
+  // on; the pool stays usable and wait() does not count the task.
+  template <typename F>
+  void submit(F &&function) {
+    std::unique_ptr<Task> task =
+        std::make_unique<TaskImpl<std::decay_t<F>>>(std::forward<F>(function));
+    // Counted before it is visible, so a worker that runs it at once cannot
+    // take pending_ below zero.
+    pending_.fetch_add(1, std::memory_order_relaxed);
+    try {
+      if (context_.pool_ == this) {
+        workers_[context_.index_].deque_.push(task.get());
+      } else {
+        std::lock_guard<std::mutex> lock(mutex_);
+        injected_.push_back(task.get());
+        injected_size_.fetch_add(1, std::memory_order_relaxed);
+      }
+    } catch (...) {
+      finishOne();
+      throw;
+    }
+    task.release();
+    wakeOne();
+  }
+
+  void wait() {
+    if (context_.pool_ == this) {
+      throw std::logic_error("thread_pool::wait called from a pool task");
+    }
+    waitPending();
+    std::exception_ptr error;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      error = std::exchange(error_, nullptr);
+    }
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+
+  size_type size() const noexcept { return size_; }
+
+ private:
+  static constexpr int kSpinRounds = 64;
+
+  static size_type defaultThreads() noexcept {
+    size_type threads = std::thread::hardware_concurrency();
+    return threads ? threads : 1;
+  }
+
+  void workerLoop(size_type index) {
+    context_ = Context{this, index};
+    int idle = 0;
+    for (;;) {
+      Task *task = findTask(index);
+      if (task) {
+        execute(task);
+        idle = 0;
+      } else if (++idle < kSpinRounds) {
+        std::this_thread::yield();
+      } else {
+        idle = 0;
+        if (!park()) {
+          return;
+        }
+      }
+    }
+  }
+
+  Task *findTask(size_type index) {
+    Task *task = nullptr;
+    if (workers_[index].deque_.pop(task) || takeInjected(task)) {
+      return task;
+    }
+    return steal(index);
+  }
+
+  bool takeInjected(Task *&task) {
+    if (injected_size_.load(std::memory_order_relaxed) == 0) {
+      return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (injected_.empty()) {
+      return false;
+    }
+    task = injected_.front();
+    injected_.pop_front();
+    injected_size_.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+  }
+
+  // Visits the other workers starting from a random victim so that thieves
+  // spread out instead of all hitting the same deque.
+  Task *steal(size_type index) {
+    uint64_t &seed = workers_[index].seed_;
+    seed ^= seed << 13;
+    seed ^= seed >> 7;
+    seed ^= seed << 17;
+    size_type start = static_cast<size_type>(seed % size_);
+    Task *task = nullptr;
+    for (size_type i = 0; i < size_; ++i) {
+      size_type victim = (start + i) % size_;
+      if (victim != index && workers_[victim].deque_.steal(task)) {
+        return task;
+      }
+    }
+    return nullptr;
+  }
+
+  void execute(Task *task) {
+    try {
+      task->run();
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!error_) {
+        error_ = std::current_exception();
+      }
+    }
+    delete task;
+    finishOne();
+  }
+
+  void finishOne() {
+    if (pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      done_.notify_all();
+    }
+  }
+
+  bool hasWork() const noexcept {
+    if (injected_size_.load(std::memory_order_relaxed) != 0) {
+      return true;
+    }
+    for (size_type i = 0; i < size_; ++i) {
+      if (!workers_[i].deque_.empty()) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Registers as sleeping before the final look for work; wakeOne() checks
+  // the counter after publishing a task, so one of the two always sees the
+  // other. Returns false once the pool is shutting down.
+  bool park() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    sleeping_.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    uint64_t seen = signals_;
+    while (!stopping_ && signals_ == seen && !hasWork()) {
+      wake_.wait(lock);
+    }
+    sleeping_.fetch_sub(1, std::memory_order_relaxed);
+    return !stopping_;
+  }
+
+  void wakeOne() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleeping_.load(std::memory_order_relaxed) > 0) {
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++signals_;
+      }
+      wake_.notify_one();
+    }
+  }
+
+  void waitPending() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this]() {
+      return pending_.load(std::memory_order_acquire) == 0;
+    });
+  }
+
+ private:
+  inline static thread_local Context context_{nullptr, 0};
+
+  size_type size_;
+  std::unique_ptr<Worker[]> workers_;
+  std::vector<std::thread> threads_;
+  s21::deque<Task *> injected_;
+  std::atomic<size_type> injected_size_;
+  alignas(kCacheLineSize) std::atomic<size_type> pending_;
+  alignas(kCacheLineSize) std::atomic<size_type> sleeping_;
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  std::condition_variable done_;
+  uint64_t signals_;
+  bool stopping_;
+  std::exception_ptr error_;
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_THREAD_POOL_THREAD_POOL_H_
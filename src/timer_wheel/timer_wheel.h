@@ -0,0 +1,349 @@
+#ifndef CPP2_S21_CONTAINERS_1_TIMER_WHEEL_TIMER_WHEEL_H_
+#define CPP2_S21_CONTAINERS_1_TIMER_WHEEL_TIMER_WHEEL_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+#include "../vector/vector.h"
+
+namespace s21 {
+
+// Hierarchical timing wheel over integer ticks. Level L has 64 slots of
+// 64^L ticks each; eleven levels cover the whole 64-bit range, so any
+// deadline can be placed without an overflow list. A timer sits in the
+// level of the highest 6-bit digit in which its deadline differs from the
+// next tick to process, and is moved one or more levels down ("cascaded")
+// when time reaches the start of its slot.
+//
+// Timers live in slab vectors and are chained into their slot through
+// indices, so schedule, cancel and reschedule are O(1) and allocate
+// nothing once the slab has grown. One occupancy bitmap per level lets
+// advance() jump straight to the next non-empty slot instead of walking
+// every tick. Handles follow indexed_priority_queue: valid until the timer
+// fires or is cancelled, then recycled. Once time reaches the last tick
+// there is no next one; every timer scheduled after that is already due.
+template <typename T>
+class timer_wheel {
+ public:
+  using value_type = T;
+  using reference = T &;
+  using const_reference = const T &;
+  using size_type = size_t;
+  using time_type = uint64_t;
+  using handle_type = size_t;
+
+  explicit timer_wheel(time_type now = 0)
+      : next_(now == kMaxTime ? now : now + 1),
+        exhausted_(now == kMaxTime),
+        size_(0) {
+    for (size_type i = 0; i < kLists; ++i) {
+      heads_[i] = kNil;
+    }
+    for (size_type i = 0; i < kLevels; ++i) {
+      occupied_[i] = 0;
+    }
+  }
+
+  // The last tick that has been processed.
+  time_type now() const noexcept { return exhausted_ ? kMaxTime : next_ - 1; }
+
+  bool empty() const noexcept { return size_ == 0; }
+
+  size_type size() const noexcept { return size_; }
+
+  bool contains(handle_type handle) const noexcept {
+    return handle < nodes_.size() && nodes_[handle].list_ != kNil;
+  }
+
+  const_reference get(handle_type handle) const {
+    checkHandle(handle);
+    return *values_[handle];
+  }
+
+  time_type deadline(handle_type handle) const {
+    checkHandle(handle);
+    return nodes_[handle].deadline_;
+  }
+
+  // A deadline that is not after now() fires on the next advance().
+  handle_type schedule(time_type deadline, const_reference value) {
+    return emplace(deadline, value);
+  }
+
+  handle_type schedule(time_type deadline, value_type &&value) {
+    return emplace(deadline, std::move(value));
+  }
+
+  template <typename... Args>
+  handle_type emplace(time_type deadline, Args &&...args) {
+    handle_type handle = 0;
+    if (free_.empty()) {
+      handle = values_.size();
+      values_.emplace_back(std::in_place, std::forward<Args>(args)...);
+      nodes_.push_back(Node{0, kNil, kNil, kNil});
+    } else {
+      handle = free_[free_.size() - 1];
+      values_[handle].emplace(std::forward<Args>(args)...);
+      free_.pop_back();
+    }
+    nodes_[handle].deadline_ = deadline;
+    place(handle);
+    ++size_;
+    return handle;
+  }
+
+  bool cancel(handle_type handle) {
+    if (!contains(handle)) {
+      return false;
+    }
+    unlink(handle);
+    release(handle);
+    return true;
+  }
+
+  void reschedule(handle_type handle, time_type deadline) {
+    checkHandle(handle);
+    unlink(handle);
+    nodes_[handle].deadline_ = deadline;
+    place(handle);
+  }
+
+  // Moves time forward to now and appends every timer whose deadline is
+  // not after it to expired, in deadline order (ties in no particular
+  // order). Going backwards in time only flushes already-due timers.
+  size_type advance(time_type now, s21::vector<value_type> &expired) {
+    size_type before = expired.size();
+    drainReady(expired);
+    while (!exhausted_ && next_ <= now) {
+      if ((next_ & kSlotMask) == 0) {
+        cascade();
+        if (occupied_[0] == 0) {
+          time_type event = nextCascade();
+          if (event > now) {
+            passTo(now);
+            break;
+          }
+          next_ = event;
+          continue;
+        }
+      }
+      time_type block_end = next_ | kSlotMask;
+      time_type end = now < block_end ? now : block_end;
+      uint64_t due =
+          occupied_[0] & slotsBetween(next_ & kSlotMask, end & kSlotMask);
+      while (due) {
+        size_type slot = static_cast<size_type>(__builtin_ctzll(due));
+        due &= due - 1;
+        drain(slot, expired);
+      }
+      passTo(end);
+    }
+    return expired.size() - before;
+  }
+
+  s21::vector<value_type> advance(time_type now) {
+    s21::vector<value_type> expired;
+    advance(now, expired);
+    return expired;
+  }
+
+  void clear() {
+    for (size_type list = 0; list < kLists; ++list) {
+      while (heads_[list] != kNil) {
+        handle_type handle = heads_[list];
+        unlink(handle);
+        release(handle);
+      }
+    }
+  }
+
+ private:
+  static constexpr size_type kSlotBits = 6;
+  static constexpr size_type kSlots = size_type(1) << kSlotBits;
+  static constexpr time_type kSlotMask = kSlots - 1;
+  static constexpr size_type kLevels = (64 + kSlotBits - 1) / kSlotBits;
+  // One list per slot plus the list of timers that were already due.
+  static constexpr size_type kReady = kLevels * kSlots;
+  static constexpr size_type kLists = kReady + 1;
+  static constexpr size_type kNil = std::numeric_limits<size_type>::max();
+  static constexpr time_type kMaxTime = std::numeric_limits<time_type>::max();
+
+  struct Node {
+    time_type deadline_;
+    handle_type prev_;
+    handle_type next_;
+    size_type list_;
+  };
+
+  void checkHandle(handle_type handle) const {
+    if (!contains(handle)) {
+      throw std::out_of_range("handle is not in the timer wheel");
+    }
+  }
+
+  static size_type digit(time_type time, size_type level) noexcept {
+    return static_cast<size_type>((time >> (level * kSlotBits)) & kSlotMask);
+  }
+
+  // Bits first..last of a 64-slot bitmap.
+  static uint64_t slotsBetween(time_type first, time_type last) noexcept {
+    uint64_t upto = last == kSlotMask ? ~uint64_t(0)
+                                      : (uint64_t(1) << (last + 1)) - 1;
+    return upto & (~uint64_t(0) << first);
+  }
+
+  void place(handle_type handle) {
+    time_type deadline = nodes_[handle].deadline_;
+    if (exhausted_ || deadline < next_) {
+      link(handle, kReady);
+      return;
+    }
+    time_type diff = deadline ^ next_;
+    size_type level =
+        diff ? static_cast<size_type>(63 - __builtin_clzll(diff)) / kSlotBits
+             : 0;
+    link(handle, level * kSlots + digit(deadline, level));
+  }
+
+  void link(handle_type handle, size_type list) {
+    Node &node = nodes_[handle];
+    node.list_ = list;
+    node.prev_ = kNil;
+    node.next_ = heads_[list];
+    if (node.next_ != kNil) {
+      nodes_[node.next_].prev_ = handle;
+    }
+    heads_[list] = handle;
+    if (list != kReady) {
+      occupied_[list / kSlots] |= uint64_t(1) << (list % kSlots);
+    }
+  }
+
+  void unlink(handle_type handle) {
+    Node &node = nodes_[handle];
+    if (node.prev_ != kNil) {
+      nodes_[node.prev_].next_ = node.next_;
+    } else {
+      heads_[node.list_] = node.next_;
+      if (node.next_ == kNil && node.list_ != kReady) {
+        occupied_[node.list_ / kSlots] &=
+            ~(uint64_t(1) << (node.list_ % kSlots));
+      }
+    }
+    if (node.next_ != kNil) {
+      nodes_[node.next_].prev_ = node.prev_;
+    }
+    node.list_ = kNil;
+  }
+
+  void release(handle_type handle) {
+    values_[handle].reset();
+    free_.push_back(handle);
+    --size_;
+  }
+
+  void drain(size_type list, s21::vector<value_type> &expired) {
+    while (heads_[list] != kNil) {
+      handle_type handle = heads_[list];
+      unlink(handle);
+      expired.push_back(std::move(*values_[handle]));
+      release(handle);
+    }
+  }
+
+  // Timers that were due when scheduled, in deadline order. The list is
+  // built newest first, so walking it backwards restores scheduling order
+  // for equal deadlines.
+  void drainReady(s21::vector<value_type> &expired) {
+    if (heads_[kReady] == kNil) {
+      return;
+    }
+    s21::vector<handle_type> order;
+    for (handle_type handle = heads_[kReady]; handle != kNil;
+         handle = nodes_[handle].next_) {
+      order.push_back(handle);
+    }
+    std::reverse(order.data(), order.data() + order.size());
+    std::stable_sort(order.data(), order.data() + order.size(),
+                     [this](handle_type lhs, handle_type rhs) {
+                       return nodes_[lhs].deadline_ < nodes_[rhs].deadline_;
+                     });
+    for (size_type i = 0; i < order.size(); ++i) {
+      unlink(order[i]);
+      expired.push_back(std::move(*values_[order[i]]));
+      release(order[i]);
+    }
+  }
+
+  // Marks every tick up to last as processed.
+  void passTo(time_type last) noexcept {
+    if (last == kMaxTime) {
+      next_ = kMaxTime;
+      exhausted_ = true;
+    } else {
+      next_ = last + 1;
+    }
+  }
+
+  // next_ has just entered a new level-0 block: every level whose lower
+  // digits are all zero has reached a new slot, whose timers now belong
+  // lower down.
+  void cascade() {
+    for (size_type level = 1; level < kLevels; ++level) {
+      if (level * kSlotBits < 64 &&
+          (next_ & ((time_type(1) << (level * kSlotBits)) - 1)) != 0) {
+        break;
+      }
+      size_type list = level * kSlots + digit(next_, level);
+      while (heads_[list] != kNil) {
+        handle_type handle = heads_[list];
+        unlink(handle);
+        place(handle);
+      }
+    }
+  }
+
+  // Occupied slots on level L always lie after next_'s digit on that level,
+  // so the earliest of them across levels is the next time anything can
+  // move. Returns the maximum time when the wheel is empty.
+  time_type nextCascade() const noexcept {
+    time_type best = std::numeric_limits<time_type>::max();
+    for (size_type level = 1; level < kLevels; ++level) {
+      size_type current = digit(next_, level);
+      uint64_t later = current == kSlotMask
+                           ? 0
+                           : occupied_[level] & (~uint64_t(0) << (current + 1));
+      if (later == 0) {
+        continue;
+      }
+      size_type shift = level * kSlotBits;
+      size_type above = shift + kSlotBits;
+      time_type prefix = above < 64 ? next_ >> above << above : 0;
+      time_type event = prefix | (time_type(__builtin_ctzll(later)) << shift);
+      if (event < best) {
+        best = event;
+      }
+    }
+    return best;
+  }
+
+ private:
+  // Slots of free handles are empty.
+  s21::vector<std::optional<value_type>> values_;
+  s21::vector<Node> nodes_;
+  s21::vector<handle_type> free_;
+  handle_type heads_[kLists];
+  uint64_t occupied_[kLevels];
+  time_type next_;
+  bool exhausted_;
+  size_type size_;
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_TIMER_WHEEL_TIMER_WHEEL_H_
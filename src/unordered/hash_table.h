@@ -0,0 +1,661 @@
+#ifndef CPP2_S21_CONTAINERS_1_UNORDERED_HASH_TABLE_H_
+#define CPP2_S21_CONTAINERS_1_UNORDERED_HASH_TABLE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "../../utils/is_transparent.h"
+
+namespace s21 {
+
+// A bit per slot of a 16-slot window of control bytes. Each slot has
+// one byte: kEmpty, kDeleted (a tombstone), or seven bits of the hash of
+// the element in it.
+class HashGroup {
+ public:
+  static constexpr size_t kWidth = 16;
+  static constexpr int8_t kEmpty = -128;
+  static constexpr int8_t kDeleted = -2;
+
+  explicit HashGroup(const int8_t *ctrl) noexcept {
+#ifdef __SSE2__
+    ctrl_ = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ctrl));
+#else
+    std::memcpy(ctrl_, ctrl, kWidth);
+#endif
+  }
+
+  uint32_t match(int8_t h2) const noexcept {
+#ifdef __SSE2__
+    return static_cast<uint32_t>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl_)));
+#else
+    return maskOf([h2](int8_t ctrl) { return ctrl == h2; });
+#endif
+  }
+
+  uint32_t maskEmpty() const noexcept { return match(kEmpty); }
+
+  // Empty and deleted bytes are the negative ones other than -1.
+  uint32_t maskEmptyOrDeleted() const noexcept {
+#ifdef __SSE2__
+    return static_cast<uint32_t>(
+        _mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(-1), ctrl_)));
+#else
+    return maskOf([](int8_t ctrl) { return ctrl < -1; });
+#endif
+  }
+
+  uint32_t maskFull() const noexcept {
+#ifdef __SSE2__
+    return static_cast<uint32_t>(~_mm_movemask_epi8(ctrl_)) & 0xFFFFu;
+#else
+    return maskOf([](int8_t ctrl) { return ctrl >= 0; });
+#endif
+  }
+
+ private:
+#ifdef __SSE2__
+  __m128i ctrl_;
+#else
+  template <typename Predicate>
+  uint32_t maskOf(Predicate predicate) const noexcept {
+    uint32_t mask = 0;
+    for (size_t i = 0; i < kWidth; ++i) {
+      mask |= static_cast<uint32_t>(predicate(ctrl_[i])) << i;
+    }
+    return mask;
+  }
+
+  int8_t ctrl_[kWidth];
+#endif
+};
+
+// Open-addressing table shared by unordered_map and unordered_set, laid out
+// like a Swiss table: elements sit directly in one slot array and a
+// parallel array of control bytes holds seven hash bits per slot. A lookup
+// checks sixteen control bytes at once with SSE2 compares, and only slots
+// whose byte matches are compared by key, so most probes touch the key
+// array once. The capacity is a power of two kept at most 7/8 full; the
+// first 16 control bytes are cloned past the end so any window can be
+// loaded without wrapping.
+//
+// Erasing leaves a tombstone only when the slot sits inside a run of 16
+// occupied slots, the one case in which a probe could have passed it;
+// otherwise the slot goes back to empty. When tombstones exhaust the free
+// slots, the table is rebuilt at the same capacity instead of growing.
+//
+// Insertions may rehash and invalidate iterators; erasures invalidate only
+// iterators to the erased element.
+//
+// KeyOf maps an element to its key through a static of().
+template <typename Key, typename Value, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+class HashTable {
+  static constexpr size_t kWidth = HashGroup::kWidth;
+  static constexpr size_t kMinCapacity = kWidth;
+  static constexpr int8_t kEmpty = HashGroup::kEmpty;
+  static constexpr int8_t kDeleted = HashGroup::kDeleted;
+  static constexpr bool kTransparent =
+      is_transparent_v<Hash> && is_transparent_v<KeyEqual>;
+
+  using ctrl_allocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<int8_t>;
+
+  template <bool kConst>
+  class Iterator {
+    friend class HashTable;
+    template <bool>
+    friend class Iterator;
+
+   public:
+    using value_type = Value;
+    using difference_type = ptrdiff_t;
+    using pointer = std::conditional_t<kConst, const Value *, Value *>;
+    using reference = std::conditional_t<kConst, const Value &, Value &>;
+    using iterator_category = std::forward_iterator_tag;
+
+    Iterator() : table_(nullptr), index_(0) {}
+
+    template <bool kOther, std::enable_if_t<kConst && !kOther, int> = 0>
+    Iterator(const Iterator<kOther> &other)
+        : table_(other.table_), index_(other.index_) {}
+
+    reference operator*() const { return table_->slots_[index_]; }
+    pointer operator->() const { return table_->slots_ + index_; }
+
+    Iterator &operator++() {
+      index_ = table_->nextFull(index_ + 1);
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      Iterator temp = *this;
+      ++(*this);
+      return temp;
+    }
+
+    bool operator==(const Iterator &rhs) const noexcept {
+      return index_ == rhs.index_;
+    }
+
+    bool operator!=(const Iterator &rhs) const noexcept {
+      return index_ != rhs.index_;
+    }
+
+   private:
+    Iterator(const HashTable *table, size_t index)
+        : table_(table), index_(index) {}
+
+    const HashTable *table_;
+    // capacity_ for end().
+    size_t index_;
+  };
+
+ public:
+  using key_type = Key;
+  using value_type = Value;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  // Set elements are keys, so even the plain iterator is read-only.
+  using iterator = Iterator<std::is_same_v<Key, Value>>;
+  using const_iterator = Iterator<true>;
+  using size_type = size_t;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+  using allocator_type = Allocator;
+
+  explicit HashTable(size_type bucket_count = 0, const Hash &hash = Hash(),
+                     const KeyEqual &equal = KeyEqual(),
+                     const Allocator &alloc = Allocator())
+      : hash_(hash),
+        equal_(equal),
+        allocator_(alloc),
+        ctrl_allocator_(alloc),
+        ctrl_(nullptr),
+        slots_(nullptr),
+        capacity_(0),
+        size_(0),
+        growth_left_(0) {
+    if (bucket_count > 0) {
+      rehash(bucket_count);
+    }
+  }
+
+  HashTable(const HashTable &other)
+      : hash_(other.hash_),
+        equal_(other.equal_),
+        allocator_(std::allocator_traits<Allocator>::
+                       select_on_container_copy_construction(other.allocator_)),
+        ctrl_allocator_(allocator_),
+        ctrl_(nullptr),
+        slots_(nullptr),
+        capacity_(0),
+        size_(0),
+        growth_left_(0) {
+    if (other.size_ == 0) {
+      return;
+    }
+    // Same capacity and positions, so nothing is hashed again.
+    allocateArrays(other.capacity_);
+    size_type index = 0;
+    try {
+      for (; index < capacity_; ++index) {
+        if (other.ctrl_[index] >= 0) {
+          std::allocator_traits<Allocator>::construct(
+              allocator_, slots_ + index, other.slots_[index]);
+        }
+      }
+    } catch (...) {
+      for (size_type i = 0; i < index; ++i) {
+        if (other.ctrl_[i] >= 0) {
+          std::allocator_traits<Allocator>::destroy(allocator_, slots_ + i);
+        }
+      }
+      deallocateArrays(ctrl_, slots_, capacity_);
+      throw;
+    }
+    std::memcpy(ctrl_, other.ctrl_, capacity_ + kWidth);
+    size_ = other.size_;
+    growth_left_ = other.growth_left_;
+  }
+
+  HashTable(HashTable &&other) noexcept
+      : hash_(std::move(other.hash_)),
+        equal_(std::move(other.equal_)),
+        allocator_(std::move(other.allocator_)),
+        ctrl_allocator_(std::move(other.ctrl_allocator_)),
+        ctrl_(std::exchange(other.ctrl_, nullptr)),
+        slots_(std::exchange(other.slots_, nullptr)),
+        capacity_(std::exchange(other.capacity_, 0)),
+        size_(std::exchange(other.size_, 0)),
+        growth_left_(std::exchange(other.growth_left_, 0)) {}
+
+  ~HashTable() {
+    destroyAll();
+    if (capacity_) {
+      deallocateArrays(ctrl_, slots_, capacity_);
+    }
+  }
+
+  HashTable &operator=(const HashTable &other) {
+    if (this != &other) {
+      HashTable copy(other);
+      swap(copy);
+    }
+    return *this;
+  }
+
+  HashTable &operator=(HashTable &&other) noexcept {
+    if (this != &other) {
+      HashTable moved(std::move(other));
+      swap(moved);
+    }
+    return *this;
+  }
+
+  iterator begin() noexcept { return iterator(this, nextFull(0)); }
+  const_iterator begin() const noexcept {
+    return const_iterator(this, nextFull(0));
+  }
+  iterator end() noexcept { return iterator(this, capacity_); }
+  const_iterator end() const noexcept {
+    return const_iterator(this, capacity_);
+  }
+
+  bool empty() const noexcept { return size_ == 0; }
+  size_type size() const noexcept { return size_; }
+  size_type max_size() const noexcept {
+    return std::numeric_limits<size_type>::max() / (sizeof(value_type) + 1);
+  }
+
+  // Destroys the elements but keeps the arrays for reuse.
+  void clear() noexcept {
+    destroyAll();
+    if (capacity_) {
+      std::memset(ctrl_, kEmpty, capacity_ + kWidth);
+      growth_left_ = maxLoad(capacity_);
+    }
+    size_ = 0;
+  }
+
+  void swap(HashTable &other) noexcept {
+    std::swap(hash_, other.hash_);
+    std::swap(equal_, other.equal_);
+    std::swap(allocator_, other.allocator_);
+    std::swap(ctrl_allocator_, other.ctrl_allocator_);
+    std::swap(ctrl_, other.ctrl_);
+    std::swap(slots_, other.slots_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(size_, other.size_);
+    std::swap(growth_left_, other.growth_left_);
+  }
+
+  iterator find(const key_type &key) { return iterator(this, findIndex(key)); }
+  const_iterator find(const key_type &key) const {
+    return const_iterator(this, findIndex(key));
+  }
+
+  template <typename K, bool kOk = kTransparent,
+            std::enable_if_t<kOk, int> = 0>
+  iterator find(const K &key) {
+    return iterator(this, findIndex(key));
+  }
+
+  template <typename K, bool kOk = kTransparent,
+            std::enable_if_t<kOk, int> = 0>
+  const_iterator find(const K &key) const {
+    return const_iterator(this, findIndex(key));
+  }
+
+  bool contains(const key_type &key) const {
+    return findIndex(key) != capacity_;
+  }
+
+  template <typename K, bool kOk = kTransparent,
+            std::enable_if_t<kOk, int> = 0>
+  bool contains(const K &key) const {
+    return findIndex(key) != capacity_;
+  }
+
+  size_type count(const key_type &key) const { return contains(key) ? 1 : 0; }
+
+  template <typename K, bool kOk = kTransparent,
+            std::enable_if_t<kOk, int> = 0>
+  size_type count(const K &key) const {
+    return contains(key) ? 1 : 0;
+  }
+
+  std::pair<iterator, iterator> equal_range(const key_type &key) {
+    iterator first = find(key);
+    iterator last = first;
+    if (last != end()) {
+      ++last;
+    }
+    return std::make_pair(first, last);
+  }
+
+  std::pair<const_iterator, const_iterator> equal_range(
+      const key_type &key) const {
+    const_iterator first = find(key);
+    const_iterator last = first;
+    if (last != end()) {
+      ++last;
+    }
+    return std::make_pair(first, last);
+  }
+
+  iterator erase(const_iterator pos) {
+    eraseAt(pos.index_);
+    return iterator(this, nextFull(pos.index_ + 1));
+  }
+
+  size_type erase(const key_type &key) {
+    size_type index = findIndex(key);
+    if (index == capacity_) {
+      return 0;
+    }
+    eraseAt(index);
+    return 1;
+  }
+
+  template <typename K, bool kOk = kTransparent,
+            std::enable_if_t<kOk, int> = 0>
+  size_type erase(const K &key) {
+    size_type index = findIndex(key);
+    if (index == capacity_) {
+      return 0;
+    }
+    eraseAt(index);
+    return 1;
+  }
+
+  // Makes room for count elements without another rehash.
+  void reserve(size_type count) {
+    if (count > size_ + growth_left_) {
+      resize(capacityFor(count, 0));
+    }
+  }
+
+  // Rebuilds the table with at least bucket_count slots, and enough for
+  // the current elements; this also clears out tombstones.
+  void rehash(size_type bucket_count) {
+    if (capacity_ == 0 && bucket_count == 0) {
+      return;
+    }
+    size_type capacity = capacityFor(size_, bucket_count);
+    if (capacity != capacity_ || size_ + growth_left_ < maxLoad(capacity_)) {
+      resize(capacity);
+    }
+  }
+
+  size_type bucket_count() const noexcept { return capacity_; }
+
+  float load_factor() const noexcept {
+    return capacity_ ? static_cast<float>(size_) / capacity_ : 0.0f;
+  }
+
+  float max_load_factor() const noexcept { return 0.875f; }
+
+  Hash hash_function() const { return hash_; }
+  KeyEqual key_eq() const { return equal_; }
+
+ protected:
+  // Inserts an element built from args unless key is already present.
+  // When the table has to grow, the element is built first, so args may
+  // refer to elements of this table.
+  template <typename K, typename... Args>
+  std::pair<iterator, bool> emplaceUnique(const K &key, Args &&...args) {
+    size_t hash = mix(key);
+    size_type index = findIndex(key, hash);
+    if (index != capacity_) {
+      return std::make_pair(iterator(this, index), false);
+    }
+    index = capacity_ ? firstNonFull(hash) : 0;
+    if (capacity_ == 0 || (growth_left_ == 0 && ctrl_[index] != kDeleted)) {
+      Value value(std::forward<Args>(args)...);
+      grow();
+      index = firstNonFull(hash);
+      constructAt(index, hash, std::move(value));
+    } else {
+      constructAt(index, hash, std::forward<Args>(args)...);
+    }
+    return std::make_pair(iterator(this, index), true);
+  }
+
+ private:
+  // Spreads the hash over all bits: std::hash is the identity for
+  // integers, which would leave the control bytes and the probe start
+  // depending on the same few low bits.
+  template <typename K>
+  size_t mix(const K &key) const {
+    uint64_t hash = static_cast<uint64_t>(hash_(key));
+    hash *= 0x9E3779B97F4A7C15ull;
+    return static_cast<size_t>(hash ^ (hash >> 32));
+  }
+
+  // The top seven bits go to the control byte and the rest pick the start.
+  static int8_t h2(size_t hash) noexcept {
+    return static_cast<int8_t>(hash >> (sizeof(size_t) * 8 - 7));
+  }
+
+  static size_type maxLoad(size_type capacity) noexcept {
+    return capacity - capacity / 8;
+  }
+
+  static size_type capacityFor(size_type count, size_type bucket_count) {
+    size_type capacity = kMinCapacity;
+    while (capacity < bucket_count || maxLoad(capacity) < count) {
+      capacity *= 2;
+    }
+    return capacity;
+  }
+
+  // Groups are visited at triangular offsets, which on a power-of-two
+  // table reach every group before repeating.
+  template <typename K>
+  size_type findIndex(const K &key) const {
+    return capacity_ ? findIndex(key, mix(key)) : capacity_;
+  }
+
+  template <typename K>
+  size_type findIndex(const K &key, size_t hash) const {
+    if (capacity_ == 0) {
+      return capacity_;
+    }
+    size_type mask = capacity_ - 1;
+    size_type offset = hash & mask;
+    int8_t tag = h2(hash);
+    for (size_type step = kWidth;; step += kWidth) {
+      HashGroup group(ctrl_ + offset);
+      for (uint32_t match = group.match(tag); match; match &= match - 1) {
+        size_type index = (offset + __builtin_ctz(match)) & mask;
+        if (equal_(key, KeyOf::of(slots_[index]))) {
+          return index;
+        }
+      }
+      if (group.maskEmpty()) {
+        return capacity_;
+      }
+      offset = (offset + step) & mask;
+    }
+  }
+
+  size_type firstNonFull(size_t hash) const noexcept {
+    size_type mask = capacity_ - 1;
+    size_type offset = hash & mask;
+    for (size_type step = kWidth;; step += kWidth) {
+      uint32_t free = HashGroup(ctrl_ + offset).maskEmptyOrDeleted();
+      if (free) {
+        return (offset + __builtin_ctz(free)) & mask;
+      }
+      offset = (offset + step) & mask;
+    }
+  }
+
+  // The first full slot at or after index, or capacity_.
+  size_type nextFull(size_type index) const noexcept {
+    while (index < capacity_) {
+      uint32_t full = HashGroup(ctrl_ + index).maskFull();
+      if (full) {
+        index += __builtin_ctz(full);
+        return index < capacity_ ? index : capacity_;
+      }
+      index += kWidth;
+    }
+    return capacity_;
+  }
+
+  void setCtrl(size_type index, int8_t value) noexcept {
+    ctrl_[index] = value;
+    if (index < kWidth) {
+      ctrl_[capacity_ + index] = value;
+    }
+  }
+
+  template <typename... Args>
+  void constructAt(size_type index, size_t hash, Args &&...args) {
+    std::allocator_traits<Allocator>::construct(allocator_, slots_ + index,
+                                                std::forward<Args>(args)...);
+    if (ctrl_[index] == kEmpty) {
+      --growth_left_;
+    }
+    setCtrl(index, h2(hash));
+    ++size_;
+  }
+
+  // No window of 16 slots holding index is entirely full when there are
+  // empty slots on both sides closer together than that; every probe that
+  // got here then stopped at one of them, so the slot can become empty.
+  void eraseAt(size_type index) noexcept {
+    std::allocator_traits<Allocator>::destroy(allocator_, slots_ + index);
+    --size_;
+    size_type before = (index - kWidth) & (capacity_ - 1);
+    uint32_t empty_after = HashGroup(ctrl_ + index).maskEmpty();
+    uint32_t empty_before = HashGroup(ctrl_ + before).maskEmpty();
+    bool never_full =
+        empty_after && empty_before &&
+        static_cast<size_type>(__builtin_ctz(empty_after) +
+                               __builtin_clz(empty_before) - 16) < kWidth;
+    if (never_full) {
+      setCtrl(index, kEmpty);
+      ++growth_left_;
+    } else {
+      setCtrl(index, kDeleted);
+    }
+  }
+
+  // Called when the free slots are used up. While the elements fill at
+  // most 25/32 of the slots the rest are mostly tombstones, and rebuilding
+  // at the same capacity is enough.
+  void grow() {
+    if (capacity_ == 0) {
+      resize(kMinCapacity);
+    } else if (size_ * 32 <= capacity_ * 25) {
+      resize(capacity_);
+    } else {
+      resize(capacity_ * 2);
+    }
+  }
+
+  // Moves every element into fresh arrays of the given capacity. Elements
+  // whose move may throw are copied, so a failure leaves the table as it
+  // was.
+  void resize(size_type capacity) {
+    int8_t *old_ctrl = ctrl_;
+    Value *old_slots = slots_;
+    size_type old_capacity = capacity_;
+    size_type old_growth = growth_left_;
+    allocateArrays(capacity);
+    size_type index = 0;
+    try {
+      for (; index < old_capacity; ++index) {
+        if (old_ctrl[index] >= 0) {
+          size_t hash = mix(KeyOf::of(old_slots[index]));
+          size_type target = firstNonFull(hash);
+          std::allocator_traits<Allocator>::construct(
+              allocator_, slots_ + target,
+              std::move_if_noexcept(old_slots[index]));
+          setCtrl(target, h2(hash));
+          --growth_left_;
+        }
+      }
+    } catch (...) {
+      for (size_type i = 0; i < capacity_; ++i) {
+        if (ctrl_[i] >= 0) {
+          std::allocator_traits<Allocator>::destroy(allocator_, slots_ + i);
+        }
+      }
+      deallocateArrays(ctrl_, slots_, capacity_);
+      ctrl_ = old_ctrl;
+      slots_ = old_slots;
+      capacity_ = old_capacity;
+      growth_left_ = old_growth;
+      throw;
+    }
+    for (size_type i = 0; i < old_capacity; ++i) {
+      if (old_ctrl[i] >= 0) {
+        std::allocator_traits<Allocator>::destroy(allocator_, old_slots + i);
+      }
+    }
+    if (old_capacity) {
+      deallocateArrays(old_ctrl, old_slots, old_capacity);
+    }
+  }
+
+  void allocateArrays(size_type capacity) {
+    int8_t *ctrl = std::allocator_traits<ctrl_allocator>::allocate(
+        ctrl_allocator_, capacity + kWidth);
+    try {
+      slots_ = std::allocator_traits<Allocator>::allocate(allocator_, capacity);
+    } catch (...) {
+      std::allocator_traits<ctrl_allocator>::deallocate(ctrl_allocator_, ctrl,
+                                                        capacity + kWidth);
+      throw;
+    }
+    ctrl_ = ctrl;
+    std::memset(ctrl_, kEmpty, capacity + kWidth);
+    capacity_ = capacity;
+    growth_left_ = maxLoad(capacity);
+  }
+
+  void deallocateArrays(int8_t *ctrl, Value *slots,
+                        size_type capacity) noexcept {
+    std::allocator_traits<ctrl_allocator>::deallocate(ctrl_allocator_, ctrl,
+                                                      capacity + kWidth);
+    std::allocator_traits<Allocator>::deallocate(allocator_, slots, capacity);
+  }
+
+  void destroyAll() noexcept {
+    for (size_type i = 0; i < capacity_; ++i) {
+      if (ctrl_[i] >= 0) {
+        std::allocator_traits<Allocator>::destroy(allocator_, slots_ + i);
+      }
+    }
+  }
+
+  Hash hash_;
+  KeyEqual equal_;
+  Allocator allocator_;
+  ctrl_allocator ctrl_allocator_;
+  int8_t *ctrl_;
+  Value *slots_;
+  size_type capacity_;
+  size_type size_;
+  // Empty slots that may still be filled before the table must grow.
+  size_type growth_left_;
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_UNORDERED_HASH_TABLE_H_
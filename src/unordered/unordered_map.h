@@ -0,0 +1,180 @@
+#ifndef CPP2_S21_CONTAINERS_1_UNORDERED_UNORDERED_MAP_H_
+#define CPP2_S21_CONTAINERS_1_UNORDERED_UNORDERED_MAP_H_
+
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "hash_table.h"
+
+namespace s21 {
+
+template <typename Key, typename T>
+struct HashMapKey {
+  static const Key &of(const std::pair<const Key, T> &item) noexcept {
+    return item.first;
+  }
+};
+
+// Hash map for lookups that do not need order; see HashTable for the
+// layout. Insertions may invalidate every iterator and reference.
+template <class Key, class T, class Hash = std::hash<Key>,
+          class KeyEqual = std::equal_to<Key>,
+          class Allocator = std::allocator<std::pair<const Key, T>>>
+class unordered_map
+    : public HashTable<Key, std::pair<const Key, T>, HashMapKey<Key, T>, Hash,
+                       KeyEqual, Allocator> {
+  using Base = HashTable<Key, std::pair<const Key, T>, HashMapKey<Key, T>,
+                         Hash, KeyEqual, Allocator>;
+
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using iterator = typename Base::iterator;
+  using const_iterator = typename Base::const_iterator;
+  using size_type = size_t;
+
+  unordered_map() : Base() {}
+
+  explicit unordered_map(size_type bucket_count, const Hash &hash = Hash(),
+                         const KeyEqual &equal = KeyEqual(),
+                         const Allocator &alloc = Allocator())
+      : Base(bucket_count, hash, equal, alloc) {}
+
+  unordered_map(std::initializer_list<value_type> const &items)
+      : Base(items.size()) {
+    insert(items.begin(), items.end());
+  }
+
+  mapped_type &at(const key_type &key) {
+    iterator it = this->find(key);
+    if (it == this->end()) {
+      throw std::out_of_range("Key not in map");
+    }
+    return it->second;
+  }
+
+  const mapped_type &at(const key_type &key) const {
+    const_iterator it = this->find(key);
+    if (it == this->end()) {
+      throw std::out_of_range("Key not in map");
+    }
+    return it->second;
+  }
+
+  // Inserts a value-initialised element when key is missing.
+  mapped_type &operator[](const key_type &key) {
+    return try_emplace(key).first->second;
+  }
+
+  mapped_type &operator[](key_type &&key) {
+    return try_emplace(std::move(key)).first->second;
+  }
+
+  std::pair<iterator, bool> insert(const_reference value) {
+    return this->emplaceUnique(value.first, value);
+  }
+
+  std::pair<iterator, bool> insert(value_type &&value) {
+    return this->emplaceUnique(value.first, std::move(value));
+  }
+
+  std::pair<iterator, bool> insert(const key_type &key,
+                                   const mapped_type &obj) {
+    return this->emplaceUnique(key, key, obj);
+  }
+
+  template <typename InputIt>
+  void insert(InputIt first, InputIt last) {
+    for (; first != last; ++first) {
+      insert(*first);
+    }
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args) {
+    value_type value(std::forward<Args>(args)...);
+    return this->emplaceUnique(value.first, std::move(value));
+  }
+
+  // Builds the mapped value from args only if key is missing; when it is
+  // present, args are not touched (so nothing is moved from).
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const key_type &key, Args &&...args) {
+    return this->emplaceUnique(
+        key, std::piecewise_construct, std::forward_as_tuple(key),
+        std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(key_type &&key, Args &&...args) {
+    return this->emplaceUnique(
+        key, std::piecewise_construct, std::forward_as_tuple(std::move(key)),
+        std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(const key_type &key, M &&obj) {
+    std::pair<iterator, bool> result = try_emplace(key, std::forward<M>(obj));
+    if (!result.second) {
+      result.first->second = std::forward<M>(obj);
+    }
+    return result;
+  }
+
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(key_type &&key, M &&obj) {
+    std::pair<iterator, bool> result =
+        try_emplace(std::move(key), std::forward<M>(obj));
+    if (!result.second) {
+      result.first->second = std::forward<M>(obj);
+    }
+    return result;
+  }
+
+  void swap(unordered_map &other) noexcept { Base::swap(other); }
+
+  // Moves in the elements of other whose keys are missing here; the rest
+  // stay in other.
+  void merge(unordered_map &other) {
+    if (this == &other) {
+      return;
+    }
+    this->reserve(this->size() + other.size());
+    for (auto it = other.begin(); it != other.end();) {
+      if (this->contains(it->first)) {
+        ++it;
+      } else {
+        try_emplace(it->first, std::move(it->second));
+        it = other.erase(it);
+      }
+    }
+  }
+
+  // Each insertion may rehash, so the iterators are looked up again once
+  // everything is in.
+  template <typename... Args>
+  std::vector<std::pair<iterator, bool>> insert_many(Args &&...args) {
+    std::vector<std::pair<iterator, bool>> return_vector;
+    std::vector<key_type> keys;
+    for (auto &item : {args...}) {
+      return_vector.push_back(insert(item));
+      keys.push_back(item.first);
+    }
+    for (size_t i = 0; i < keys.size(); ++i) {
+      return_vector[i].first = this->find(keys[i]);
+    }
+    return return_vector;
+  }
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_UNORDERED_UNORDERED_MAP_H_
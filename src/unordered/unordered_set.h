@@ -0,0 +1,107 @@
+#ifndef CPP2_S21_CONTAINERS_1_UNORDERED_UNORDERED_SET_H_
+#define CPP2_S21_CONTAINERS_1_UNORDERED_UNORDERED_SET_H_
+
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "hash_table.h"
+
+namespace s21 {
+
+template <typename Key>
+struct HashSetKey {
+  static const Key &of(const Key &item) noexcept { return item; }
+};
+
+// Hash set for membership tests that do not need order; see HashTable for
+// the layout. Insertions may invalidate every iterator.
+template <class Key, class Hash = std::hash<Key>,
+          class KeyEqual = std::equal_to<Key>,
+          class Allocator = std::allocator<Key>>
+class unordered_set
+    : public HashTable<Key, Key, HashSetKey<Key>, Hash, KeyEqual, Allocator> {
+  using Base = HashTable<Key, Key, HashSetKey<Key>, Hash, KeyEqual, Allocator>;
+
+ public:
+  using key_type = Key;
+  using value_type = Key;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using iterator = typename Base::iterator;
+  using const_iterator = typename Base::const_iterator;
+  using size_type = size_t;
+
+  unordered_set() : Base() {}
+
+  explicit unordered_set(size_type bucket_count, const Hash &hash = Hash(),
+                         const KeyEqual &equal = KeyEqual(),
+                         const Allocator &alloc = Allocator())
+      : Base(bucket_count, hash, equal, alloc) {}
+
+  unordered_set(std::initializer_list<value_type> const &items)
+      : Base(items.size()) {
+    insert(items.begin(), items.end());
+  }
+
+  std::pair<iterator, bool> insert(const value_type &value) {
+    return this->emplaceUnique(value, value);
+  }
+
+  std::pair<iterator, bool> insert(value_type &&value) {
+    return this->emplaceUnique(value, std::move(value));
+  }
+
+  template <typename InputIt>
+  void insert(InputIt first, InputIt last) {
+    for (; first != last; ++first) {
+      insert(*first);
+    }
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args) {
+    value_type value(std::forward<Args>(args)...);
+    return this->emplaceUnique(value, std::move(value));
+  }
+
+  void swap(unordered_set &other) noexcept { Base::swap(other); }
+
+  // Takes the keys of other that are missing here; the rest stay in other.
+  void merge(unordered_set &other) {
+    if (this == &other) {
+      return;
+    }
+    this->reserve(this->size() + other.size());
+    for (auto it = other.begin(); it != other.end();) {
+      if (this->contains(*it)) {
+        ++it;
+      } else {
+        insert(*it);
+        it = other.erase(it);
+      }
+    }
+  }
+
+  // Each insertion may rehash, so the iterators are looked up again once
+  // everything is in.
+  template <typename... Args>
+  std::vector<std::pair<iterator, bool>> insert_many(Args &&...args) {
+    std::vector<std::pair<iterator, bool>> return_vector;
+    std::vector<value_type> keys;
+    for (auto &item : {args...}) {
+      return_vector.push_back(insert(item));
+      keys.push_back(item);
+    }
+    for (size_t i = 0; i < keys.size(); ++i) {
+      return_vector[i].first = this->find(keys[i]);
+    }
+    return return_vector;
+  }
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_UNORDERED_UNORDERED_SET_H_
@@ -90,7 +90,7 @@ class vector {
   vector &operator=(vector &&rhs) noexcept {
     if (this == &rhs) return *this;
     swap(rhs);
-    destroy_objects_in_array(rhs.begin(), rhs.end());
+    rhs.clear();
     return *this;
   }
 
@@ -127,6 +127,8 @@ class vector {
 
   T *data() noexcept { return data_; }
 
+  const T *data() const noexcept { return data_; }
+
   iterator begin() { return iterator(data_); }
 
   const_iterator begin() const { return const_iterator(data_); }
@@ -154,7 +156,8 @@ class vector {
     try {
       for (; it != end(); ++it, ++count_constructed_objects) {
         std::allocator_traits<allocator_type>::construct(
-            allocator_, newArr + count_constructed_objects, *it);
+            allocator_, newArr + count_constructed_objects,
+            std::move_if_noexcept(*it));
       }
     } catch (...) {
       destroy_objects_in_array(newArr, newArr + count_constructed_objects);
@@ -181,7 +184,8 @@ class vector {
     try {
       for (; it != end(); ++it, ++count_constructed_objects) {
         std::allocator_traits<allocator_type>::construct(
-            allocator_, newArr + count_constructed_objects, *it);
+            allocator_, newArr + count_constructed_objects,
+            std::move_if_noexcept(*it));
       }
     } catch (...) {
       destroy_objects_in_array(newArr, newArr + count_constructed_objects);
@@ -202,34 +206,62 @@ class vector {
   }
 
   iterator insert(iterator pos, const_reference value) {
-    size_t index = pos - begin();
-    if (size_ == capacity_) {
-      reserve(capacity_ ? capacity_ * 2 : 1);
+    return emplace(pos, value);
+  }
+
+  // Shifts the tail up by move-assignment, so every slot that is assigned
+  // to holds a live element. The new element is built first because args
+  // may refer into this vector.
+  template <typename... Args>
+  iterator emplace(iterator pos, Args &&...args) {
+    size_type index = pos - begin();
+    if (index == size_) {
+      emplace_back(std::forward<Args>(args)...);
+      return begin() + index;
     }
-    pos = begin() + index;
-    for (auto ptr = end(); ptr != pos; --ptr) {
-      *ptr = std::move(*(ptr - 1));  // !?
+    value_type value(std::forward<Args>(args)...);
+    emplace_back(std::move(data_[size_ - 1]));
+    for (size_type i = size_ - 2; i > index; --i) {
+      data_[i] = std::move(data_[i - 1]);
     }
-    *pos = value;
-    ++size_;
-    return pos;
+    data_[index] = std::move(value);
+    return begin() + index;
   }
 
-  void erase(iterator pos) {
-    destroy_objects_in_array(pos, pos + 1);
-    for (auto ptr = pos; ptr != end(); ++ptr) {
-      *ptr = std::move(*(ptr + 1));
+  void erase(iterator pos) { erase(pos, pos + 1); }
+
+  iterator erase(iterator first, iterator last) {
+    size_type from = first - begin();
+    size_type count = last - first;
+    if (count == 0) {
+      return first;
+    }
+    for (size_type i = from + count; i < size_; ++i) {
+      data_[i - count] = std::move(data_[i]);
     }
-    --size_;
+    destroy_objects_in_array(end() - count, end());
+    size_ -= count;
+    return begin() + from;
   }
 
-  void push_back(const_reference value) {
+  void push_back(const_reference value) { emplace_back(value); }
+
+  void push_back(value_type &&value) { emplace_back(std::move(value)); }
+
+  // The arguments may refer into this vector (v.push_back(v.back())), so
+  // on growth the new element is built before the old storage goes away.
+  template <typename... Args>
+  reference emplace_back(Args &&...args) {
     if (size_ == capacity_) {
+      value_type value(std::forward<Args>(args)...);
       reserve(capacity_ ? capacity_ * 2 : 1);
+      std::allocator_traits<allocator_type>::construct(
+          allocator_, data_ + size_, std::move(value));
+    } else {
+      std::allocator_traits<allocator_type>::construct(
+          allocator_, data_ + size_, std::forward<Args>(args)...);
     }
-    std::allocator_traits<allocator_type>::construct(allocator_, data_ + size_,
-                                                     value);
-    ++size_;
+    return data_[size_++];
   }
 
   void pop_back() {
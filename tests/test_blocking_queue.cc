@@ -0,0 +1,127 @@
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../src/queue/blocking_queue.h"
+
+TEST(BlockingQueue, PushPop) {
+  s21::blocking_queue<std::string> queue(2);
+  ASSERT_TRUE(queue.push("a"));
+  ASSERT_TRUE(queue.try_push("b"));
+  ASSERT_FALSE(queue.try_push("c"));
+  ASSERT_EQ(queue.size(), 2U);
+  std::string value;
+  ASSERT_TRUE(queue.pop(value));
+  ASSERT_EQ(value, "a");
+  ASSERT_TRUE(queue.try_pop(value));
+  ASSERT_EQ(value, "b");
+  ASSERT_FALSE(queue.try_pop(value));
+  ASSERT_TRUE(queue.empty());
+}
+
+TEST(BlockingQueue, PopForTimeout) {
+  s21::blocking_queue<int> queue(4);
+  int value = 0;
+  ASSERT_FALSE(queue.pop_for(value, std::chrono::milliseconds(5)));
+  queue.push(3);
+  ASSERT_TRUE(queue.pop_for(value, std::chrono::milliseconds(5)));
+  ASSERT_EQ(value, 3);
+  std::vector<int> out(4);
+  ASSERT_EQ(queue.pop_bulk_for(out.begin(), 4, std::chrono::milliseconds(5)),
+            0U);
+}
+
+TEST(BlockingQueue, CloseDrains) {
+  s21::blocking_queue<int> queue(8);
+  std::vector<int> input{1, 2, 3};
+  ASSERT_EQ(queue.push_bulk(input.begin(), input.end()), 3U);
+  queue.close();
+  ASSERT_TRUE(queue.is_closed());
+  ASSERT_FALSE(queue.push(4));
+  std::vector<int> out(8);
+  ASSERT_EQ(queue.pop_bulk(out.begin(), 2), 2U);
+  ASSERT_EQ(out[1], 2);
+  int value = 0;
+  ASSERT_TRUE(queue.pop(value));
+  ASSERT_EQ(value, 3);
+  ASSERT_FALSE(queue.pop(value));
+  ASSERT_EQ(queue.pop_bulk(out.begin(), 8), 0U);
+}
+
+TEST(BlockingQueue, CloseWakesWaiters) {
+  s21::blocking_queue<int> queue(1);
+  std::thread consumer([&queue]() {
+    int value = 0;
+    while (queue.pop(value)) {
+    }
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  queue.close();
+  consumer.join();
+  ASSERT_TRUE(queue.empty());
+}
+
+TEST(BlockingQueue, BulkPipeline) {
+  const int count = 200000;
+  s21::blocking_queue<int> queue(256);
+  std::vector<int> input(count);
+  for (int i = 0; i < count; ++i) {
+    input[i] = i;
+  }
+  std::thread producer([&queue, &input]() {
+    for (size_t i = 0; i < input.size(); i += 1000) {
+      queue.push_bulk(input.begin() + i, input.begin() + i + 1000);
+    }
+    queue.close();
+  });
+  std::vector<int> batch(64);
+  int expected = 0;
+  bool ordered = true;
+  size_t n = 0;
+  while ((n = queue.pop_bulk(batch.begin(), batch.size())) != 0) {
+    for (size_t i = 0; i < n; ++i) {
+      ordered = ordered && batch[i] == expected++;
+    }
+  }
+  producer.join();
+  ASSERT_TRUE(ordered);
+  ASSERT_EQ(expected, count);
+}
+
+struct BlockingThrowingValue {
+  BlockingThrowingValue(int v = 0) : value(v) {}
+  BlockingThrowingValue(const BlockingThrowingValue &other)
+      : value(other.value) {
+    if (value < 0) {
+      throw std::runtime_error("copy");
+    }
+  }
+  BlockingThrowingValue &operator=(const BlockingThrowingValue &) = default;
+  int value;
+};
+
+TEST(BlockingQueue, FailedBulkPushWakesConsumers) {
+  s21::blocking_queue<BlockingThrowingValue> queue(8);
+  std::vector<BlockingThrowingValue> got(8);
+  size_t n = 0;
+  std::thread consumer([&queue, &got, &n]() {
+    n = queue.pop_bulk(got.begin(), got.size());
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  std::vector<BlockingThrowingValue> input;
+  input.reserve(4);
+  for (int v : {1, 2, -1, 4}) {
+    input.emplace_back(v);
+  }
+  ASSERT_THROW(queue.push_bulk(input.begin(), input.end()), std::runtime_error);
+  consumer.join();
+  BlockingThrowingValue rest;
+  while (queue.try_pop(rest)) {
+    got[n++] = rest;
+  }
+  ASSERT_EQ(n, 2u);
+  ASSERT_EQ(got[0].value, 1);
+  ASSERT_EQ(got[1].value, 2);
+}
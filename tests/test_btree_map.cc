@@ -0,0 +1,238 @@
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "../src/btree/btree_map.h"
+
+template <typename Key, typename Value>
+void check_equals(const s21::btree_map<Key, Value> &lhs,
+                  const std::map<Key, Value> &rhs) {
+  ASSERT_EQ(lhs.size(), rhs.size());
+  auto stdIterator = rhs.begin();
+  auto schoolIterator = lhs.begin();
+  while (schoolIterator != lhs.end()) {
+    ASSERT_EQ(schoolIterator->first, stdIterator->first);
+    ASSERT_EQ(schoolIterator->second, stdIterator->second);
+    ++schoolIterator;
+    ++stdIterator;
+  }
+  auto stdReverse = rhs.rbegin();
+  for (auto it = lhs.end(); it != lhs.begin();) {
+    --it;
+    ASSERT_EQ(it->first, stdReverse->first);
+    ++stdReverse;
+  }
+}
+
+TEST(BTreeMap, InsertAndLookup) {
+  s21::btree_map<int, char> school1 = {{3, 'c'}, {1, 'a'}, {2, 'b'}};
+  std::map<int, char> std1 = {{3, 'c'}, {1, 'a'}, {2, 'b'}};
+  check_equals(school1, std1);
+  ASSERT_FALSE(school1.insert(std::make_pair(2, 'z')).second);
+  ASSERT_TRUE(school1.insert(4, 'd').second);
+  std1.insert(std::make_pair(4, 'd'));
+  check_equals(school1, std1);
+  ASSERT_EQ(school1.at(4), 'd');
+  ASSERT_THROW(school1.at(5), std::out_of_range);
+  ASSERT_TRUE(school1.contains(1));
+  ASSERT_EQ(school1.count(7), 0U);
+  ASSERT_EQ(school1.find(7), school1.end());
+}
+
+TEST(BTreeMap, OperatorBracketAndTryEmplace) {
+  s21::btree_map<std::string, int> school1;
+  std::map<std::string, int> std1;
+  std::vector<std::string> words = {"b", "a", "c", "a", "b", "a", "d"};
+  for (const auto &word : words) {
+    ++school1[word];
+    ++std1[word];
+  }
+  check_equals(school1, std1);
+  std::string value = "kept";
+  s21::btree_map<int, std::string> school2;
+  school2.try_emplace(1, "one");
+  ASSERT_FALSE(school2.try_emplace(1, std::move(value)).second);
+  ASSERT_EQ(value, "kept");
+  ASSERT_FALSE(school2.insert_or_assign(1, "uno").second);
+  ASSERT_TRUE(school2.insert_or_assign(2, "dos").second);
+  ASSERT_EQ(school2.at(1), "uno");
+  ASSERT_EQ(school2.at(2), "dos");
+}
+
+TEST(BTreeMap, RandomOperationsMatchStd) {
+  std::mt19937 random(43);
+  s21::btree_map<int, int> school1;
+  std::map<int, int> std1;
+  for (int i = 0; i < 60000; ++i) {
+    int key = static_cast<int>(random() % 5000);
+    switch (random() % 4) {
+      case 0:
+        ASSERT_EQ(school1.erase(key), std1.erase(key));
+        break;
+      case 1: {
+        auto it = school1.find(key);
+        ASSERT_EQ(it == school1.end(), std1.count(key) == 0);
+        if (it != school1.end()) {
+          school1.erase(it);
+          std1.erase(key);
+        }
+        break;
+      }
+      default:
+        ASSERT_EQ(school1.insert(std::make_pair(key, i)).second,
+                  std1.insert(std::make_pair(key, i)).second);
+    }
+    if (i % 5000 == 0) {
+      check_equals(school1, std1);
+    }
+  }
+  check_equals(school1, std1);
+  while (!school1.empty()) {
+    ASSERT_EQ(school1.begin()->first, std1.begin()->first);
+    school1.erase(school1.begin());
+    std1.erase(std1.begin());
+  }
+  ASSERT_EQ(school1.begin(), school1.end());
+}
+
+TEST(BTreeMap, StringKeysMatchStd) {
+  std::mt19937 random(7);
+  s21::btree_map<std::string, std::string> school1;
+  std::map<std::string, std::string> std1;
+  for (int i = 0; i < 20000; ++i) {
+    std::string key = std::to_string(random() % 3000);
+    if (random() % 3 == 0) {
+      ASSERT_EQ(school1.erase(key), std1.erase(key));
+    } else {
+      school1.insert_or_assign(key, key + "!");
+      std1[key] = key + "!";
+    }
+  }
+  check_equals(school1, std1);
+  s21::btree_map<std::string, std::string> copy = school1;
+  check_equals(copy, std1);
+  s21::btree_map<std::string, std::string> moved = std::move(copy);
+  check_equals(moved, std1);
+  ASSERT_TRUE(copy.empty());
+}
+
+TEST(BTreeMap, BoundsAndRanges) {
+  s21::btree_map<int, int> school1;
+  std::map<int, int> std1;
+  for (int i = 0; i < 3000; i += 3) {
+    school1[i] = i;
+    std1[i] = i;
+  }
+  for (int key = -2; key < 3003; ++key) {
+    auto lower = school1.lower_bound(key);
+    auto std_lower = std1.lower_bound(key);
+    ASSERT_EQ(lower == school1.end(), std_lower == std1.end());
+    if (std_lower != std1.end()) {
+      ASSERT_EQ(lower->first, std_lower->first);
+    }
+    auto upper = school1.upper_bound(key);
+    auto std_upper = std1.upper_bound(key);
+    ASSERT_EQ(upper == school1.end(), std_upper == std1.end());
+    if (std_upper != std1.end()) {
+      ASSERT_EQ(upper->first, std_upper->first);
+    }
+    auto range = school1.equal_range(key);
+    ASSERT_EQ(range.first, lower);
+    ASSERT_EQ(range.second, upper);
+  }
+  int expected = 300;
+  for (const auto &item : school1.range(299, 600)) {
+    ASSERT_EQ(item.first, expected);
+    expected += 3;
+  }
+  ASSERT_EQ(expected, 600);
+  ASSERT_TRUE(school1.range(600, 300).empty());
+}
+
+TEST(BTreeMap, TransparentLookup) {
+  s21::btree_map<std::string, int, std::less<>> school1;
+  school1["alpha"] = 1;
+  school1["beta"] = 2;
+  std::string_view key = "beta";
+  ASSERT_EQ(school1.find(key)->second, 2);
+  ASSERT_TRUE(school1.contains(std::string_view("alpha")));
+  ASSERT_EQ(school1.count(std::string_view("gamma")), 0U);
+}
+
+TEST(BTreeMap, FromSortedAndHintedAppend) {
+  std::vector<std::pair<int, int>> items;
+  std::map<int, int> std1;
+  for (int i = 0; i < 5000; ++i) {
+    items.emplace_back(i * 2, i);
+    std1.emplace(i * 2, i);
+  }
+  auto school1 = s21::btree_map<int, int>::from_sorted(items);
+  check_equals(school1, std1);
+  s21::btree_map<int, int> school2;
+  for (const auto &item : items) {
+    school2.insert(school2.end(), item);
+  }
+  check_equals(school2, std1);
+  school2.insert(school2.end(), std::make_pair(1, 1));
+  std1.emplace(1, 1);
+  check_equals(school2, std1);
+  std::vector<std::pair<int, int>> unsorted = {{2, 0}, {1, 0}};
+  using Map = s21::btree_map<int, int>;
+  ASSERT_THROW(Map::from_sorted(unsorted), std::invalid_argument);
+}
+
+TEST(BTreeMap, MergeAndInsertMany) {
+  s21::btree_map<int, int> school1 = {{1, 1}, {3, 3}};
+  s21::btree_map<int, int> school2 = {{2, 20}, {3, 30}};
+  school1.merge(school2);
+  std::map<int, int> std1 = {{1, 1}, {2, 20}, {3, 3}};
+  std::map<int, int> std2 = {{3, 30}};
+  check_equals(school1, std1);
+  check_equals(school2, std2);
+  auto results = school1.insert_many(std::make_pair(5, 5),
+                                     std::make_pair(1, 0),
+                                     std::make_pair(4, 4));
+  ASSERT_EQ(results.size(), 3U);
+  ASSERT_TRUE(results[0].second);
+  ASSERT_FALSE(results[1].second);
+  ASSERT_EQ(results[0].first->first, 5);
+  ASSERT_EQ(results[1].first->second, 1);
+  ASSERT_EQ(results[2].first->first, 4);
+}
+
+namespace {
+
+struct Wide {
+  explicit Wide(int value = 0) : value_(value), padding_() {}
+
+  int value_;
+  char padding_[200];
+};
+
+}  // namespace
+
+TEST(BTreeMap, WideValuesUseSmallNodes) {
+  std::mt19937 random(5);
+  s21::btree_map<int, Wide> school1;
+  std::map<int, int> std1;
+  for (int i = 0; i < 10000; ++i) {
+    int key = static_cast<int>(random() % 1000);
+    if (random() % 2 == 0) {
+      ASSERT_EQ(school1.erase(key), std1.erase(key));
+    } else {
+      school1.try_emplace(key, i);
+      std1.emplace(key, i);
+    }
+  }
+  ASSERT_EQ(school1.size(), std1.size());
+  auto stdIterator = std1.begin();
+  for (const auto &item : school1) {
+    ASSERT_EQ(item.first, stdIterator->first);
+    ASSERT_EQ(item.second.value_, stdIterator->second);
+    ++stdIterator;
+  }
+}
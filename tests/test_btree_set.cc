@@ -0,0 +1,114 @@
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../src/btree/btree_set.h"
+
+template <typename T>
+void check_equals(const s21::btree_set<T> &lhs, const std::set<T> &rhs) {
+  ASSERT_EQ(lhs.size(), rhs.size());
+  auto stdIterator = rhs.begin();
+  auto schoolIterator = lhs.begin();
+  while (schoolIterator != lhs.end()) {
+    ASSERT_EQ(*schoolIterator, *stdIterator);
+    ++schoolIterator;
+    ++stdIterator;
+  }
+}
+
+TEST(BTreeSet, InsertEraseFind) {
+  s21::btree_set<int> school1 = {7, 5, 3, 7, 11, 25, 1, -6, 11, 27, 33};
+  std::set<int> std1 = {7, 5, 3, 7, 11, 25, 1, -6, 11, 27, 33};
+  check_equals(school1, std1);
+  ASSERT_EQ(*school1.find(11), 11);
+  ASSERT_EQ(school1.find(12), school1.end());
+  ASSERT_EQ(school1.erase(11), 1U);
+  ASSERT_EQ(school1.erase(11), 0U);
+  std1.erase(11);
+  check_equals(school1, std1);
+  ASSERT_EQ(*--school1.end(), 33);
+}
+
+TEST(BTreeSet, RandomOperationsMatchStd) {
+  std::mt19937 random(17);
+  s21::btree_set<long long> school1;
+  std::set<long long> std1;
+  for (int i = 0; i < 60000; ++i) {
+    long long key = static_cast<long long>(random() % 8000);
+    if (random() % 3 == 0) {
+      ASSERT_EQ(school1.erase(key), std1.erase(key));
+    } else {
+      ASSERT_EQ(school1.insert(key).second, std1.insert(key).second);
+    }
+  }
+  check_equals(school1, std1);
+  for (long long key = -1; key <= 8000; ++key) {
+    auto lower = school1.lower_bound(key);
+    auto std_lower = std1.lower_bound(key);
+    ASSERT_EQ(lower == school1.end(), std_lower == std1.end());
+    if (std_lower != std1.end()) {
+      ASSERT_EQ(*lower, *std_lower);
+    }
+  }
+}
+
+TEST(BTreeSet, AscendingInsertsFillLeaves) {
+  s21::btree_set<int> school1;
+  std::set<int> std1;
+  for (int i = 0; i < 100000; ++i) {
+    school1.insert(i);
+    std1.insert(i);
+  }
+  check_equals(school1, std1);
+  for (int i = 0; i < 100000; i += 2) {
+    school1.erase(i);
+    std1.erase(i);
+  }
+  check_equals(school1, std1);
+}
+
+TEST(BTreeSet, StringKeysAndCopies) {
+  std::mt19937 random(3);
+  s21::btree_set<std::string> school1;
+  std::set<std::string> std1;
+  for (int i = 0; i < 20000; ++i) {
+    std::string key = "key" + std::to_string(random() % 4000);
+    if (random() % 3 == 0) {
+      ASSERT_EQ(school1.erase(key), std1.erase(key));
+    } else {
+      school1.emplace(key);
+      std1.emplace(key);
+    }
+  }
+  check_equals(school1, std1);
+  s21::btree_set<std::string> copy;
+  copy = school1;
+  check_equals(copy, std1);
+  copy.clear();
+  ASSERT_TRUE(copy.empty());
+  copy.swap(school1);
+  check_equals(copy, std1);
+  ASSERT_TRUE(school1.empty());
+}
+
+TEST(BTreeSet, FromSortedMergeAndRange) {
+  std::vector<int> keys = {1, 3, 5, 7, 9};
+  auto school1 = s21::btree_set<int>::from_sorted(keys);
+  s21::btree_set<int> school2 = {2, 3, 4};
+  school1.merge(school2);
+  check_equals(school1, std::set<int>{1, 2, 3, 4, 5, 7, 9});
+  check_equals(school2, std::set<int>{3});
+  std::vector<int> seen;
+  for (int key : school1.range(3, 7)) {
+    seen.push_back(key);
+  }
+  ASSERT_EQ(seen, (std::vector<int>{3, 4, 5}));
+  ASSERT_THROW(s21::btree_set<int>::from_sorted(std::vector<int>{1, 1}),
+               std::invalid_argument);
+  auto results = school1.insert_many(10, 1, 0);
+  ASSERT_FALSE(results[1].second);
+  ASSERT_EQ(*results[0].first, 10);
+  ASSERT_EQ(*results[2].first, 0);
+}
@@ -0,0 +1,144 @@
+#include <atomic>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../src/map/concurrent_map.h"
+#include "../src/thread_pool/thread_pool.h"
+
+TEST(ConcurrentMap, SingleThreadOperations) {
+  s21::concurrent_map<int, std::string> map1(4);
+  ASSERT_TRUE(map1.empty());
+  ASSERT_TRUE(map1.insert(1, "one"));
+  ASSERT_FALSE(map1.insert(1, "uno"));
+  ASSERT_TRUE(map1.try_emplace(2, 3, 'x'));
+  ASSERT_FALSE(map1.insert_or_assign(1, "uno"));
+  ASSERT_TRUE(map1.insert_or_assign(3, "three"));
+  ASSERT_EQ(*map1.find(1), "uno");
+  ASSERT_EQ(*map1.find(2), "xxx");
+  ASSERT_FALSE(map1.find(4).has_value());
+  ASSERT_TRUE(map1.visit(3, [](std::string &value) { value += "!"; }));
+  ASSERT_FALSE(map1.visit(4, [](std::string &) {}));
+  std::string seen;
+  ASSERT_TRUE(map1.cvisit(3, [&seen](const std::string &v) { seen = v; }));
+  ASSERT_EQ(seen, "three!");
+  ASSERT_EQ(map1.size(), 3U);
+  ASSERT_EQ(map1.erase(2), 1U);
+  ASSERT_EQ(map1.erase(2), 0U);
+  ASSERT_EQ(map1.count(2), 0U);
+  map1.clear();
+  ASSERT_TRUE(map1.empty());
+  using Map = s21::concurrent_map<int, int>;
+  ASSERT_THROW(Map(0), std::invalid_argument);
+}
+
+TEST(ConcurrentMap, ShardsAndSnapshot) {
+  s21::concurrent_map<int, int> map1(8);
+  for (int i = 0; i < 1000; ++i) {
+    map1.insert(i, i * 2);
+  }
+  size_t total = 0;
+  for (size_t shard = 0; shard < map1.shard_count(); ++shard) {
+    int previous = -1;
+    map1.for_each_in_shard(shard, [&](const std::pair<const int, int> &item) {
+      ASSERT_LT(previous, item.first);
+      previous = item.first;
+      ++total;
+    });
+  }
+  ASSERT_EQ(total, 1000U);
+  auto snapshot = map1.snapshot();
+  ASSERT_EQ(snapshot.size(), 1000U);
+  int expected = 0;
+  for (const auto &item : snapshot) {
+    ASSERT_EQ(item.first, expected);
+    ASSERT_EQ(item.second, expected * 2);
+    ++expected;
+  }
+}
+
+TEST(ConcurrentMap, ParallelWalks) {
+  s21::concurrent_map<int, long> map1;
+  for (int i = 0; i < 10000; ++i) {
+    map1.insert(i, i);
+  }
+  s21::thread_pool pool(4);
+  map1.for_each_parallel(pool, [](std::pair<const int, long> &item) {
+    item.second *= 2;
+  });
+  std::atomic<long> sum{0};
+  map1.cfor_each_parallel(pool, [&sum](const std::pair<const int, long> &item) {
+    sum.fetch_add(item.second, std::memory_order_relaxed);
+  });
+  ASSERT_EQ(sum.load(), 2L * 9999 * 10000 / 2);
+}
+
+TEST(ConcurrentMap, ParallelWalkWaitsOnlyForItsShards) {
+  s21::concurrent_map<int, int> map1;
+  for (int i = 0; i < 1000; ++i) {
+    map1.insert(i, i);
+  }
+  s21::thread_pool pool(2);
+  std::atomic<bool> release{false};
+  pool.submit([&release]() {
+    while (!release.load()) {
+      std::this_thread::yield();
+    }
+  });
+  std::atomic<int> visited{0};
+  map1.cfor_each_parallel(pool, [&visited](const std::pair<const int, int> &) {
+    visited.fetch_add(1, std::memory_order_relaxed);
+  });
+  ASSERT_EQ(visited.load(), 1000);
+  ASSERT_THROW(map1.for_each_parallel(pool,
+                                      [](std::pair<const int, int> &item) {
+                                        if (item.first == 500) {
+                                          throw std::runtime_error("stop");
+                                        }
+                                      }),
+               std::runtime_error);
+  release.store(true);
+  pool.wait();
+}
+
+TEST(ConcurrentMap, ManyThreads) {
+  const int threads = 4;
+  const int per_thread = 20000;
+  s21::concurrent_map<int, int> map1;
+  std::atomic<bool> done{false};
+  std::thread reader([&map1, &done]() {
+    while (!done.load()) {
+      auto snapshot = map1.snapshot();
+      int previous = -1;
+      for (const auto &item : snapshot) {
+        ASSERT_LT(previous, item.first);
+        ASSERT_EQ(item.second, item.first);
+        previous = item.first;
+      }
+    }
+  });
+  std::vector<std::thread> writers;
+  for (int t = 0; t < threads; ++t) {
+    writers.emplace_back([&map1, t]() {
+      for (int i = 0; i < per_thread; ++i) {
+        int key = t * per_thread + i;
+        map1.insert(key, key);
+        if (i % 4 == 0) {
+          map1.erase(key);
+        }
+        map1.visit(key, [key](int &value) { value = key; });
+      }
+    });
+  }
+  for (auto &writer : writers) {
+    writer.join();
+  }
+  done.store(true);
+  reader.join();
+  ASSERT_EQ(map1.size(), static_cast<size_t>(threads * per_thread * 3 / 4));
+  for (int key = 0; key < threads * per_thread; ++key) {
+    ASSERT_EQ(map1.contains(key), key % per_thread % 4 != 0);
+  }
+}
@@ -0,0 +1,88 @@
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../src/stack/concurrent_stack.h"
+#include "../utils/epoch_reclamation.h"
+
+TEST(ConcurrentStack, PushPop) {
+  s21::concurrent_stack<std::string> stack1;
+  ASSERT_TRUE(stack1.empty());
+  stack1.push("a");
+  stack1.push(std::string("b"));
+  stack1.emplace(3, 'c');
+  std::string value;
+  ASSERT_TRUE(stack1.try_pop(value));
+  ASSERT_EQ(value, "ccc");
+  ASSERT_TRUE(stack1.try_pop(value));
+  ASSERT_EQ(value, "b");
+  ASSERT_TRUE(stack1.try_pop(value));
+  ASSERT_EQ(value, "a");
+  ASSERT_FALSE(stack1.try_pop(value));
+  stack1.push("left in the stack");
+}
+
+TEST(ConcurrentStack, ManyThreads) {
+  const int threads = 4;
+  const int per_thread = 50000;
+  s21::concurrent_stack<std::unique_ptr<int>> stack1;
+  std::vector<std::atomic<int>> seen(threads * per_thread);
+  std::vector<std::thread> workers;
+  for (int t = 0; t < threads; ++t) {
+    workers.emplace_back([&stack1, &seen, t]() {
+      std::unique_ptr<int> value;
+      for (int i = 0; i < per_thread; ++i) {
+        stack1.push(std::make_unique<int>(t * per_thread + i));
+        if (i % 2 == 1) {
+          while (!stack1.try_pop(value)) {
+          }
+          seen[*value].fetch_add(1);
+          while (!stack1.try_pop(value)) {
+          }
+          seen[*value].fetch_add(1);
+        }
+      }
+    });
+  }
+  for (auto &worker : workers) {
+    worker.join();
+  }
+  ASSERT_TRUE(stack1.empty());
+  for (auto &count : seen) {
+    ASSERT_EQ(count.load(), 1);
+  }
+}
+
+TEST(EpochReclamation, DefersUntilUnpinned) {
+  static std::atomic<int> freed{0};
+  s21::EpochReclamation &domain = s21::EpochReclamation::instance();
+  std::atomic<bool> pinned{false};
+  std::atomic<bool> release{false};
+  std::thread reader([&]() {
+    s21::EpochReclamation::Guard guard(domain);
+    pinned = true;
+    while (!release) {
+      std::this_thread::yield();
+    }
+  });
+  while (!pinned) {
+    std::this_thread::yield();
+  }
+  int *value = new int(1);
+  domain.retire(value, [](void *ptr) {
+    delete static_cast<int *>(ptr);
+    ++freed;
+  });
+  for (int i = 0; i < 4; ++i) {
+    domain.collect();
+  }
+  ASSERT_EQ(freed.load(), 0);
+  release = true;
+  reader.join();
+  for (int i = 0; i < 4; ++i) {
+    domain.collect();
+  }
+  ASSERT_EQ(freed.load(), 1);
+}
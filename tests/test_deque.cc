@@ -0,0 +1,168 @@
+#include <deque>
+#include <string>
+
+#include "../src/deque/deque.h"
+#include "../src/queue/queue.h"
+#include "../src/stack/stack.h"
+
+template <typename T>
+void check_equals(const s21::deque<T> &lhs, const std::deque<T> &rhs) {
+  ASSERT_EQ(lhs.size(), rhs.size());
+  for (size_t i = 0; i < lhs.size(); ++i) {
+    ASSERT_EQ(lhs[i], rhs[i]);
+  }
+}
+
+TEST(Deque, Constructors) {
+  s21::deque<int> school1;
+  std::deque<int> std1;
+  check_equals(school1, std1);
+  s21::deque<int> school2{1, 2, 3, 4, 5};
+  std::deque<int> std2{1, 2, 3, 4, 5};
+  check_equals(school2, std2);
+  s21::deque<int> school3 = school2;
+  std::deque<int> std3 = std2;
+  check_equals(school3, std3);
+  s21::deque<int> school4 = std::move(school3);
+  std::deque<int> std4 = std::move(std3);
+  check_equals(school4, std4);
+  ASSERT_TRUE(school3.empty());
+  school3.push_back(7);
+  ASSERT_EQ(school3.front(), 7);
+}
+
+TEST(Deque, OperatorEquals) {
+  s21::deque<std::string> school1{"a", "b", "c"};
+  std::deque<std::string> std1{"a", "b", "c"};
+  s21::deque<std::string> school2;
+  std::deque<std::string> std2;
+  school2 = school1;
+  std2 = std1;
+  check_equals(school2, std2);
+  s21::deque<std::string> school3;
+  std::deque<std::string> std3;
+  school3 = std::move(school2);
+  std3 = std::move(std2);
+  check_equals(school3, std3);
+}
+
+TEST(Deque, PushPopBothEnds) {
+  s21::deque<int> school1;
+  std::deque<int> std1;
+  for (int i = 0; i < 5000; ++i) {
+    if (i % 3 == 0) {
+      school1.push_front(i);
+      std1.push_front(i);
+    } else {
+      school1.push_back(i);
+      std1.push_back(i);
+    }
+  }
+  check_equals(school1, std1);
+  ASSERT_EQ(school1.front(), std1.front());
+  ASSERT_EQ(school1.back(), std1.back());
+  for (int i = 0; i < 2000; ++i) {
+    school1.pop_front();
+    std1.pop_front();
+    school1.pop_back();
+    std1.pop_back();
+  }
+  check_equals(school1, std1);
+  while (!school1.empty()) {
+    school1.pop_back();
+    std1.pop_back();
+  }
+  check_equals(school1, std1);
+  ASSERT_THROW(school1.front(), std::out_of_range);
+  ASSERT_THROW(school1.back(), std::out_of_range);
+}
+
+TEST(Deque, SlidingWindow) {
+  s21::deque<int> school1;
+  std::deque<int> std1;
+  for (int i = 0; i < 100000; ++i) {
+    school1.push_back(i);
+    std1.push_back(i);
+    if (i % 4 != 0) {
+      school1.pop_front();
+      std1.pop_front();
+    }
+  }
+  check_equals(school1, std1);
+}
+
+TEST(Deque, ReferenceStability) {
+  s21::deque<int> school1;
+  school1.push_back(1);
+  int &first = school1.front();
+  int *address = &first;
+  for (int i = 0; i < 10000; ++i) {
+    school1.push_back(i);
+    school1.push_front(-i);
+  }
+  ASSERT_EQ(&school1[10000], address);
+  ASSERT_EQ(first, 1);
+}
+
+TEST(Deque, Iterators) {
+  s21::deque<int> school1;
+  std::deque<int> std1;
+  for (int i = 0; i < 1000; ++i) {
+    school1.push_front(i);
+    std1.push_front(i);
+  }
+  auto std_it = std1.begin();
+  for (auto it = school1.begin(); it != school1.end(); ++it, ++std_it) {
+    ASSERT_EQ(*it, *std_it);
+  }
+  ASSERT_EQ(school1.end() - school1.begin(), 1000);
+  ASSERT_EQ(*(school1.begin() + 500), std1[500]);
+  ASSERT_EQ(school1.begin()[999], std1[999]);
+  const s21::deque<int> &const_school = school1;
+  int sum = 0;
+  for (const auto &item : const_school) {
+    sum += item;
+  }
+  ASSERT_EQ(sum, 999 * 1000 / 2);
+}
+
+TEST(Deque, At) {
+  s21::deque<int> school1{1, 2, 3};
+  ASSERT_EQ(school1.at(2), 3);
+  ASSERT_THROW(school1.at(3), std::out_of_range);
+}
+
+TEST(Deque, SwapAndClear) {
+  s21::deque<int> school1{1, 2, 3};
+  s21::deque<int> school2{4, 5};
+  school1.swap(school2);
+  ASSERT_EQ(school1.size(), 2U);
+  ASSERT_EQ(school2.size(), 3U);
+  school2.clear();
+  ASSERT_TRUE(school2.empty());
+  school2.push_front(9);
+  ASSERT_EQ(school2.back(), 9);
+}
+
+TEST(Deque, InsertMany) {
+  s21::deque<int> school1{3};
+  std::deque<int> std1{0, 1, 2, 3, 4, 5};
+  school1.insert_many_back(4, 5);
+  school1.insert_many_front(0, 1, 2);
+  check_equals(school1, std1);
+}
+
+TEST(Deque, AsAdaptorContainer) {
+  s21::stack<int, s21::deque<int>> stack1{1, 2, 3};
+  stack1.push(4);
+  ASSERT_EQ(stack1.top(), 4);
+  stack1.pop();
+  ASSERT_EQ(stack1.top(), 3);
+  ASSERT_EQ(stack1.size(), 3U);
+  s21::queue<int, s21::deque<int>> queue1{1, 2, 3};
+  queue1.push(4);
+  ASSERT_EQ(queue1.front(), 1);
+  ASSERT_EQ(queue1.back(), 4);
+  queue1.pop();
+  ASSERT_EQ(queue1.front(), 2);
+}
@@ -0,0 +1,168 @@
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "../src/flat/flat_map.h"
+
+template <typename Key, typename Value>
+void check_equals(const s21::flat_map<Key, Value> &lhs,
+                  const std::map<Key, Value> &rhs) {
+  ASSERT_EQ(lhs.size(), rhs.size());
+  auto stdIterator = rhs.begin();
+  for (auto it = lhs.begin(); it != lhs.end(); ++it) {
+    ASSERT_EQ(it->first, stdIterator->first);
+    ASSERT_EQ((*it).second, stdIterator->second);
+    ++stdIterator;
+  }
+}
+
+TEST(FlatMap, InsertAndLookup) {
+  s21::flat_map<int, char> school1 = {{3, 'c'}, {1, 'a'}, {2, 'b'}, {1, 'z'}};
+  std::map<int, char> std1 = {{3, 'c'}, {1, 'a'}, {2, 'b'}};
+  check_equals(school1, std1);
+  ASSERT_FALSE(school1.insert(std::make_pair(2, 'y')).second);
+  ASSERT_TRUE(school1.insert(0, 'o').second);
+  std1.emplace(0, 'o');
+  check_equals(school1, std1);
+  ASSERT_EQ(school1.at(3), 'c');
+  ASSERT_THROW(school1.at(9), std::out_of_range);
+  ASSERT_EQ(school1.find(9), school1.end());
+  ASSERT_EQ(school1.count(1), 1U);
+  school1.find(2)->second = 'B';
+  ASSERT_EQ(school1.at(2), 'B');
+  ASSERT_EQ(school1.end() - school1.begin(), 4);
+  ASSERT_EQ(school1.begin()[3].first, 3);
+}
+
+TEST(FlatMap, OperatorBracketAndTryEmplace) {
+  s21::flat_map<std::string, int> school1;
+  std::map<std::string, int> std1;
+  for (const char *word : {"b", "a", "c", "a", "b", "a", "d"}) {
+    ++school1[word];
+    ++std1[word];
+  }
+  check_equals(school1, std1);
+  std::string value = "kept";
+  s21::flat_map<int, std::string> school2;
+  school2.try_emplace(1, "one");
+  ASSERT_FALSE(school2.try_emplace(1, std::move(value)).second);
+  ASSERT_EQ(value, "kept");
+  ASSERT_FALSE(school2.insert_or_assign(1, "uno").second);
+  ASSERT_TRUE(school2.insert_or_assign(2, "dos").second);
+  ASSERT_EQ(school2.at(1), "uno");
+  ASSERT_EQ(school2.at(2), "dos");
+  ASSERT_TRUE(school2.emplace(0, "cero").second);
+  ASSERT_EQ(school2.begin()->second, "cero");
+}
+
+TEST(FlatMap, BulkInsertMergesWithExisting) {
+  std::mt19937 random(44);
+  s21::flat_map<int, int> school1;
+  std::map<int, int> std1;
+  for (int round = 0; round < 20; ++round) {
+    std::vector<std::pair<int, int>> batch;
+    for (int i = 0; i < 500; ++i) {
+      batch.emplace_back(static_cast<int>(random() % 4000), round * 1000 + i);
+    }
+    school1.insert(batch.begin(), batch.end());
+    std1.insert(batch.begin(), batch.end());
+    check_equals(school1, std1);
+  }
+  for (int key = 0; key < 4000; key += 7) {
+    ASSERT_EQ(school1.erase(key), std1.erase(key));
+  }
+  check_equals(school1, std1);
+  for (int key = -1; key <= 4000; ++key) {
+    auto lower = school1.lower_bound(key);
+    auto std_lower = std1.lower_bound(key);
+    ASSERT_EQ(lower == school1.end(), std_lower == std1.end());
+    if (std_lower != std1.end()) {
+      ASSERT_EQ(lower->first, std_lower->first);
+    }
+    auto upper = school1.upper_bound(key);
+    ASSERT_EQ(school1.equal_range(key).second, upper);
+  }
+}
+
+// Copies throw once copies_left runs out; the move is not noexcept, so
+// containers copy it rather than risk a half-moved state.
+struct FlatThrowingValue {
+  static int copies_left;
+  explicit FlatThrowingValue(int value) : value_(value) {}
+  FlatThrowingValue(const FlatThrowingValue &other) : value_(other.value_) {
+    if (copies_left-- == 0) {
+      throw std::runtime_error("copy");
+    }
+  }
+  FlatThrowingValue(FlatThrowingValue &&other) : value_(other.value_) {}
+  FlatThrowingValue &operator=(const FlatThrowingValue &other) = default;
+  int value_;
+};
+
+int FlatThrowingValue::copies_left = -1;
+
+TEST(FlatMap, FailedBulkInsertKeepsContents) {
+  s21::flat_map<std::string, FlatThrowingValue> school1;
+  school1.reserve(100);
+  for (int i = 0; i < 20; ++i) {
+    school1.emplace(std::to_string(i * 2 + 10), FlatThrowingValue(i));
+  }
+  std::vector<std::pair<std::string, FlatThrowingValue>> batch;
+  for (int i = 0; i < 10; ++i) {
+    batch.emplace_back(std::to_string(i * 3 + 10), FlatThrowingValue(-i));
+  }
+  FlatThrowingValue::copies_left = 15;
+  ASSERT_THROW(school1.insert(batch.begin(), batch.end()), std::runtime_error);
+  FlatThrowingValue::copies_left = -1;
+  ASSERT_EQ(school1.size(), 20U);
+  std::string previous;
+  for (auto it = school1.begin(); it != school1.end(); ++it) {
+    ASSERT_LT(previous, it->first);
+    previous = it->first;
+  }
+  for (int j = 0; j < 20; ++j) {
+    ASSERT_EQ(school1.at(std::to_string(j * 2 + 10)).value_, j);
+  }
+  school1.insert(batch.begin(), batch.end());
+  ASSERT_EQ(school1.size(), 25U);
+}
+
+TEST(FlatMap, AdoptsContainers) {
+  s21::vector<int> keys{5, 1, 3, 1};
+  s21::vector<std::string> values{"five", "one", "three", "uno"};
+  s21::flat_map<int, std::string> school1(std::move(keys), std::move(values));
+  std::map<int, std::string> std1 = {{1, "one"}, {3, "three"}, {5, "five"}};
+  check_equals(school1, std1);
+  auto school2 = s21::flat_map<int, std::string>::from_sorted(
+      school1.keys(), school1.values());
+  check_equals(school2, std1);
+  s21::vector<int> unsorted{2, 1};
+  s21::vector<std::string> two{"b", "a"};
+  using Map = s21::flat_map<int, std::string>;
+  ASSERT_THROW(Map::from_sorted(unsorted, two), std::invalid_argument);
+  ASSERT_THROW(Map(s21::vector<int>{1}, two), std::invalid_argument);
+  std::vector<std::pair<int, std::string>> sorted = {{1, "a"}, {2, "b"}};
+  ASSERT_EQ(Map::from_sorted(sorted).at(2), "b");
+}
+
+TEST(FlatMap, EraseAndTransparentLookup) {
+  s21::flat_map<std::string, int, std::less<>> school1 = {
+      {"alpha", 1}, {"beta", 2}, {"gamma", 3}};
+  std::string_view key = "beta";
+  auto it = school1.find(key);
+  ASSERT_EQ(it->second, 2);
+  it = school1.erase(it);
+  ASSERT_EQ(it->first, "gamma");
+  ASSERT_FALSE(school1.contains(key));
+  ASSERT_EQ(school1.count(std::string_view("alpha")), 1U);
+  ASSERT_EQ(school1.erase("alpha"), 1U);
+  ASSERT_EQ(school1.size(), 1U);
+  s21::flat_map<std::string, int, std::less<>> school2;
+  school2.swap(school1);
+  ASSERT_TRUE(school1.empty());
+  ASSERT_EQ(school2.begin()->first, "gamma");
+}
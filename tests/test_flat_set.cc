@@ -0,0 +1,62 @@
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../src/flat/flat_set.h"
+
+template <typename T>
+void check_equals(const s21::flat_set<T> &lhs, const std::set<T> &rhs) {
+  ASSERT_EQ(lhs.size(), rhs.size());
+  auto stdIterator = rhs.begin();
+  for (auto it = lhs.begin(); it != lhs.end(); ++it) {
+    ASSERT_EQ(*it, *stdIterator);
+    ++stdIterator;
+  }
+}
+
+TEST(FlatSet, InsertEraseFind) {
+  s21::flat_set<int> school1 = {7, 5, 3, 7, 11, 25, 1, -6, 11, 27, 33};
+  std::set<int> std1 = {7, 5, 3, 7, 11, 25, 1, -6, 11, 27, 33};
+  check_equals(school1, std1);
+  ASSERT_FALSE(school1.insert(7).second);
+  ASSERT_EQ(*school1.insert(8).first, 8);
+  std1.insert(8);
+  ASSERT_EQ(school1.erase(11), 1U);
+  std1.erase(11);
+  check_equals(school1, std1);
+  auto next = school1.erase(school1.find(25));
+  std1.erase(25);
+  ASSERT_EQ(*next, 27);
+  check_equals(school1, std1);
+  ASSERT_EQ(school1.find(100), school1.end());
+}
+
+TEST(FlatSet, BulkInsertMatchesStd) {
+  std::mt19937 random(45);
+  s21::flat_set<std::string> school1;
+  std::set<std::string> std1;
+  for (int round = 0; round < 10; ++round) {
+    std::vector<std::string> batch;
+    for (int i = 0; i < 300; ++i) {
+      batch.push_back(std::to_string(random() % 2000));
+    }
+    school1.insert(batch.begin(), batch.end());
+    std1.insert(batch.begin(), batch.end());
+    check_equals(school1, std1);
+  }
+  ASSERT_EQ(*school1.lower_bound("5"), *std1.lower_bound("5"));
+  ASSERT_EQ(*school1.upper_bound("5"), *std1.upper_bound("5"));
+}
+
+TEST(FlatSet, AdoptsContainers) {
+  s21::flat_set<int> school1(s21::vector<int>{4, 2, 4, 1});
+  check_equals(school1, std::set<int>{1, 2, 4});
+  auto school2 = s21::flat_set<int>::from_sorted(s21::vector<int>{1, 2, 4});
+  check_equals(school2, std::set<int>{1, 2, 4});
+  ASSERT_THROW(s21::flat_set<int>::from_sorted(s21::vector<int>{2, 2}),
+               std::invalid_argument);
+  std::vector<int> sorted = {1, 5, 9};
+  ASSERT_TRUE(s21::flat_set<int>::from_sorted(sorted).contains(5));
+}
@@ -1,4 +1,5 @@
 #include <list>
+#include <string>
 
 #include "../src/list/list.h"
 
@@ -584,4 +585,23 @@ TEST(List, ConstReverseIterator) {
     ++s21Iterator;
     ++stdIterator;
   }
-}
\ No newline at end of file
+}
+TEST(List, EmplaceBackAndMovePush) {
+  s21::list<std::string> school1;
+  std::list<std::string> std1;
+  std::string moved(40, 'm');
+  school1.push_back(std::move(moved));
+  std1.push_back(std::string(40, 'm'));
+  ASSERT_TRUE(moved.empty());
+  school1.emplace_back(3, 'x') += "!";
+  std1.emplace_back(3, 'x') += "!";
+  school1.push_back("tail");
+  std1.push_back("tail");
+  ASSERT_EQ(school1.size(), std1.size());
+  auto stdIterator = std1.begin();
+  for (auto s21Iterator = school1.begin(); s21Iterator != school1.end();
+       ++s21Iterator) {
+    ASSERT_EQ(*s21Iterator, *stdIterator);
+    ++stdIterator;
+  }
+}
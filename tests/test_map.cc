@@ -1,5 +1,9 @@
 #include <functional>
 #include <map>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
 
 #include "../src/map/map.h"
 
@@ -198,6 +202,97 @@ TEST(Map, Merge) {
   check_equals(school2, std2);
 }
 
+TEST(Map, MergeRelinksNodes) {
+  for (int other_size : {10, 900}) {
+    s21::map<int, std::string> school1;
+    std::map<int, std::string> std1;
+    s21::map<int, std::string> school2;
+    std::map<int, std::string> std2;
+    for (int i = 0; i < 1000; ++i) {
+      school1.insert(i * 3, std::to_string(i));
+      std1.insert({i * 3, std::to_string(i)});
+    }
+    for (int i = 0; i < other_size; ++i) {
+      school2.insert(i * 5 - 50, "other");
+      std2.insert({i * 5 - 50, "other"});
+    }
+    const std::string *moved = &school2.find(-50)->second;
+    const std::string *kept = &school2.find(0)->second;
+    school1.merge(school2);
+    std1.merge(std2);
+    check_equals(school1, std1);
+    check_equals(school2, std2);
+    ASSERT_EQ(&school1.find(-50)->second, moved);
+    ASSERT_EQ(&school2.find(0)->second, kept);
+    ASSERT_EQ(school1.begin()->first, std1.begin()->first);
+    ASSERT_EQ((--school1.end())->first, std1.rbegin()->first);
+    ASSERT_EQ(school1.select(500)->first, std::next(std1.begin(), 500)->first);
+    ASSERT_EQ(school1.rank(1500), static_cast<size_t>(std::distance(
+                                      std1.begin(), std1.lower_bound(1500))));
+    school1.erase(school1.find(-50));
+    std1.erase(-50);
+    school1.insert(-1, "new");
+    std1.insert({-1, "new"});
+    check_equals(school1, std1);
+  }
+}
+
+TEST(Map, ExtractInsertNode) {
+  s21::map<int, std::string> hot;
+  std::map<int, std::string> std_hot;
+  s21::map<int, std::string> cold;
+  std::map<int, std::string> std_cold;
+  for (int i = 0; i < 100; ++i) {
+    hot.insert(i, std::to_string(i));
+    std_hot.insert({i, std::to_string(i)});
+  }
+  const std::string *value = &hot.find(42)->second;
+  auto node = hot.extract(42);
+  auto std_node = std_hot.extract(42);
+  ASSERT_FALSE(node.empty());
+  ASSERT_EQ(node.key(), 42);
+  ASSERT_EQ(&node.mapped(), value);
+  node.key() = 1042;
+  std_node.key() = 1042;
+  auto result = cold.insert(std::move(node));
+  auto std_result = std_cold.insert(std::move(std_node));
+  ASSERT_TRUE(result.inserted);
+  ASSERT_TRUE(node.empty());
+  ASSERT_EQ(result.position->first, std_result.position->first);
+  ASSERT_EQ(&cold.find(1042)->second, value);
+  check_equals(hot, std_hot);
+  check_equals(cold, std_cold);
+
+  for (int i = 1; i < 100; i += 2) {
+    auto moved = hot.extract(hot.find(i));
+    std_hot.extract(i);
+    cold.insert(cold.end(), std::move(moved));
+    std_cold.insert({i, std::to_string(i)});
+  }
+  check_equals(hot, std_hot);
+  check_equals(cold, std_cold);
+  ASSERT_EQ(cold.begin()->first, 1);
+  ASSERT_EQ((--cold.end())->first, 1042);
+}
+
+TEST(Map, InsertNodeDuplicate) {
+  s21::map<int, std::string> school1 = {{1, "a"}, {2, "b"}};
+  s21::map<int, std::string> school2 = {{2, "c"}};
+  auto missing = school1.extract(5);
+  ASSERT_TRUE(missing.empty());
+  ASSERT_FALSE(school2.insert(std::move(missing)).inserted);
+  auto result = school1.insert(school2.extract(2));
+  ASSERT_FALSE(result.inserted);
+  ASSERT_EQ(result.position->second, "b");
+  ASSERT_FALSE(result.node.empty());
+  ASSERT_EQ(result.node.mapped(), "c");
+  ASSERT_TRUE(school2.empty());
+  result.node.key() = 3;
+  ASSERT_TRUE(school1.insert(std::move(result.node)).inserted);
+  ASSERT_EQ(school1.size(), 3U);
+  ASSERT_EQ(school1.at(3), "c");
+}
+
 TEST(Map, Swap) {
   s21::map<int, char> school1{{1, 'a'}, {2, 'b'}, {3, 'c'}};
   std::map<int, char> std1{{1, 'a'}, {2, 'b'}, {3, 'c'}};
@@ -303,4 +398,333 @@ TEST(Map, NewRightLeftRotate1) {
   school1.insert(std::make_pair(180, 'X'));
   std1.insert(std::make_pair(180, 'X'));
   check_equals(school1, std1);
-}
\ No newline at end of file
+}
+
+TEST(Map, InsertReturnsExisting) {
+  s21::map<int, char> school1{{1, 'a'}, {2, 'b'}};
+  auto result = school1.insert(std::make_pair(2, 'z'));
+  ASSERT_FALSE(result.second);
+  ASSERT_EQ(result.first->first, 2);
+  ASSERT_EQ(result.first->second, 'b');
+  result = school1.insert(std::make_pair(3, 'c'));
+  ASSERT_TRUE(result.second);
+  ASSERT_EQ(result.first->second, 'c');
+}
+
+TEST(Map, RandomInsertFind) {
+  std::mt19937 random(7);
+  s21::map<int, int, std::greater<int>> school1;
+  std::map<int, int, std::greater<int>> std1;
+  for (int i = 0; i < 20000; ++i) {
+    int key = static_cast<int>(random() % 5000);
+    auto school_result = school1.insert(std::make_pair(key, i));
+    auto std_result = std1.insert(std::make_pair(key, i));
+    ASSERT_EQ(school_result.second, std_result.second);
+    ASSERT_EQ(school_result.first->second, std_result.first->second);
+  }
+  for (int key = -1; key <= 5000; ++key) {
+    ASSERT_EQ(school1.find(key) == school1.end(), std1.find(key) == std1.end());
+  }
+  ASSERT_EQ(school1.size(), std1.size());
+  auto std_it = std1.begin();
+  for (auto &item : school1) {
+    ASSERT_EQ(item.first, std_it->first);
+    ++std_it;
+  }
+}
+
+TEST(Map, InsertWithHint) {
+  s21::map<int, int> school1;
+  std::map<int, int> std1;
+  for (int i = 0; i < 1000; ++i) {
+    auto it = school1.insert(school1.end(), std::make_pair(i, i));
+    ASSERT_EQ(it->first, i);
+    std1.insert(std1.end(), std::make_pair(i, i));
+  }
+  check_equals(school1, std1);
+  std::mt19937 random(3);
+  for (int i = 0; i < 5000; ++i) {
+    int key = static_cast<int>(random() % 3000) - 1000;
+    auto hint = school1.find(static_cast<int>(random() % 1000));
+    auto it = school1.emplace_hint(hint, key, i);
+    auto std_it = std1.emplace_hint(std1.find(hint->first), key, i);
+    ASSERT_EQ(it->first, key);
+    ASSERT_EQ(it->second, std_it->second);
+  }
+  check_equals(school1, std1);
+}
+
+TEST(Map, StructuralCopy) {
+  s21::map<int, std::string> school1;
+  std::map<int, std::string> std1;
+  std::mt19937 random(5);
+  for (int i = 0; i < 3000; ++i) {
+    int key = static_cast<int>(random() % 10000);
+    school1.insert(std::make_pair(key, std::to_string(i)));
+    std1.insert(std::make_pair(key, std::to_string(i)));
+  }
+  s21::map<int, std::string> school2(school1);
+  check_equals(school2, std1);
+  school2.insert(std::make_pair(-1, "new"));
+  ASSERT_EQ(school1.size() + 1, school2.size());
+  ASSERT_EQ(school1.find(-1), school1.end());
+  s21::map<int, std::string> empty;
+  s21::map<int, std::string> school3(empty);
+  ASSERT_TRUE(school3.empty());
+}
+
+TEST(Map, FromSorted) {
+  std::map<int, int> std1;
+  for (int i = 0; i < 1000; ++i) {
+    std1.insert(std::make_pair(i * 3, i));
+  }
+  auto school1 = s21::map<int, int>::from_sorted(std1.begin(), std1.end());
+  check_equals(school1, std1);
+  for (int i = 0; i < 3000; ++i) {
+    ASSERT_EQ(school1.find(i) != school1.end(), std1.count(i) == 1);
+  }
+  school1.insert(std::make_pair(1, 1));
+  std1.insert(std::make_pair(1, 1));
+  check_equals(school1, std1);
+  std::vector<std::pair<int, int>> unsorted{{1, 1}, {3, 3}, {2, 2}};
+  ASSERT_THROW((s21::map<int, int>::from_sorted(unsorted)),
+               std::invalid_argument);
+  std::vector<std::pair<int, int>> none;
+  ASSERT_TRUE((s21::map<int, int>::from_sorted(none)).empty());
+}
+
+TEST(Map, CachedExtremes) {
+  s21::map<int, int> school1;
+  ASSERT_EQ(school1.begin(), school1.end());
+  ASSERT_EQ(--school1.end(), school1.end());
+  std::map<int, int> std1;
+  for (int key : {50, 30, 70, 20, 80, 10, 90, 60}) {
+    school1.insert(std::make_pair(key, key));
+    std1.insert(std::make_pair(key, key));
+    ASSERT_EQ(school1.begin()->first, std1.begin()->first);
+    ASSERT_EQ((--school1.end())->first, std1.rbegin()->first);
+  }
+  school1.erase(school1.begin());
+  school1.erase(--school1.end());
+  school1.erase(school1.find(50));
+  ASSERT_EQ(school1.begin()->first, 20);
+  ASSERT_EQ((--school1.end())->first, 80);
+  school1.clear();
+  ASSERT_EQ(school1.begin(), school1.end());
+  school1.insert(std::make_pair(5, 5));
+  ASSERT_EQ(school1.begin()->first, 5);
+  ASSERT_EQ((--school1.end())->first, 5);
+}
+
+TEST(Map, RandomEraseKeepsOrder) {
+  std::mt19937 random(19);
+  s21::map<int, int> school1;
+  std::map<int, int> std1;
+  for (int i = 0; i < 20000; ++i) {
+    int key = static_cast<int>(random() % 2000);
+    if (random() % 3 == 0) {
+      auto it = school1.find(key);
+      ASSERT_EQ(it == school1.end(), std1.erase(key) == 0);
+      if (it != school1.end()) {
+        school1.erase(it);
+      }
+    } else {
+      school1.insert(std::make_pair(key, i));
+      std1.insert(std::make_pair(key, i));
+    }
+    if (!std1.empty()) {
+      ASSERT_EQ(school1.begin()->first, std1.begin()->first);
+      ASSERT_EQ((--school1.end())->first, std1.rbegin()->first);
+    }
+  }
+  check_equals(school1, std1);
+  while (!school1.empty()) {
+    school1.erase(school1.begin());
+  }
+  ASSERT_EQ(school1.begin(), school1.end());
+}
+
+TEST(Map, OperatorBracketInserts) {
+  s21::map<std::string, int> school1;
+  std::map<std::string, int> std1;
+  std::vector<std::string> words = {"b", "a", "c", "a", "b", "a", "d"};
+  for (const auto &word : words) {
+    ++school1[word];
+    ++std1[word];
+  }
+  check_equals(school1, std1);
+  std::string key = "e";
+  school1[std::move(key)] = 7;
+  ASSERT_EQ(school1.at("e"), 7);
+}
+
+TEST(Map, TryEmplace) {
+  s21::map<int, std::string> school1;
+  auto result = school1.try_emplace(1, 3, 'x');
+  ASSERT_TRUE(result.second);
+  ASSERT_EQ(result.first->second, "xxx");
+  std::string value = "kept";
+  result = school1.try_emplace(1, std::move(value));
+  ASSERT_FALSE(result.second);
+  ASSERT_EQ(result.first->second, "xxx");
+  ASSERT_EQ(value, "kept");
+  result = school1.try_emplace(2, std::move(value));
+  ASSERT_TRUE(result.second);
+  ASSERT_EQ(school1.at(2), "kept");
+}
+
+TEST(Map, InsertOrAssignResult) {
+  s21::map<int, std::string> school1;
+  auto result = school1.insert_or_assign(4, "first");
+  ASSERT_TRUE(result.second);
+  result = school1.insert_or_assign(4, std::string("second"));
+  ASSERT_FALSE(result.second);
+  ASSERT_EQ(result.first->second, "second");
+  ASSERT_EQ(school1.size(), 1u);
+}
+
+namespace {
+int comparisons = 0;
+
+struct CountingLess {
+  bool operator()(int lhs, int rhs) const {
+    ++comparisons;
+    return lhs < rhs;
+  }
+};
+}  // namespace
+
+TEST(Map, SingleDescentUpdates) {
+  std::vector<std::pair<int, int>> items;
+  for (int i = 0; i < 1023; ++i) {
+    items.emplace_back(i * 2, 0);
+  }
+  auto school1 = s21::map<int, int, CountingLess>::from_sorted(items);
+  // A perfect tree of 1023 nodes is 10 levels deep: a descent costs at most
+  // two comparisons per level.
+  for (int key : {0, 1022, 2044, 1, 1023, 2045}) {
+    comparisons = 0;
+    ++school1[key];
+    ASSERT_LE(comparisons, 22);
+    comparisons = 0;
+    school1.insert_or_assign(key, 5);
+    ASSERT_LE(comparisons, 22);
+    comparisons = 0;
+    school1.try_emplace(key, 6);
+    ASSERT_LE(comparisons, 22);
+  }
+  ASSERT_EQ(school1.at(1), 5);
+  ASSERT_EQ(school1.at(0), 5);
+}
+
+TEST(Map, TransparentLookup) {
+  s21::map<std::string, int, std::less<>> school1;
+  school1.insert(std::make_pair(std::string("apple"), 1));
+  school1.insert(std::make_pair(std::string("cherry"), 3));
+  school1.insert(std::make_pair(std::string("banana"), 2));
+  std::string_view view = "banana";
+  ASSERT_EQ(school1.find(view)->second, 2);
+  ASSERT_EQ(school1.find("cherry")->second, 3);
+  ASSERT_EQ(school1.find("durian"), school1.end());
+  ASSERT_TRUE(school1.contains(view));
+  ASSERT_FALSE(school1.contains("avocado"));
+  ASSERT_EQ(school1.count("apple"), 1u);
+  ASSERT_EQ(school1.count(std::string_view("fig")), 0u);
+  ASSERT_EQ(school1.lower_bound("b")->first, "banana");
+  ASSERT_EQ(school1.lower_bound(std::string_view("c"))->first, "cherry");
+  ASSERT_EQ(school1.lower_bound("d"), school1.end());
+}
+
+TEST(Map, LowerBound) {
+  s21::map<int, int> school1;
+  std::map<int, int> std1;
+  for (int i = 0; i < 100; i += 3) {
+    school1.insert(std::make_pair(i, i));
+    std1.insert(std::make_pair(i, i));
+  }
+  for (int key = -1; key < 102; ++key) {
+    auto it = std1.lower_bound(key);
+    if (it == std1.end()) {
+      ASSERT_EQ(school1.lower_bound(key), school1.end());
+    } else {
+      ASSERT_EQ(school1.lower_bound(key)->first, it->first);
+    }
+    ASSERT_EQ(school1.count(key), std1.count(key));
+  }
+}
+
+namespace {
+struct DirectedLess {
+  bool descending = false;
+  bool operator()(int lhs, int rhs) const {
+    return descending ? rhs < lhs : lhs < rhs;
+  }
+};
+}  // namespace
+
+TEST(Map, ComparatorObject) {
+  s21::map<int, int, DirectedLess> school1(DirectedLess{true});
+  for (int i = 0; i < 10; ++i) {
+    school1.insert(std::make_pair(i, i));
+  }
+  ASSERT_TRUE(school1.key_comp().descending);
+  ASSERT_EQ(school1.begin()->first, 9);
+  ASSERT_EQ(school1.lower_bound(4)->first, 4);
+  s21::map<int, int, DirectedLess> copy = school1;
+  ASSERT_EQ(copy.begin()->first, 9);
+}
+
+TEST(Map, BoundsAndRanges) {
+  std::mt19937 random(29);
+  s21::map<int, int> school1;
+  std::map<int, int> std1;
+  for (int i = 0; i < 3000; ++i) {
+    int key = static_cast<int>(random() % 10000);
+    school1.insert(std::make_pair(key, i));
+    std1.insert(std::make_pair(key, i));
+  }
+  auto same = [&](auto it, std::map<int, int>::iterator std_it) {
+    return std_it == std1.end() ? it == school1.end()
+                                : it != school1.end() &&
+                                      it->first == std_it->first;
+  };
+  for (int key = -1; key <= 10000; key += 7) {
+    ASSERT_TRUE(same(school1.upper_bound(key), std1.upper_bound(key)));
+    auto range = school1.equal_range(key);
+    auto std_range = std1.equal_range(key);
+    ASSERT_TRUE(same(range.first, std_range.first));
+    ASSERT_TRUE(same(range.second, std_range.second));
+  }
+  for (int i = 0; i < 200; ++i) {
+    int low = static_cast<int>(random() % 10000);
+    int high = low + static_cast<int>(random() % 500);
+    auto std_it = std1.lower_bound(low);
+    for (auto& item : school1.range(low, high)) {
+      ASSERT_EQ(item.first, std_it->first);
+      ++std_it;
+    }
+    ASSERT_TRUE(same(school1.range(low, high).end(), std_it));
+    ASSERT_TRUE(school1.range(high, low).empty());
+  }
+}
+
+TEST(Map, RankSelect) {
+  s21::map<int, char> school1;
+  for (int i = 0; i < 100; ++i) {
+    school1.insert(std::make_pair(i * 10, 'a'));
+  }
+  for (int i = 0; i < 100; i += 2) {
+    school1.erase(school1.find(i * 10));
+  }
+  for (size_t i = 0; i < 50; ++i) {
+    ASSERT_EQ(school1.select(i)->first, static_cast<int>(i * 20 + 10));
+    ASSERT_EQ(school1.rank(static_cast<int>(i * 20 + 10)), i);
+  }
+  ASSERT_EQ(school1.select(50), school1.end());
+  ASSERT_EQ(school1.rank(-5), 0u);
+  ASSERT_EQ(school1.rank(5000), 50u);
+  ASSERT_EQ(school1.count_range(10, 100), 5u);
+  ASSERT_EQ(school1.count_range(100, 10), 0u);
+  auto copy = school1;
+  ASSERT_EQ(copy.select(49)->first, 990);
+}
@@ -0,0 +1,64 @@
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "../src/queue/mpmc_queue.h"
+
+TEST(MpmcQueue, PushPop) {
+  s21::mpmc_queue<int> queue(5);
+  ASSERT_EQ(queue.capacity(), 8U);
+  for (int i = 0; i < 8; ++i) {
+    ASSERT_TRUE(queue.try_push(i));
+  }
+  ASSERT_FALSE(queue.try_push(8));
+  ASSERT_EQ(queue.size(), 8U);
+  int value = -1;
+  for (int i = 0; i < 8; ++i) {
+    ASSERT_TRUE(queue.try_pop(value));
+    ASSERT_EQ(value, i);
+  }
+  ASSERT_FALSE(queue.try_pop(value));
+  ASSERT_TRUE(queue.empty());
+}
+
+TEST(MpmcQueue, MoveOnly) {
+  s21::mpmc_queue<std::unique_ptr<int>> queue(4);
+  ASSERT_TRUE(queue.try_push(std::make_unique<int>(7)));
+  ASSERT_TRUE(queue.try_emplace(new int(8)));
+  std::unique_ptr<int> value;
+  ASSERT_TRUE(queue.try_pop(value));
+  ASSERT_EQ(*value, 7);
+  queue.push(std::make_unique<int>(9));
+}
+
+TEST(MpmcQueue, ManyThreads) {
+  const int threads = 4;
+  const int per_thread = 100000;
+  s21::mpmc_queue<int> queue(64);
+  std::vector<std::thread> workers;
+  std::vector<long long> sums(threads, 0);
+  for (int t = 0; t < threads; ++t) {
+    workers.emplace_back([&queue, t]() {
+      for (int i = 0; i < per_thread; ++i) {
+        queue.push(t * per_thread + i);
+      }
+    });
+    workers.emplace_back([&queue, &sums, t]() {
+      int value = 0;
+      for (int i = 0; i < per_thread; ++i) {
+        queue.pop(value);
+        sums[t] += value;
+      }
+    });
+  }
+  for (auto &worker : workers) {
+    worker.join();
+  }
+  long long total = 0;
+  for (long long sum : sums) {
+    total += sum;
+  }
+  long long count = static_cast<long long>(threads) * per_thread;
+  ASSERT_EQ(total, count * (count - 1) / 2);
+  ASSERT_TRUE(queue.empty());
+}
@@ -215,4 +215,39 @@ TEST(Multiset, Find2) {
   s21::multiset<int> school1{7, 5, 3, 7, 11, 25, 1, -6, 11, 27, 33};
   ASSERT_EQ(*school1.begin(), *school1.find(-6));
   // ASSERT_EQ(school1.end(), school1.find(9999));
-}
\ No newline at end of file
+}
+
+TEST(Multiset, ExtractInsertNode) {
+  s21::multiset<int> school1 = {5, 1, 3, 3, 8};
+  std::multiset<int> std1 = {5, 1, 3, 3, 8};
+  s21::multiset<int> school2 = {2, 3, 9};
+  std::multiset<int> std2 = {2, 3, 9};
+  const int *key = &*school1.find(3);
+  auto node = school1.extract(3);
+  std2.insert(std1.extract(3));
+  ASSERT_EQ(&node.value(), key);
+  auto pos = school2.insert(std::move(node));
+  ASSERT_TRUE(node.empty());
+  ASSERT_EQ(&*pos, key);
+  ASSERT_EQ(*++pos, 9);
+  check_equals(school1, std1);
+  check_equals(school2, std2);
+
+  auto last = school2.extract(school2.find(9));
+  last.value() = 0;
+  std2.erase(9);
+  std2.insert(0);
+  const int *first = &*school2.insert(std::move(last));
+  ASSERT_EQ(first, &*school2.begin());
+  check_equals(school2, std2);
+  while (!school1.empty()) {
+    school2.insert(school1.extract(school1.begin()));
+  }
+  std2.merge(std1);
+  ASSERT_TRUE(school1.empty());
+  check_equals(school2, std2);
+  ASSERT_TRUE(school1.extract(4).empty());
+  school1.insert(school2.extract(8));
+  ASSERT_EQ(school1.size(), 1U);
+  ASSERT_EQ(*school1.begin(), 8);
+}
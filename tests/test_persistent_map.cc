@@ -0,0 +1,135 @@
+#include <map>
+#include <string>
+#include <vector>
+
+#include "../src/persistent/persistent_map.h"
+
+void check_equals(const s21::persistent_map<int, std::string> &s21_map,
+                  const std::map<int, std::string> &std_map) {
+  ASSERT_EQ(s21_map.size(), std_map.size());
+  auto it = s21_map.begin();
+  for (const auto &item : std_map) {
+    ASSERT_NE(it, s21_map.end());
+    ASSERT_EQ(it->first, item.first);
+    ASSERT_EQ(it->second, item.second);
+    ++it;
+  }
+  ASSERT_EQ(it, s21_map.end());
+}
+
+TEST(PersistentMap, Constructors) {
+  s21::persistent_map<int, std::string> s21_empty;
+  ASSERT_TRUE(s21_empty.empty());
+  ASSERT_EQ(s21_empty.begin(), s21_empty.end());
+  s21::persistent_map<int, std::string> s21_map = {{3, "c"}, {1, "a"}, {2, "b"},
+                                                   {1, "z"}};
+  std::map<int, std::string> std_map = {{3, "c"}, {1, "a"}, {2, "b"}};
+  check_equals(s21_map, std_map);
+  s21::persistent_map<int, std::string> s21_copy(s21_map);
+  ASSERT_TRUE(s21_copy.identical(s21_map));
+  s21::persistent_map<int, std::string> s21_moved(std::move(s21_copy));
+  check_equals(s21_moved, std_map);
+  s21_empty = s21_moved;
+  check_equals(s21_empty, std_map);
+}
+
+TEST(PersistentMap, VersionsStayIntact) {
+  std::vector<s21::persistent_map<int, std::string>> s21_versions(1);
+  std::vector<std::map<int, std::string>> std_versions(1);
+  for (int i = 0; i < 600; ++i) {
+    int key = (i * 7919) % 211;
+    auto s21_next = s21_versions.back();
+    auto std_next = std_versions.back();
+    if (i % 3 == 2) {
+      s21_next = s21_next.erase(key);
+      std_next.erase(key);
+    } else if (i % 3 == 1) {
+      s21_next = s21_next.insert_or_assign(key, std::to_string(i));
+      std_next.insert_or_assign(key, std::to_string(i));
+    } else {
+      s21_next = s21_next.insert({key, std::to_string(i)});
+      std_next.insert({key, std::to_string(i)});
+    }
+    s21_versions.push_back(s21_next);
+    std_versions.push_back(std_next);
+  }
+  for (size_t i = 0; i < s21_versions.size(); ++i) {
+    check_equals(s21_versions[i], std_versions[i]);
+  }
+}
+
+TEST(PersistentMap, Lookup) {
+  s21::persistent_map<int, std::string> s21_map = {{1, "a"}, {3, "c"}};
+  ASSERT_EQ(s21_map.at(3), "c");
+  using map_type = s21::persistent_map<int, std::string>;
+  const map_type &ref = s21_map;
+  ASSERT_THROW(ref.at(2), std::out_of_range);
+  ASSERT_TRUE(s21_map.contains(1));
+  ASSERT_EQ(s21_map.count(2), 0U);
+  ASSERT_EQ(s21_map.find(2), s21_map.end());
+  ASSERT_EQ(s21_map.find(3)->second, "c");
+  ASSERT_EQ(s21_map.lower_bound(2)->first, 3);
+  ASSERT_EQ(s21_map.lower_bound(4), s21_map.end());
+  ASSERT_TRUE(s21_map.insert({1, "x"}).identical(s21_map));
+  ASSERT_TRUE(s21_map.erase(2).identical(s21_map));
+  ASSERT_FALSE(s21_map.try_emplace(2, 2, 'b').identical(s21_map));
+  ASSERT_EQ(s21_map.try_emplace(2, 2, 'b').at(2), "bb");
+}
+
+TEST(PersistentMap, Transient) {
+  s21::persistent_map<int, std::string> s21_base = {{1, "a"}, {2, "b"}};
+  auto s21_transient = s21_base.transient();
+  std::map<int, std::string> std_map = {{1, "a"}, {2, "b"}};
+  for (int i = 0; i < 500; ++i) {
+    int key = (i * 37) % 101;
+    if (i % 4 == 3) {
+      ASSERT_EQ(s21_transient.erase(key), std_map.erase(key));
+    } else if (i % 4 == 2) {
+      ASSERT_EQ(s21_transient.insert_or_assign(key, std::to_string(i)),
+                std_map.insert_or_assign(key, std::to_string(i)).second);
+    } else {
+      ASSERT_EQ(s21_transient.try_emplace(key, std::to_string(i)),
+                std_map.try_emplace(key, std::to_string(i)).second);
+    }
+  }
+  auto s21_frozen = s21_transient.persistent();
+  check_equals(s21_frozen, std_map);
+  s21_transient.at(std_map.begin()->first) = "changed later";
+  s21_transient.insert({1000, "new"});
+  s21_transient.erase(std_map.rbegin()->first);
+  check_equals(s21_frozen, std_map);
+  check_equals(s21_base, {{1, "a"}, {2, "b"}});
+  ASSERT_EQ(s21_transient.at(std_map.begin()->first), "changed later");
+  ASSERT_EQ(s21_transient.size(), std_map.size());
+  ASSERT_THROW(s21_transient.at(-1), std::out_of_range);
+}
+
+struct CopyCounted {
+  static int copies;
+  explicit CopyCounted(int value) : value_(value) {}
+  CopyCounted(const CopyCounted &other) : value_(other.value_) { ++copies; }
+  CopyCounted &operator=(const CopyCounted &other) = default;
+  int value_;
+};
+
+int CopyCounted::copies = 0;
+
+TEST(PersistentMap, CopiesOnlyThePath) {
+  auto s21_transient = s21::persistent_map<int, CopyCounted>().transient();
+  for (int i = 0; i < 1 << 16; ++i) {
+    s21_transient.try_emplace(i, i);
+  }
+  auto s21_map = s21_transient.persistent();
+  CopyCounted::copies = 0;
+  auto s21_copy = s21_map;
+  ASSERT_EQ(CopyCounted::copies, 0);
+  auto s21_next = s21_map.insert_or_assign(12345, CopyCounted(-1));
+  ASSERT_LE(CopyCounted::copies, 24);
+  CopyCounted::copies = 0;
+  s21_next = s21_next.erase(777);
+  ASSERT_LE(CopyCounted::copies, 3 * 24);
+  ASSERT_EQ(s21_map.at(12345).value_, 12345);
+  ASSERT_EQ(s21_next.at(12345).value_, -1);
+  ASSERT_FALSE(s21_next.contains(777));
+  ASSERT_EQ(s21_next.size() + 1, s21_map.size());
+}
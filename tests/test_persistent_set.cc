@@ -0,0 +1,60 @@
+#include <set>
+#include <vector>
+
+#include "../src/persistent/persistent_set.h"
+
+void check_equals(const s21::persistent_set<int> &s21_set,
+                  const std::set<int> &std_set) {
+  ASSERT_EQ(s21_set.size(), std_set.size());
+  auto it = s21_set.begin();
+  for (int item : std_set) {
+    ASSERT_NE(it, s21_set.end());
+    ASSERT_EQ(*it, item);
+    ++it;
+  }
+  ASSERT_EQ(it, s21_set.end());
+}
+
+TEST(PersistentSet, VersionsStayIntact) {
+  std::vector<s21::persistent_set<int>> s21_versions = {{5, 1, 3}};
+  std::vector<std::set<int>> std_versions = {{5, 1, 3}};
+  for (int i = 0; i < 1000; ++i) {
+    int key = (i * 7919) % 307;
+    if (i % 2 == 1) {
+      s21_versions.push_back(s21_versions.back().erase(key / 2));
+      std_versions.push_back(std_versions.back());
+      std_versions.back().erase(key / 2);
+    } else {
+      s21_versions.push_back(s21_versions.back().insert(key));
+      std_versions.push_back(std_versions.back());
+      std_versions.back().insert(key);
+    }
+  }
+  for (size_t i = 0; i < s21_versions.size(); ++i) {
+    check_equals(s21_versions[i], std_versions[i]);
+  }
+  ASSERT_TRUE(s21_versions[0].contains(3));
+  ASSERT_EQ(*s21_versions[0].lower_bound(2), 3);
+}
+
+TEST(PersistentSet, Transient) {
+  s21::persistent_set<int> s21_base = {1, 2, 3};
+  auto s21_transient = s21_base.transient();
+  std::set<int> std_set = {1, 2, 3};
+  for (int i = 0; i < 2000; ++i) {
+    int key = (i * 37) % 401;
+    if (i % 3 == 2) {
+      ASSERT_EQ(s21_transient.erase(key), std_set.erase(key));
+    } else {
+      ASSERT_EQ(s21_transient.insert(key), std_set.insert(key).second);
+    }
+  }
+  auto s21_frozen = s21_transient.persistent();
+  check_equals(s21_frozen, std_set);
+  for (int key = 0; key < 401; key += 2) {
+    s21_transient.erase(key);
+  }
+  check_equals(s21_frozen, std_set);
+  check_equals(s21_base, {1, 2, 3});
+  ASSERT_FALSE(s21_transient.contains(2));
+}
@@ -0,0 +1,213 @@
+#include <memory>
+#include <queue>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../src/priority_queue/indexed_priority_queue.h"
+#include "../src/priority_queue/priority_queue.h"
+
+template <typename SchoolQueue, typename StdQueue>
+void check_drain(SchoolQueue &school, StdQueue &std) {
+  ASSERT_EQ(school.size(), std.size());
+  while (!std.empty()) {
+    ASSERT_EQ(school.top(), std.top());
+    school.pop();
+    std.pop();
+  }
+  ASSERT_TRUE(school.empty());
+}
+
+TEST(PriorityQueue, InitializerList) {
+  s21::priority_queue<int> school1{5, 1, 9, 3, 7, 2, 8};
+  std::priority_queue<int> std1;
+  for (int item : {5, 1, 9, 3, 7, 2, 8}) {
+    std1.push(item);
+  }
+  check_drain(school1, std1);
+}
+
+TEST(PriorityQueue, RandomPushPop) {
+  std::mt19937 generator(21);
+  s21::priority_queue<int, s21::vector<int>, std::less<int>, 2> school2;
+  s21::priority_queue<int, s21::vector<int>, std::greater<int>, 3> school3;
+  s21::priority_queue<int, s21::vector<int>, std::less<int>, 8> school8;
+  std::priority_queue<int> std2;
+  std::priority_queue<int, std::vector<int>, std::greater<int>> std3;
+  for (int i = 0; i < 5000; ++i) {
+    int value = static_cast<int>(generator() % 1000);
+    school2.push(value);
+    std2.push(value);
+    school3.push(value);
+    std3.push(value);
+    school8.push(value);
+    if (i % 3 == 0) {
+      ASSERT_EQ(school2.top(), std2.top());
+      ASSERT_EQ(school3.top(), std3.top());
+      school2.pop();
+      std2.pop();
+      school3.pop();
+      std3.pop();
+    }
+  }
+  ASSERT_EQ(school8.size(), 5000U);
+  check_drain(school2, std2);
+  check_drain(school3, std3);
+}
+
+TEST(PriorityQueue, CopyMoveSwap) {
+  s21::priority_queue<std::string> school1{"b", "d", "a"};
+  s21::priority_queue<std::string> school2 = school1;
+  ASSERT_EQ(school2.top(), "d");
+  s21::priority_queue<std::string> school3 = std::move(school2);
+  ASSERT_EQ(school3.size(), 3U);
+  s21::priority_queue<std::string> school4;
+  school4.emplace(3, 'z');
+  school4.swap(school3);
+  ASSERT_EQ(school3.top(), "zzz");
+  ASSERT_EQ(school4.top(), "d");
+  school4 = std::move(school3);
+  ASSERT_EQ(school4.top(), "zzz");
+  school4.insert_many("zzzz", "a");
+  ASSERT_EQ(school4.top(), "zzzz");
+}
+
+TEST(PriorityQueue, MoveOnly) {
+  struct Greater {
+    bool operator()(const std::unique_ptr<int> &lhs,
+                    const std::unique_ptr<int> &rhs) const {
+      return *lhs > *rhs;
+    }
+  };
+  s21::priority_queue<std::unique_ptr<int>, s21::vector<std::unique_ptr<int>>,
+                      Greater>
+      school1;
+  for (int i = 20; i > 0; --i) {
+    school1.push(std::make_unique<int>(i));
+  }
+  ASSERT_EQ(*school1.top(), 1);
+  school1.pop();
+  ASSERT_EQ(*school1.top(), 2);
+}
+
+TEST(IndexedPriorityQueue, DecreaseKey) {
+  s21::indexed_priority_queue<int, std::greater<int>> queue;
+  auto a = queue.push(50);
+  auto b = queue.push(40);
+  auto c = queue.push(30);
+  ASSERT_EQ(queue.top_handle(), c);
+  queue.decrease_key(a, 10);
+  ASSERT_EQ(queue.top_handle(), a);
+  ASSERT_EQ(queue.get(a), 10);
+  ASSERT_THROW(queue.decrease_key(b, 90), std::invalid_argument);
+  queue.update(a, 100);
+  ASSERT_EQ(queue.top_handle(), c);
+  queue.erase(c);
+  ASSERT_FALSE(queue.contains(c));
+  ASSERT_THROW(queue.erase(c), std::out_of_range);
+  ASSERT_EQ(queue.top(), 40);
+  queue.pop();
+  ASSERT_EQ(queue.top(), 100);
+  auto d = queue.push(1);
+  ASSERT_TRUE(d == b || d == c);
+  ASSERT_EQ(queue.top_handle(), d);
+  queue.clear();
+  ASSERT_TRUE(queue.empty());
+}
+
+TEST(IndexedPriorityQueue, Dijkstra) {
+  const int nodes = 200;
+  std::mt19937 generator(7);
+  std::vector<std::vector<std::pair<int, int>>> graph(nodes);
+  for (int i = 0; i < nodes * 5; ++i) {
+    int from = static_cast<int>(generator() % nodes);
+    int to = static_cast<int>(generator() % nodes);
+    int weight = static_cast<int>(generator() % 100) + 1;
+    graph[from].push_back({to, weight});
+  }
+  const int infinity = 1 << 30;
+
+  std::vector<int> expected(nodes, infinity);
+  std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int>>,
+                      std::greater<std::pair<int, int>>>
+      lazy;
+  expected[0] = 0;
+  lazy.push({0, 0});
+  while (!lazy.empty()) {
+    auto [dist, node] = lazy.top();
+    lazy.pop();
+    if (dist > expected[node]) continue;
+    for (auto [to, weight] : graph[node]) {
+      if (dist + weight < expected[to]) {
+        expected[to] = dist + weight;
+        lazy.push({expected[to], to});
+      }
+    }
+  }
+
+  s21::indexed_priority_queue<std::pair<int, int>,
+                              std::greater<std::pair<int, int>>>
+      queue;
+  std::vector<int> dist(nodes, infinity);
+  std::vector<size_t> handle(nodes);
+  std::vector<bool> queued(nodes, false);
+  dist[0] = 0;
+  handle[0] = queue.push({0, 0});
+  queued[0] = true;
+  while (!queue.empty()) {
+    int node = queue.top().second;
+    queue.pop();
+    queued[node] = false;
+    for (auto [to, weight] : graph[node]) {
+      if (dist[node] + weight < dist[to]) {
+        dist[to] = dist[node] + weight;
+        if (queued[to]) {
+          queue.decrease_key(handle[to], {dist[to], to});
+        } else {
+          handle[to] = queue.push({dist[to], to});
+          queued[to] = true;
+        }
+      }
+    }
+  }
+  ASSERT_EQ(dist, expected);
+}
+
+struct LiveCounted {
+  static int live;
+  explicit LiveCounted(int value) : value_(value) { ++live; }
+  LiveCounted(const LiveCounted &other) : value_(other.value_) { ++live; }
+  LiveCounted &operator=(const LiveCounted &other) = default;
+  ~LiveCounted() { --live; }
+  bool operator<(const LiveCounted &other) const {
+    return value_ < other.value_;
+  }
+  int value_;
+};
+
+int LiveCounted::live = 0;
+
+TEST(IndexedPriorityQueue, DestroysRemovedValues) {
+  {
+    s21::indexed_priority_queue<LiveCounted> queue;
+    for (int i = 0; i < 10; ++i) {
+      queue.emplace(i);
+    }
+    ASSERT_EQ(LiveCounted::live, 10);
+    queue.pop();
+    ASSERT_EQ(LiveCounted::live, 9);
+    auto handle = queue.push(LiveCounted(42));
+    ASSERT_EQ(LiveCounted::live, 10);
+    queue.erase(handle);
+    queue.pop();
+    ASSERT_EQ(LiveCounted::live, 8);
+    queue.emplace(5);
+    ASSERT_EQ(LiveCounted::live, 9);
+    ASSERT_EQ(queue.top().value_, 7);
+    queue.clear();
+    ASSERT_EQ(LiveCounted::live, 0);
+    queue.emplace(1);
+    ASSERT_EQ(queue.top().value_, 1);
+  }
+  ASSERT_EQ(LiveCounted::live, 0);
+}
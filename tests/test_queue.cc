@@ -78,4 +78,14 @@ TEST(Queue, OperatorMoveEqual) {
     school2.pop();
     std2.pop();
   }
-}
\ No newline at end of file
+}
+
+TEST(Queue, ChainedAssignment) {
+  s21::queue<int> school1{1, 2, 3};
+  s21::queue<int> school2;
+  s21::queue<int> school3;
+  school3 = school2 = school1;
+  ASSERT_EQ(school2.size(), 3U);
+  ASSERT_EQ(school3.front(), 1);
+  ASSERT_EQ(school3.back(), 3);
+}
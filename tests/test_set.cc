@@ -1,4 +1,10 @@
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <random>
 #include <set>
+#include <string>
+#include <string_view>
 #include <vector>
 
 #include "../src/set/set.h"
@@ -403,6 +409,61 @@ TEST(Set, Merge) {
   check_equals(school2, std2);
 }
 
+TEST(Set, MergeRelinksNodes) {
+  for (int other_size : {10, 900}) {
+    s21::set<int> school1;
+    std::set<int> std1;
+    s21::set<int> school2;
+    std::set<int> std2;
+    for (int i = 0; i < 1000; ++i) {
+      school1.insert(i * 3);
+      std1.insert(i * 3);
+    }
+    for (int i = 0; i < other_size; ++i) {
+      school2.insert(i * 5 - 50);
+      std2.insert(i * 5 - 50);
+    }
+    const int *moved = &*school2.find(-50);
+    const int *kept = &*school2.find(0);
+    school1.merge(school2);
+    std1.merge(std2);
+    check_equals(school1, std1);
+    check_equals(school2, std2);
+    ASSERT_EQ(&*school1.find(-50), moved);
+    ASSERT_EQ(&*school2.find(0), kept);
+    ASSERT_EQ(*school1.rbegin(), *std1.rbegin());
+    ASSERT_EQ(*school1.select(700), *std::next(std1.begin(), 700));
+    school1.erase(-50);
+    std1.erase(-50);
+    check_equals(school1, std1);
+  }
+}
+
+TEST(Set, ExtractInsertNode) {
+  s21::set<int> school1;
+  std::set<int> std1;
+  s21::set<int> school2 = {7};
+  std::set<int> std2 = {7};
+  for (int i = 0; i < 100; ++i) {
+    school1.insert(i);
+    std1.insert(i);
+  }
+  const int *key = &*school1.find(7);
+  auto node = school1.extract(school1.find(7));
+  std1.extract(7);
+  ASSERT_EQ(&node.value(), key);
+  auto result = school2.insert(std::move(node));
+  ASSERT_FALSE(result.inserted);
+  ASSERT_EQ(&result.node.value(), key);
+  result.node.value() = 500;
+  ASSERT_EQ(*school2.insert(school2.end(), std::move(result.node)), 500);
+  std2.insert(500);
+  ASSERT_EQ(&*school2.find(500), key);
+  ASSERT_TRUE(school1.extract(7).empty());
+  check_equals(school1, std1);
+  check_equals(school2, std2);
+}
+
 TEST(Set, CheckRbeginRendIterators) {
   s21::set<int> school1;
   std::set<int> std1;
@@ -420,3 +481,330 @@ TEST(Set, CheckRbeginRendIterators) {
     }
   }
 }
+
+TEST(Set, InsertReturnsExisting) {
+  s21::set<int> school1{1, 2};
+  auto result = school1.insert(2);
+  ASSERT_FALSE(result.second);
+  ASSERT_EQ(*result.first, 2);
+  result = school1.insert(3);
+  ASSERT_TRUE(result.second);
+  ASSERT_EQ(*result.first, 3);
+}
+
+TEST(Set, RandomInsertFind) {
+  std::mt19937 random(11);
+  s21::set<int> school1;
+  std::set<int> std1;
+  for (int i = 0; i < 20000; ++i) {
+    int key = static_cast<int>(random() % 5000);
+    ASSERT_EQ(school1.insert(key).second, std1.insert(key).second);
+  }
+  for (int key = -1; key <= 5000; ++key) {
+    ASSERT_EQ(school1.contains(key), std1.count(key) == 1);
+  }
+  check_equals(school1, std1);
+}
+
+TEST(Set, InsertWithHint) {
+  s21::set<int> school1;
+  std::set<int> std1;
+  for (int i = 0; i < 1000; i += 2) {
+    ASSERT_EQ(*school1.insert(school1.end(), i), i);
+    std1.insert(std1.end(), i);
+  }
+  for (int i = 1; i < 1000; i += 2) {
+    auto next = school1.find(i + 1);
+    ASSERT_EQ(*school1.emplace_hint(next, i), i);
+    std1.insert(i);
+  }
+  auto hint = school1.find(500);
+  ASSERT_EQ(school1.insert(hint, 500), hint);
+  ASSERT_EQ(*school1.insert(hint, -5), -5);
+  ASSERT_EQ(*school1.insert(school1.begin(), 5000), 5000);
+  std1.insert(-5);
+  std1.insert(5000);
+  check_equals(school1, std1);
+}
+
+TEST(Set, StructuralCopy) {
+  s21::set<std::string> school1;
+  std::set<std::string> std1;
+  for (int i = 0; i < 2000; ++i) {
+    school1.insert(std::to_string(i * 7 % 1999));
+    std1.insert(std::to_string(i * 7 % 1999));
+  }
+  s21::set<std::string> school2 = school1;
+  check_equals(school2, std1);
+  school2.insert("extra");
+  ASSERT_FALSE(school1.contains("extra"));
+}
+
+TEST(Set, FromSorted) {
+  std::vector<int> sorted;
+  for (int i = 0; i < 777; ++i) {
+    sorted.push_back(i * 2);
+  }
+  auto school1 = s21::set<int>::from_sorted(sorted);
+  std::set<int> std1(sorted.begin(), sorted.end());
+  check_equals(school1, std1);
+  for (int i = -1; i < 1600; ++i) {
+    ASSERT_EQ(school1.contains(i), std1.count(i) == 1);
+  }
+  std::vector<int> duplicates{1, 2, 2, 3};
+  ASSERT_THROW(s21::set<int>::from_sorted(duplicates), std::invalid_argument);
+}
+
+TEST(Set, CachedExtremes) {
+  s21::set<int> school1;
+  ASSERT_EQ(school1.begin(), school1.end());
+  ASSERT_EQ(school1.rbegin(), school1.rend());
+  std::set<int> std1;
+  for (int key : {50, 30, 70, 20, 80, 10, 90, 60}) {
+    school1.insert(key);
+    std1.insert(key);
+    ASSERT_EQ(*school1.begin(), *std1.begin());
+    ASSERT_EQ(*school1.rbegin(), *std1.rbegin());
+    ASSERT_EQ(*--school1.end(), *std1.rbegin());
+  }
+  school1.erase(10);
+  school1.erase(90);
+  school1.erase(50);
+  ASSERT_EQ(*school1.begin(), 20);
+  ASSERT_EQ(*school1.rbegin(), 80);
+  school1.clear();
+  ASSERT_EQ(school1.rbegin(), school1.rend());
+  school1.insert(5);
+  ASSERT_EQ(*school1.begin(), 5);
+  ASSERT_EQ(*school1.rbegin(), 5);
+}
+
+TEST(Set, RandomEraseKeepsOrder) {
+  std::mt19937 random(23);
+  s21::set<int> school1;
+  std::set<int> std1;
+  for (int i = 0; i < 20000; ++i) {
+    int key = static_cast<int>(random() % 2000);
+    if (random() % 3 == 0) {
+      school1.erase(key);
+      std1.erase(key);
+    } else {
+      school1.insert(key);
+      std1.insert(key);
+    }
+    if (!std1.empty()) {
+      ASSERT_EQ(*school1.begin(), *std1.begin());
+      ASSERT_EQ(*school1.rbegin(), *std1.rbegin());
+    }
+  }
+  check_equals(school1, std1);
+  auto copy = school1;
+  ASSERT_EQ(*copy.begin(), *std1.begin());
+  ASSERT_EQ(*copy.rbegin(), *std1.rbegin());
+  while (!school1.empty()) {
+    school1.erase(school1.rbegin());
+  }
+  ASSERT_EQ(school1.begin(), school1.end());
+}
+
+TEST(Set, TransparentLookup) {
+  s21::set<std::string, std::less<>> school1{"pear", "fig", "kiwi"};
+  ASSERT_EQ(*school1.find(std::string_view("fig")), "fig");
+  ASSERT_EQ(school1.find("plum"), school1.end());
+  ASSERT_TRUE(school1.contains("kiwi"));
+  ASSERT_EQ(school1.count(std::string_view("pear")), 1u);
+  ASSERT_EQ(school1.count("lime"), 0u);
+  ASSERT_EQ(*school1.lower_bound("g"), "kiwi");
+  ASSERT_EQ(school1.lower_bound("q"), school1.end());
+}
+
+TEST(Set, LowerBound) {
+  s21::set<int> school1;
+  std::set<int> std1;
+  for (int i = 0; i < 100; i += 4) {
+    school1.insert(i);
+    std1.insert(i);
+  }
+  for (int key = -1; key < 102; ++key) {
+    auto it = std1.lower_bound(key);
+    if (it == std1.end()) {
+      ASSERT_EQ(school1.lower_bound(key), school1.end());
+    } else {
+      ASSERT_EQ(*school1.lower_bound(key), *it);
+    }
+    ASSERT_EQ(school1.count(key), std1.count(key));
+  }
+}
+
+TEST(Set, BoundsAndRanges) {
+  s21::set<int> school1;
+  std::set<int> std1;
+  for (int i = 0; i < 200; i += 5) {
+    school1.insert(i);
+    std1.insert(i);
+  }
+  for (int key = -1; key <= 201; ++key) {
+    auto it = std1.upper_bound(key);
+    if (it == std1.end()) {
+      ASSERT_EQ(school1.upper_bound(key), school1.end());
+    } else {
+      ASSERT_EQ(*school1.upper_bound(key), *it);
+    }
+    auto range = school1.equal_range(key);
+    ASSERT_EQ(range.first, school1.lower_bound(key));
+    ASSERT_EQ(range.second, school1.upper_bound(key));
+  }
+  std::vector<int> window;
+  for (int key : school1.range(42, 71)) {
+    window.push_back(key);
+  }
+  ASSERT_EQ(window, std::vector<int>({45, 50, 55, 60, 65, 70}));
+  ASSERT_TRUE(school1.range(71, 42).empty());
+  ASSERT_TRUE(school1.range(46, 50).empty());
+  s21::set<std::string, std::less<>> words{"ant", "bee", "cat", "dog"};
+  std::string found;
+  for (const auto& word : words.range("b", std::string_view("d"))) {
+    found += word;
+  }
+  ASSERT_EQ(found, "beecat");
+}
+
+namespace {
+struct SumMonoid {
+  using value_type = long long;
+  static value_type identity() { return 0; }
+  static value_type lift(int key) { return key; }
+  static value_type combine(value_type lhs, value_type rhs) {
+    return lhs + rhs;
+  }
+};
+
+// Not commutative, so a fold in the wrong order shows up.
+struct ConcatMonoid {
+  using value_type = std::string;
+  static value_type identity() { return ""; }
+  static value_type lift(char key) { return std::string(1, key); }
+  static value_type combine(const value_type &lhs, const value_type &rhs) {
+    return lhs + rhs;
+  }
+};
+}  // namespace
+
+TEST(Set, RankSelect) {
+  std::mt19937 random(31);
+  s21::set<int> school1;
+  std::set<int> std1;
+  for (int i = 0; i < 6000; ++i) {
+    int key = static_cast<int>(random() % 3000);
+    if (random() % 3 == 0) {
+      school1.erase(key);
+      std1.erase(key);
+    } else {
+      school1.insert(key);
+      std1.insert(key);
+    }
+  }
+  std::vector<int> sorted(std1.begin(), std1.end());
+  for (size_t i = 0; i < sorted.size(); ++i) {
+    ASSERT_EQ(*school1.select(i), sorted[i]);
+    ASSERT_EQ(school1.rank(sorted[i]), i);
+  }
+  ASSERT_EQ(school1.select(sorted.size()), school1.end());
+  for (int i = 0; i < 300; ++i) {
+    int low = static_cast<int>(random() % 3100) - 50;
+    int high = static_cast<int>(random() % 3100) - 50;
+    size_t expected = 0;
+    if (low < high) {
+      expected = static_cast<size_t>(std::distance(std1.lower_bound(low),
+                                                   std1.lower_bound(high)));
+    }
+    ASSERT_EQ(school1.count_range(low, high), expected);
+  }
+}
+
+TEST(Set, MonoidAggregate) {
+  std::mt19937 random(37);
+  s21::set<int, std::less<int>, std::allocator<int>, SumMonoid> school1;
+  std::set<int> std1;
+  ASSERT_EQ(school1.aggregate(), 0);
+  for (int i = 0; i < 4000; ++i) {
+    int key = static_cast<int>(random() % 2000);
+    if (random() % 4 == 0) {
+      school1.erase(key);
+      std1.erase(key);
+    } else {
+      school1.insert(key);
+      std1.insert(key);
+    }
+  }
+  ASSERT_EQ(school1.aggregate(),
+            std::accumulate(std1.begin(), std1.end(), 0LL));
+  for (int i = 0; i < 300; ++i) {
+    int low = static_cast<int>(random() % 2100) - 50;
+    int high = static_cast<int>(random() % 2100) - 50;
+    long long expected = 0;
+    if (low < high) {
+      expected = std::accumulate(std1.lower_bound(low), std1.lower_bound(high),
+                                 0LL);
+    }
+    ASSERT_EQ(school1.aggregate(low, high), expected);
+  }
+  auto copy = school1;
+  ASSERT_EQ(copy.aggregate(), school1.aggregate());
+}
+
+TEST(Set, MonoidAggregateAfterMerge) {
+  for (int other_size : {5, 500}) {
+    s21::set<int, std::less<int>, std::allocator<int>, SumMonoid> school1;
+    s21::set<int, std::less<int>, std::allocator<int>, SumMonoid> school2;
+    std::set<int> std1;
+    std::set<int> std2;
+    for (int i = 0; i < 600; ++i) {
+      school1.insert(i * 2);
+      std1.insert(i * 2);
+    }
+    for (int i = 0; i < other_size; ++i) {
+      school2.insert(i * 3);
+      std2.insert(i * 3);
+    }
+    school1.merge(school2);
+    std1.merge(std2);
+    ASSERT_EQ(school1.aggregate(),
+              std::accumulate(std1.begin(), std1.end(), 0LL));
+    ASSERT_EQ(school2.aggregate(),
+              std::accumulate(std2.begin(), std2.end(), 0LL));
+    ASSERT_EQ(school1.aggregate(100, 300),
+              std::accumulate(std1.lower_bound(100), std1.lower_bound(300),
+                              0LL));
+  }
+}
+
+TEST(Set, MonoidAggregateAfterExtract) {
+  s21::set<int, std::less<int>, std::allocator<int>, SumMonoid> school1;
+  s21::set<int, std::less<int>, std::allocator<int>, SumMonoid> school2;
+  for (int i = 1; i <= 100; ++i) {
+    school1.insert(i);
+  }
+  for (int i = 1; i <= 100; i += 3) {
+    auto node = school1.extract(i);
+    node.value() += 1000;
+    school2.insert(std::move(node));
+  }
+  auto dropped = school1.extract(2);
+  ASSERT_EQ(school1.aggregate(), 5050LL - 1717 - 2);
+  ASSERT_EQ(school2.aggregate(), 1717LL + 34 * 1000);
+  ASSERT_EQ(school2.aggregate(1000, 1050), 425 + 17 * 1000LL);
+}
+
+TEST(Set, MonoidAggregateKeepsOrder) {
+  s21::set<char, std::less<char>, std::allocator<char>, ConcatMonoid> letters;
+  for (char letter : std::string("qwertyuiopasdfghjklzxcvbnm")) {
+    letters.insert(letter);
+  }
+  ASSERT_EQ(letters.aggregate(), "abcdefghijklmnopqrstuvwxyz");
+  ASSERT_EQ(letters.aggregate('d', 'k'), "defghij");
+  letters.erase('f');
+  letters.erase('a');
+  ASSERT_EQ(letters.aggregate('a', 'h'), "bcdeg");
+  ASSERT_EQ(letters.aggregate('x', 'c'), "");
+}
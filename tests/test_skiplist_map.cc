@@ -0,0 +1,110 @@
+#include <atomic>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../src/map/skiplist_map.h"
+
+void check_equals(const s21::skiplist_map<int, std::string> &s21_map,
+                  const std::map<int, std::string> &std_map) {
+  ASSERT_EQ(s21_map.size(), std_map.size());
+  auto it = s21_map.begin();
+  for (const auto &item : std_map) {
+    ASSERT_NE(it, s21_map.end());
+    ASSERT_EQ(it->first, item.first);
+    ASSERT_EQ(it->second, item.second);
+    ++it;
+  }
+  ASSERT_EQ(it, s21_map.end());
+}
+
+TEST(SkiplistMap, InsertFindErase) {
+  s21::skiplist_map<int, std::string> s21_map;
+  std::map<int, std::string> std_map;
+  ASSERT_TRUE(s21_map.empty());
+  ASSERT_EQ(s21_map.begin(), s21_map.end());
+  for (int i = 0; i < 1000; ++i) {
+    int key = (i * 7919) % 1009;
+    std::string value = std::to_string(i);
+    ASSERT_EQ(s21_map.insert(key, value), std_map.emplace(key, value).second);
+  }
+  ASSERT_FALSE(s21_map.emplace(5, 3, 'x'));
+  ASSERT_TRUE(s21_map.emplace(-1, 3, 'x'));
+  std_map.emplace(-1, "xxx");
+  check_equals(s21_map, std_map);
+  ASSERT_EQ(*s21_map.find(-1), "xxx");
+  ASSERT_FALSE(s21_map.find(2000).has_value());
+  ASSERT_TRUE(s21_map.contains(7));
+  ASSERT_EQ(s21_map.count(2000), 0U);
+  for (int key = 0; key < 1100; key += 3) {
+    ASSERT_EQ(s21_map.erase(key), std_map.erase(key));
+  }
+  check_equals(s21_map, std_map);
+  ASSERT_FALSE(s21_map.contains(3));
+  ASSERT_EQ(s21_map.lower_bound(3)->first, std_map.lower_bound(3)->first);
+  ASSERT_EQ(s21_map.lower_bound(5000), s21_map.end());
+}
+
+TEST(SkiplistMap, IteratorSurvivesErase) {
+  s21::skiplist_map<int, std::string> s21_map;
+  for (int i = 0; i < 10; ++i) {
+    s21_map.insert(i, std::to_string(i));
+  }
+  auto it = s21_map.lower_bound(4);
+  ASSERT_EQ(s21_map.erase(4), 1U);
+  ASSERT_EQ(s21_map.erase(5), 1U);
+  ASSERT_EQ(it->second, "4");
+  ++it;
+  ASSERT_EQ(it->first, 6);
+  s21_map.insert(7, "again");
+  ASSERT_EQ((++it)->first, 7);
+}
+
+TEST(SkiplistMap, ManyThreads) {
+  const int threads = 4;
+  const int per_thread = 20000;
+  s21::skiplist_map<int, int> s21_map;
+  std::atomic<int> inserted{0};
+  std::atomic<int> erased{0};
+  std::vector<std::thread> workers;
+  for (int t = 0; t < threads; ++t) {
+    workers.emplace_back([&, t]() {
+      for (int i = 0; i < per_thread; ++i) {
+        int key = (i * 31 + t) % 5000;
+        if (s21_map.insert(key, key * 2)) {
+          inserted.fetch_add(1);
+        }
+        auto found = s21_map.find(key ^ 1);
+        if (found) {
+          ASSERT_EQ(*found, (key ^ 1) * 2);
+        }
+        if (i % 3 == 0) {
+          erased.fetch_add(static_cast<int>(s21_map.erase(key)));
+        }
+      }
+    });
+  }
+  workers.emplace_back([&]() {
+    for (int pass = 0; pass < 20; ++pass) {
+      int last = -1;
+      for (const auto &item : s21_map) {
+        ASSERT_LT(last, item.first);
+        ASSERT_EQ(item.second, item.first * 2);
+        last = item.first;
+      }
+    }
+  });
+  for (auto &worker : workers) {
+    worker.join();
+  }
+  size_t left = 0;
+  int last = -1;
+  for (const auto &item : s21_map) {
+    ASSERT_LT(last, item.first);
+    last = item.first;
+    ++left;
+  }
+  ASSERT_EQ(left, s21_map.size());
+  ASSERT_EQ(static_cast<int>(left), inserted.load() - erased.load());
+}
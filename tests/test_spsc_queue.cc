@@ -0,0 +1,116 @@
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../src/queue/spsc_queue.h"
+
+TEST(SpscQueue, PushPop) {
+  s21::spsc_queue<int> queue(3);
+  ASSERT_EQ(queue.capacity(), 4U);
+  ASSERT_TRUE(queue.empty());
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_TRUE(queue.try_push(i));
+  }
+  ASSERT_FALSE(queue.try_push(4));
+  ASSERT_EQ(queue.size(), 4U);
+  ASSERT_EQ(*queue.front(), 0);
+  int value = -1;
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_TRUE(queue.try_pop(value));
+    ASSERT_EQ(value, i);
+  }
+  ASSERT_FALSE(queue.try_pop(value));
+  ASSERT_EQ(queue.front(), nullptr);
+}
+
+TEST(SpscQueue, Batch) {
+  s21::spsc_queue<std::string> queue(8);
+  std::vector<std::string> input{"a", "b", "c", "d", "e", "f"};
+  ASSERT_EQ(queue.try_push_n(input.begin(), input.size()), 6U);
+  ASSERT_EQ(queue.try_push_n(input.begin(), input.size()), 2U);
+  std::vector<std::string> output(10);
+  ASSERT_EQ(queue.try_pop_n(output.begin(), 10), 8U);
+  ASSERT_EQ(output[0], "a");
+  ASSERT_EQ(output[5], "f");
+  ASSERT_EQ(output[7], "b");
+  ASSERT_TRUE(queue.empty());
+}
+
+TEST(SpscQueue, LeftoversDestroyed) {
+  s21::spsc_queue<std::vector<int>> queue(4);
+  queue.try_emplace(100, 1);
+  queue.try_push(std::vector<int>{1, 2});
+  ASSERT_EQ(queue.front()->size(), 100U);
+}
+
+struct SpscThrowingValue {
+  explicit SpscThrowingValue(int v = 0) : value(v) { ++live; }
+  SpscThrowingValue(const SpscThrowingValue &other) : value(other.value) {
+    if (value < 0) {
+      throw std::runtime_error("copy");
+    }
+    ++live;
+  }
+  SpscThrowingValue &operator=(const SpscThrowingValue &) = default;
+  ~SpscThrowingValue() { --live; }
+  int value;
+  static int live;
+};
+
+int SpscThrowingValue::live = 0;
+
+TEST(SpscQueue, FailedBatchPublishesCopiedItems) {
+  {
+    s21::spsc_queue<SpscThrowingValue> queue(8);
+    std::vector<SpscThrowingValue> input;
+    input.reserve(4);
+    for (int v : {1, 2, -1, 4}) {
+      input.emplace_back(v);
+    }
+    ASSERT_THROW(queue.try_push_n(input.begin(), input.size()),
+                 std::runtime_error);
+    ASSERT_EQ(queue.size(), 2U);
+    ASSERT_EQ(SpscThrowingValue::live, 6);
+    SpscThrowingValue out;
+    ASSERT_TRUE(queue.try_pop(out));
+    ASSERT_EQ(out.value, 1);
+    ASSERT_TRUE(queue.try_push(input[3]));
+    ASSERT_TRUE(queue.try_pop(out));
+    ASSERT_EQ(out.value, 2);
+    ASSERT_TRUE(queue.try_pop(out));
+    ASSERT_EQ(out.value, 4);
+    ASSERT_TRUE(queue.empty());
+  }
+  ASSERT_EQ(SpscThrowingValue::live, 0);
+}
+
+TEST(SpscQueue, TwoThreads) {
+  const int count = 1000000;
+  s21::spsc_queue<int> queue(1024);
+  std::thread producer([&queue]() {
+    int batch[16];
+    for (int i = 0; i < count;) {
+      int n = std::min(16, count - i);
+      for (int j = 0; j < n; ++j) {
+        batch[j] = i + j;
+      }
+      i += static_cast<int>(queue.try_push_n(batch, n));
+    }
+  });
+  long long sum = 0;
+  int expected = 0;
+  bool ordered = true;
+  int buffer[32];
+  while (expected < count) {
+    size_t n = queue.try_pop_n(buffer, 32);
+    for (size_t i = 0; i < n; ++i) {
+      ordered = ordered && buffer[i] == expected;
+      sum += buffer[i];
+      ++expected;
+    }
+  }
+  producer.join();
+  ASSERT_TRUE(ordered);
+  ASSERT_EQ(sum, static_cast<long long>(count) * (count - 1) / 2);
+}
@@ -1,5 +1,6 @@
 #include <list>
 #include <stack>
+#include <string>
 
 #include "../src/list/list.h"
 #include "../src/stack/stack.h"
@@ -84,4 +85,77 @@ TEST(Stack, OperatorMoveEqual) {
     std2.pop();
   }
   ASSERT_EQ(school1.empty(), true);
-}
\ No newline at end of file
+}
+
+TEST(Stack, EmplaceAndMovePush) {
+  s21::stack<std::string> school1;
+  std::stack<std::string> std1;
+  school1.reserve(100);
+  std::string long_string(64, 'x');
+  school1.push(std::move(long_string));
+  std1.push(std::string(64, 'x'));
+  school1.emplace(3, 'a');
+  std1.emplace(3, 'a');
+  school1.push(school1.top());
+  std1.push(std1.top());
+  ASSERT_EQ(school1.size(), std1.size());
+  while (!school1.empty()) {
+    ASSERT_EQ(school1.top(), std1.top());
+    school1.pop();
+    std1.pop();
+  }
+}
+
+TEST(Stack, SelfReferencingPushGrows) {
+  s21::stack<std::string> school1;
+  school1.push(std::string(40, 'y'));
+  for (int i = 0; i < 100; ++i) {
+    school1.push(school1.top());
+  }
+  ASSERT_EQ(school1.size(), 101U);
+  ASSERT_EQ(school1.top(), std::string(40, 'y'));
+}
+
+TEST(Stack, ChainedAssignment) {
+  s21::stack<int> school1{1, 2, 3};
+  s21::stack<int> school2;
+  s21::stack<int> school3;
+  school3 = school2 = school1;
+  ASSERT_EQ(school2.size(), 3U);
+  ASSERT_EQ(school3.size(), 3U);
+  ASSERT_EQ(school3.top(), 3);
+}
+
+TEST(Stack, ListBacked) {
+  s21::stack<int, s21::list<int>> school1;
+  std::stack<int, std::list<int>> std1;
+  for (int i = 0; i < 100; ++i) {
+    school1.push(i);
+    std1.push(i);
+  }
+  school1.insert_many_front(7, 8);
+  std1.push(7);
+  std1.push(8);
+  while (!school1.empty()) {
+    ASSERT_EQ(school1.top(), std1.top());
+    school1.pop();
+    std1.pop();
+  }
+}
+
+TEST(Stack, ListBackedEmplace) {
+  s21::stack<std::string, s21::list<std::string>> school1;
+  std::stack<std::string, std::list<std::string>> std1;
+  std::string moved(40, 'm');
+  school1.push(std::move(moved));
+  std1.push(std::string(40, 'm'));
+  ASSERT_TRUE(moved.empty());
+  school1.emplace(5, 'e');
+  std1.emplace(5, 'e');
+  ASSERT_EQ(school1.size(), std1.size());
+  while (!school1.empty()) {
+    ASSERT_EQ(school1.top(), std1.top());
+    school1.pop();
+    std1.pop();
+  }
+}
@@ -0,0 +1,69 @@
+#include <atomic>
+#include <stdexcept>
+
+#include "../src/thread_pool/thread_pool.h"
+
+TEST(ThreadPool, RunsExternalTasks) {
+  s21::thread_pool pool(4);
+  ASSERT_EQ(pool.size(), 4U);
+  pool.wait();
+  std::atomic<long> sum{0};
+  for (int i = 1; i <= 10000; ++i) {
+    pool.submit([&sum, i]() { sum.fetch_add(i); });
+  }
+  pool.wait();
+  ASSERT_EQ(sum.load(), 10000L * 10001 / 2);
+}
+
+namespace {
+
+void spawnTree(s21::thread_pool &pool, std::atomic<int> &nodes, int depth) {
+  nodes.fetch_add(1);
+  if (depth > 0) {
+    pool.submit([&pool, &nodes, depth]() { spawnTree(pool, nodes, depth - 1); });
+    pool.submit([&pool, &nodes, depth]() { spawnTree(pool, nodes, depth - 1); });
+  }
+}
+
+}  // namespace
+
+TEST(ThreadPool, TasksSubmitTasks) {
+  s21::thread_pool pool(4);
+  std::atomic<int> nodes{0};
+  pool.submit([&pool, &nodes]() { spawnTree(pool, nodes, 14); });
+  pool.wait();
+  ASSERT_EQ(nodes.load(), (1 << 15) - 1);
+  pool.submit([&pool, &nodes]() { spawnTree(pool, nodes, 3); });
+  pool.wait();
+  ASSERT_EQ(nodes.load(), (1 << 15) - 1 + 15);
+}
+
+TEST(ThreadPool, Exceptions) {
+  ASSERT_THROW(s21::thread_pool(0), std::invalid_argument);
+  s21::thread_pool pool(2);
+  std::atomic<int> ran{0};
+  for (int i = 0; i < 100; ++i) {
+    pool.submit([&ran, i]() {
+      ran.fetch_add(1);
+      if (i == 50) {
+        throw std::runtime_error("task failed");
+      }
+    });
+  }
+  ASSERT_THROW(pool.wait(), std::runtime_error);
+  ASSERT_EQ(ran.load(), 100);
+  pool.submit([&pool]() { pool.wait(); });
+  ASSERT_THROW(pool.wait(), std::logic_error);
+  pool.wait();
+}
+
+TEST(ThreadPool, DestructorDrains) {
+  std::atomic<int> ran{0};
+  {
+    s21::thread_pool pool(3);
+    for (int i = 0; i < 1000; ++i) {
+      pool.submit([&ran]() { ran.fetch_add(1); });
+    }
+  }
+  ASSERT_EQ(ran.load(), 1000);
+}
@@ -0,0 +1,181 @@
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+
+#include "../src/timer_wheel/timer_wheel.h"
+
+TEST(TimerWheel, ScheduleAndAdvance) {
+  s21::timer_wheel<std::string> wheel;
+  ASSERT_TRUE(wheel.empty());
+  auto first = wheel.schedule(5, "five");
+  wheel.schedule(70, std::string("seventy"));
+  wheel.emplace(3, 5, 't');
+  ASSERT_EQ(wheel.size(), 3U);
+  ASSERT_EQ(wheel.get(first), "five");
+  ASSERT_EQ(wheel.deadline(first), 5U);
+  auto expired = wheel.advance(4);
+  ASSERT_EQ(expired.size(), 1U);
+  ASSERT_EQ(expired[0], "ttttt");
+  expired = wheel.advance(69);
+  ASSERT_EQ(expired.size(), 1U);
+  ASSERT_EQ(expired[0], "five");
+  ASSERT_FALSE(wheel.contains(first));
+  ASSERT_EQ(wheel.now(), 69U);
+  expired = wheel.advance(1000000);
+  ASSERT_EQ(expired.size(), 1U);
+  ASSERT_EQ(expired[0], "seventy");
+  ASSERT_TRUE(wheel.empty());
+}
+
+TEST(TimerWheel, CancelAndReschedule) {
+  s21::timer_wheel<int> wheel(100);
+  auto a = wheel.schedule(150, 1);
+  auto b = wheel.schedule(5000, 2);
+  auto c = wheel.schedule(50, 3);
+  ASSERT_TRUE(wheel.cancel(a));
+  ASSERT_FALSE(wheel.cancel(a));
+  ASSERT_THROW(wheel.get(a), std::out_of_range);
+  wheel.reschedule(b, 120);
+  s21::vector<int> expired;
+  ASSERT_EQ(wheel.advance(200, expired), 2U);
+  ASSERT_EQ(expired[0], 3);
+  ASSERT_EQ(expired[1], 2);
+  ASSERT_FALSE(wheel.contains(c));
+  auto d = wheel.schedule(300, 4);
+  ASSERT_TRUE(d == a || d == b || d == c);
+  wheel.clear();
+  ASSERT_TRUE(wheel.empty());
+  ASSERT_EQ(wheel.advance(1000).size(), 0U);
+}
+
+TEST(TimerWheel, FarDeadlines) {
+  s21::timer_wheel<uint64_t> wheel;
+  const uint64_t far[] = {UINT64_C(1) << 40, (UINT64_C(1) << 62) + 12345,
+                          UINT64_C(0xFFFFFFFFFFFFFFF0)};
+  for (uint64_t deadline : far) {
+    wheel.schedule(deadline, deadline);
+  }
+  for (uint64_t deadline : far) {
+    ASSERT_EQ(wheel.advance(deadline - 1).size(), 0U);
+    auto expired = wheel.advance(deadline);
+    ASSERT_EQ(expired.size(), 1U);
+    ASSERT_EQ(expired[0], deadline);
+  }
+}
+
+TEST(TimerWheel, AdvanceToLastTick) {
+  const uint64_t last = UINT64_MAX;
+  s21::timer_wheel<int> wheel;
+  wheel.schedule(100, 5);
+  wheel.schedule(last, 6);
+  wheel.schedule(last - 1, 7);
+  auto expired = wheel.advance(last);
+  ASSERT_EQ(expired.size(), 3U);
+  ASSERT_EQ(expired[0], 5);
+  ASSERT_EQ(expired[1], 7);
+  ASSERT_EQ(expired[2], 6);
+  ASSERT_EQ(wheel.now(), last);
+  wheel.schedule(last, 8);
+  wheel.schedule(3, 9);
+  expired = wheel.advance(last);
+  ASSERT_EQ(expired.size(), 2U);
+  ASSERT_EQ(expired[0], 9);
+  ASSERT_EQ(expired[1], 8);
+  ASSERT_EQ(wheel.advance(last).size(), 0U);
+  ASSERT_EQ(wheel.now(), last);
+}
+
+TEST(TimerWheel, StartAtLastTick) {
+  s21::timer_wheel<int> wheel(UINT64_MAX);
+  ASSERT_EQ(wheel.now(), UINT64_MAX);
+  wheel.schedule(UINT64_MAX, 1);
+  wheel.schedule(0, 2);
+  auto expired = wheel.advance(UINT64_MAX);
+  ASSERT_EQ(expired.size(), 2U);
+  ASSERT_EQ(expired[0], 2);
+  ASSERT_EQ(expired[1], 1);
+  ASSERT_TRUE(wheel.empty());
+}
+
+TEST(TimerWheel, PastDueInDeadlineOrder) {
+  s21::timer_wheel<int> wheel;
+  wheel.advance(20);
+  wheel.schedule(3, 3);
+  wheel.schedule(1, 1);
+  wheel.schedule(2, 2);
+  wheel.schedule(1, 10);
+  wheel.schedule(25, 25);
+  auto expired = wheel.advance(30);
+  ASSERT_EQ(expired.size(), 5U);
+  ASSERT_EQ(expired[0], 1);
+  ASSERT_EQ(expired[1], 10);
+  ASSERT_EQ(expired[2], 2);
+  ASSERT_EQ(expired[3], 3);
+  ASSERT_EQ(expired[4], 25);
+}
+
+TEST(TimerWheel, MatchesOrderedMap) {
+  std::mt19937_64 random(42);
+  s21::timer_wheel<int> wheel;
+  std::multimap<uint64_t, int> timers;
+  std::map<int, std::pair<s21::timer_wheel<int>::handle_type, uint64_t>> live;
+  uint64_t now = 0;
+  int next_id = 0;
+  for (int round = 0; round < 2000; ++round) {
+    for (int i = 0; i < 20; ++i) {
+      uint64_t span = UINT64_C(1) << (random() % 24);
+      uint64_t deadline = now + random() % span;
+      int id = next_id++;
+      live[id] = {wheel.schedule(deadline, id), deadline};
+      timers.emplace(deadline, id);
+    }
+    for (int i = 0; i < 5 && !live.empty(); ++i) {
+      auto it = live.lower_bound(static_cast<int>(random() % next_id));
+      if (it == live.end()) {
+        continue;
+      }
+      ASSERT_TRUE(wheel.cancel(it->second.first));
+      auto range = timers.equal_range(it->second.second);
+      for (auto t = range.first; t != range.second; ++t) {
+        if (t->second == it->first) {
+          timers.erase(t);
+          break;
+        }
+      }
+      live.erase(it);
+    }
+    now += random() % (UINT64_C(1) << (random() % 20));
+    auto expired = wheel.advance(now);
+    auto end = timers.upper_bound(now);
+    std::multimap<uint64_t, int> due(timers.begin(), end);
+    timers.erase(timers.begin(), end);
+    ASSERT_EQ(expired.size(), due.size());
+    uint64_t previous = 0;
+    for (size_t i = 0; i < expired.size(); ++i) {
+      uint64_t deadline = live.at(expired[i]).second;
+      ASSERT_LE(deadline, now);
+      ASSERT_GE(deadline, previous);
+      previous = deadline;
+      live.erase(expired[i]);
+    }
+    ASSERT_EQ(wheel.size(), timers.size());
+  }
+}
+
+TEST(TimerWheel, DestroysRemovedValues) {
+  auto payload = std::make_shared<int>(1);
+  s21::timer_wheel<std::shared_ptr<int>> wheel;
+  auto handle = wheel.schedule(10, payload);
+  wheel.schedule(20, payload);
+  wheel.schedule(30, payload);
+  ASSERT_EQ(payload.use_count(), 4);
+  wheel.cancel(handle);
+  ASSERT_EQ(payload.use_count(), 3);
+  wheel.advance(25).clear();
+  ASSERT_EQ(payload.use_count(), 2);
+  wheel.clear();
+  ASSERT_EQ(payload.use_count(), 1);
+}
@@ -1,3 +1,5 @@
+#include <set>
+#include <vector>
 
 #include "../src/adt/tree.h"
 
@@ -43,3 +45,79 @@ TEST(Tree, True) {
   auto it2 = a.begin();
   ASSERT_EQ(*it2, 23);
 }
+
+TEST(Tree, IterateBothWays) {
+  s21::Tree<int, int> tree;
+  std::set<int> expected;
+  for (int i = 0; i < 200; ++i) {
+    int key = (i * 37) % 101 - 50;
+    tree.insert(key);
+    expected.insert(key);
+  }
+  std::vector<int> forward;
+  for (auto it = tree.begin(); it != tree.end(); ++it) {
+    forward.push_back(*it);
+  }
+  ASSERT_EQ(forward, std::vector<int>(expected.begin(), expected.end()));
+
+  auto last = tree.end();
+  --last;
+  ASSERT_EQ(*last, *expected.rbegin());
+  std::vector<int> backward;
+  for (auto it = tree.end(); it != tree.begin();) {
+    --it;
+    backward.push_back(*it);
+  }
+  ASSERT_EQ(backward, std::vector<int>(expected.rbegin(), expected.rend()));
+
+  // Stepping off the last element and back lands on it again.
+  auto it = last;
+  ++it;
+  ASSERT_TRUE(it == tree.end());
+  --it;
+  ASSERT_EQ(*it, *expected.rbegin());
+}
+
+TEST(Tree, MergeMovesMissingKeys) {
+  s21::Tree<int, int> target;
+  s21::Tree<int, int> source;
+  std::set<int> std_target;
+  std::set<int> std_source;
+  for (int i = 0; i < 300; ++i) {
+    target.insert(i * 2);
+    std_target.insert(i * 2);
+  }
+  for (int i = 0; i < 200; ++i) {
+    source.insert(i * 3);
+    std_source.insert(i * 3);
+  }
+  target.merge(source);
+  std_target.merge(std_source);
+  std::vector<int> merged;
+  for (auto it = target.begin(); it != target.end(); ++it) {
+    merged.push_back(*it);
+  }
+  ASSERT_EQ(merged, std::vector<int>(std_target.begin(), std_target.end()));
+  // Keys already in the target stay behind in the source.
+  std::vector<int> left;
+  for (auto it = source.begin(); it != source.end(); ++it) {
+    left.push_back(*it);
+  }
+  ASSERT_EQ(left, std::vector<int>(std_source.begin(), std_source.end()));
+  ASSERT_EQ(target.size(), std_target.size());
+  ASSERT_EQ(source.size(), std_source.size());
+
+  s21::Tree<int, int> empty;
+  target.merge(empty);
+  ASSERT_EQ(target.size(), std_target.size());
+  ASSERT_TRUE(empty.empty());
+  empty.merge(source);
+  ASSERT_EQ(empty.size(), std_source.size());
+  ASSERT_TRUE(source.empty());
+
+  target.merge(target);
+  ASSERT_EQ(target.size(), std_target.size());
+  auto last = target.end();
+  --last;
+  ASSERT_EQ(*last, *std_target.rbegin());
+}
@@ -0,0 +1,179 @@
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "../src/unordered/unordered_map.h"
+
+template <typename Key, typename Value, typename Hash, typename KeyEqual>
+void check_equals(const s21::unordered_map<Key, Value, Hash, KeyEqual> &lhs,
+                  const std::unordered_map<Key, Value> &rhs) {
+  ASSERT_EQ(lhs.size(), rhs.size());
+  size_t visited = 0;
+  for (const auto &item : lhs) {
+    auto it = rhs.find(item.first);
+    ASSERT_NE(it, rhs.end());
+    ASSERT_EQ(item.second, it->second);
+    ++visited;
+  }
+  ASSERT_EQ(visited, rhs.size());
+}
+
+namespace {
+
+struct StringHash {
+  using is_transparent = void;
+  size_t operator()(std::string_view text) const {
+    return std::hash<std::string_view>()(text);
+  }
+};
+
+// Sends every key to the same probe start and control byte.
+struct CollidingHash {
+  size_t operator()(int) const { return 42; }
+};
+
+}  // namespace
+
+TEST(UnorderedMap, InsertAndLookup) {
+  s21::unordered_map<int, char> school1 = {{3, 'c'}, {1, 'a'}, {2, 'b'}};
+  std::unordered_map<int, char> std1 = {{3, 'c'}, {1, 'a'}, {2, 'b'}};
+  check_equals(school1, std1);
+  ASSERT_FALSE(school1.insert(std::make_pair(2, 'z')).second);
+  ASSERT_TRUE(school1.insert(4, 'd').second);
+  std1.emplace(4, 'd');
+  check_equals(school1, std1);
+  ASSERT_EQ(school1.at(4), 'd');
+  ASSERT_THROW(school1.at(5), std::out_of_range);
+  ASSERT_EQ(school1.find(5), school1.end());
+  ASSERT_EQ(school1.count(1), 1U);
+  school1[7] = 'g';
+  ASSERT_EQ(school1.at(7), 'g');
+  ASSERT_EQ(school1[8], '\0');
+}
+
+TEST(UnorderedMap, TryEmplaceAndInsertOrAssign) {
+  std::string value = "kept";
+  s21::unordered_map<int, std::string> school1;
+  school1.try_emplace(1, "one");
+  ASSERT_FALSE(school1.try_emplace(1, std::move(value)).second);
+  ASSERT_EQ(value, "kept");
+  ASSERT_FALSE(school1.insert_or_assign(1, "uno").second);
+  ASSERT_TRUE(school1.insert_or_assign(2, "dos").second);
+  ASSERT_EQ(school1.at(1), "uno");
+  ASSERT_EQ(school1.at(2), "dos");
+  ASSERT_TRUE(school1.emplace(3, "tres").second);
+  ASSERT_EQ(school1.size(), 3U);
+}
+
+TEST(UnorderedMap, RandomOperationsMatchStd) {
+  std::mt19937 random(45);
+  s21::unordered_map<int, int> school1;
+  std::unordered_map<int, int> std1;
+  for (int i = 0; i < 100000; ++i) {
+    int key = static_cast<int>(random() % 6000);
+    if (random() % 2 == 0) {
+      ASSERT_EQ(school1.erase(key), std1.erase(key));
+    } else {
+      ASSERT_EQ(school1.insert(std::make_pair(key, i)).second,
+                std1.insert(std::make_pair(key, i)).second);
+    }
+    if (i % 10000 == 0) {
+      check_equals(school1, std1);
+    }
+  }
+  check_equals(school1, std1);
+  for (int key = 0; key < 6000; ++key) {
+    ASSERT_EQ(school1.contains(key), std1.count(key) == 1);
+  }
+}
+
+TEST(UnorderedMap, ChurnDoesNotGrowTheTable) {
+  s21::unordered_map<int, int> school1;
+  school1.reserve(1000);
+  size_t buckets = school1.bucket_count();
+  ASSERT_GE(static_cast<float>(buckets) * school1.max_load_factor(), 1000.0f);
+  for (int round = 0; round < 200; ++round) {
+    for (int i = 0; i < 1000; ++i) {
+      school1[round * 1000 + i] = i;
+    }
+    for (int i = 0; i < 1000; ++i) {
+      ASSERT_EQ(school1.erase(round * 1000 + i), 1U);
+    }
+  }
+  ASSERT_TRUE(school1.empty());
+  ASSERT_EQ(school1.bucket_count(), buckets);
+}
+
+TEST(UnorderedMap, CollidingKeysStillWork) {
+  s21::unordered_map<int, int, CollidingHash> school1;
+  std::unordered_map<int, int> std1;
+  for (int i = 0; i < 300; ++i) {
+    school1[i] = i * 2;
+    std1[i] = i * 2;
+  }
+  for (int i = 0; i < 300; i += 3) {
+    school1.erase(i);
+    std1.erase(i);
+  }
+  check_equals(school1, std1);
+  for (int i = 0; i < 300; ++i) {
+    ASSERT_EQ(school1.contains(i), std1.count(i) == 1);
+  }
+}
+
+TEST(UnorderedMap, HeterogeneousLookup) {
+  s21::unordered_map<std::string, int, StringHash, std::equal_to<>> school1;
+  school1["alpha"] = 1;
+  school1["beta"] = 2;
+  std::string_view key = "beta";
+  ASSERT_EQ(school1.find(key)->second, 2);
+  ASSERT_TRUE(school1.contains(std::string_view("alpha")));
+  ASSERT_EQ(school1.count(std::string_view("gamma")), 0U);
+  ASSERT_EQ(school1.erase(key), 1U);
+  ASSERT_EQ(school1.size(), 1U);
+}
+
+TEST(UnorderedMap, CopyMoveAndEraseWhileIterating) {
+  s21::unordered_map<std::string, std::string> school1;
+  std::unordered_map<std::string, std::string> std1;
+  for (int i = 0; i < 2000; ++i) {
+    school1[std::to_string(i)] = std::to_string(i * i);
+    std1[std::to_string(i)] = std::to_string(i * i);
+  }
+  s21::unordered_map<std::string, std::string> copy = school1;
+  check_equals(copy, std1);
+  s21::unordered_map<std::string, std::string> moved = std::move(copy);
+  check_equals(moved, std1);
+  ASSERT_TRUE(copy.empty());
+  for (auto it = moved.begin(); it != moved.end();) {
+    if (it->first.size() == 3) {
+      std1.erase(it->first);
+      it = moved.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  check_equals(moved, std1);
+  moved.clear();
+  ASSERT_EQ(moved.begin(), moved.end());
+  moved.rehash(0);
+  ASSERT_EQ(moved.bucket_count(), 16U);
+}
+
+TEST(UnorderedMap, MergeAndInsertMany) {
+  s21::unordered_map<int, int> school1 = {{1, 1}, {3, 3}};
+  s21::unordered_map<int, int> school2 = {{2, 20}, {3, 30}};
+  school1.merge(school2);
+  check_equals(school1, std::unordered_map<int, int>{{1, 1}, {2, 20}, {3, 3}});
+  check_equals(school2, std::unordered_map<int, int>{{3, 30}});
+  auto results = school1.insert_many(std::make_pair(5, 5),
+                                     std::make_pair(1, 0));
+  ASSERT_TRUE(results[0].second);
+  ASSERT_FALSE(results[1].second);
+  ASSERT_EQ(results[0].first->first, 5);
+  ASSERT_EQ(results[1].first->second, 1);
+}
@@ -0,0 +1,51 @@
+#include <random>
+#include <string>
+#include <unordered_set>
+
+#include "../src/unordered/unordered_set.h"
+
+template <typename T>
+void check_equals(const s21::unordered_set<T> &lhs,
+                  const std::unordered_set<T> &rhs) {
+  ASSERT_EQ(lhs.size(), rhs.size());
+  for (const auto &key : lhs) {
+    ASSERT_EQ(rhs.count(key), 1U);
+  }
+}
+
+TEST(UnorderedSet, InsertEraseFind) {
+  s21::unordered_set<int> school1 = {7, 5, 3, 7, 11, 25, 1, -6, 11, 27, 33};
+  std::unordered_set<int> std1 = {7, 5, 3, 7, 11, 25, 1, -6, 11, 27, 33};
+  check_equals(school1, std1);
+  ASSERT_FALSE(school1.insert(7).second);
+  ASSERT_EQ(*school1.insert(8).first, 8);
+  std1.insert(8);
+  ASSERT_EQ(school1.erase(11), 1U);
+  ASSERT_EQ(school1.erase(11), 0U);
+  std1.erase(11);
+  check_equals(school1, std1);
+  ASSERT_EQ(school1.find(100), school1.end());
+}
+
+TEST(UnorderedSet, RandomStringsMatchStd) {
+  std::mt19937 random(46);
+  s21::unordered_set<std::string> school1;
+  std::unordered_set<std::string> std1;
+  for (int i = 0; i < 50000; ++i) {
+    std::string key = "key" + std::to_string(random() % 5000);
+    if (random() % 3 == 0) {
+      ASSERT_EQ(school1.erase(key), std1.erase(key));
+    } else {
+      ASSERT_EQ(school1.emplace(key).second, std1.insert(key).second);
+    }
+  }
+  check_equals(school1, std1);
+  s21::unordered_set<std::string> copy;
+  copy = school1;
+  check_equals(copy, std1);
+  s21::unordered_set<std::string> other = {"key1", "fresh"};
+  copy.merge(other);
+  std1.insert("fresh");
+  check_equals(copy, std1);
+  ASSERT_EQ(other.size(), std1.count("key1"));
+}
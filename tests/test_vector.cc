@@ -1,3 +1,4 @@
+#include <string>
 #include <vector>
 
 #include "../src/vector/vector.h"
@@ -278,3 +279,25 @@ TEST(Vector, ReserveManyThenCapacity) {
   school1.reserve(1);
   ASSERT_EQ(school1.capacity(), current_capacity);
 }
+
+TEST(Vector, EmplaceAndEraseRangeOfStrings) {
+  s21::vector<std::string> school1{"a", "b", "c", "d", "e"};
+  std::vector<std::string> std1{"a", "b", "c", "d", "e"};
+  school1.emplace(school1.begin() + 1, 3, 'x');
+  std1.emplace(std1.begin() + 1, 3, 'x');
+  school1.emplace(school1.begin(), school1[5]);
+  std1.emplace(std1.begin(), std1[5]);
+  school1.emplace(school1.end(), "z");
+  std1.emplace(std1.end(), "z");
+  ASSERT_EQ(school1.size(), std1.size());
+  for (size_t i = 0; i < school1.size(); ++i) {
+    ASSERT_EQ(school1[i], std1[i]);
+  }
+  auto next = school1.erase(school1.begin() + 2, school1.begin() + 5);
+  std1.erase(std1.begin() + 2, std1.begin() + 5);
+  ASSERT_EQ(*next, "d");
+  ASSERT_EQ(school1.size(), std1.size());
+  for (size_t i = 0; i < school1.size(); ++i) {
+    ASSERT_EQ(school1[i], std1[i]);
+  }
+}
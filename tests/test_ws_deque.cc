@@ -0,0 +1,83 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "../src/deque/ws_deque.h"
+
+TEST(WsDeque, OwnerIsLifoThiefIsFifo) {
+  s21::ws_deque<int> deque1(4);
+  int value = 0;
+  ASSERT_TRUE(deque1.empty());
+  ASSERT_FALSE(deque1.pop(value));
+  ASSERT_FALSE(deque1.steal(value));
+  for (int i = 0; i < 4; ++i) {
+    deque1.push(i);
+  }
+  ASSERT_EQ(deque1.size(), 4U);
+  ASSERT_TRUE(deque1.pop(value));
+  ASSERT_EQ(value, 3);
+  ASSERT_TRUE(deque1.steal(value));
+  ASSERT_EQ(value, 0);
+  ASSERT_TRUE(deque1.pop(value));
+  ASSERT_EQ(value, 2);
+  ASSERT_TRUE(deque1.pop(value));
+  ASSERT_EQ(value, 1);
+  ASSERT_FALSE(deque1.pop(value));
+  ASSERT_TRUE(deque1.empty());
+}
+
+TEST(WsDeque, Grows) {
+  s21::ws_deque<int> deque1(2);
+  int value = 0;
+  for (int round = 0; round < 3; ++round) {
+    for (int i = 0; i < 1000; ++i) {
+      deque1.push(i);
+    }
+    ASSERT_GE(deque1.capacity(), 1000U);
+    for (int i = 0; i < 500; ++i) {
+      ASSERT_TRUE(deque1.steal(value));
+      ASSERT_EQ(value, i);
+    }
+    for (int i = 999; i >= 500; --i) {
+      ASSERT_TRUE(deque1.pop(value));
+      ASSERT_EQ(value, i);
+    }
+    ASSERT_TRUE(deque1.empty());
+  }
+}
+
+TEST(WsDeque, ThievesAndOwner) {
+  const int items = 200000;
+  const int thieves = 3;
+  s21::ws_deque<int> deque1(16);
+  std::vector<std::atomic<int>> seen(items);
+  std::atomic<bool> done{false};
+  std::vector<std::thread> threads;
+  for (int t = 0; t < thieves; ++t) {
+    threads.emplace_back([&]() {
+      int value = 0;
+      while (!done.load() || !deque1.empty()) {
+        if (deque1.steal(value)) {
+          seen[value].fetch_add(1);
+        }
+      }
+    });
+  }
+  int value = 0;
+  for (int i = 0; i < items; ++i) {
+    deque1.push(i);
+    if (i % 3 == 0 && deque1.pop(value)) {
+      seen[value].fetch_add(1);
+    }
+  }
+  while (deque1.pop(value)) {
+    seen[value].fetch_add(1);
+  }
+  done.store(true);
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  for (auto &count : seen) {
+    ASSERT_EQ(count.load(), 1);
+  }
+}
@@ -3,13 +3,33 @@
 #include <algorithm>
 
 #include "test_array.cc"
+#include "test_blocking_queue.cc"
+#include "test_btree_map.cc"
+#include "test_btree_set.cc"
+#include "test_concurrent_map.cc"
+#include "test_concurrent_stack.cc"
+#include "test_deque.cc"
+#include "test_flat_map.cc"
+#include "test_flat_set.cc"
 #include "test_list.cc"
 #include "test_map.cc"
+#include "test_mpmc_queue.cc"
 #include "test_multiset.cc"
+#include "test_persistent_map.cc"
+#include "test_persistent_set.cc"
+#include "test_priority_queue.cc"
 #include "test_queue.cc"
 #include "test_set.cc"
+#include "test_skiplist_map.cc"
+#include "test_spsc_queue.cc"
 #include "test_stack.cc"
+#include "test_thread_pool.cc"
+#include "test_timer_wheel.cc"
+#include "test_tree.cc"
+#include "test_unordered_map.cc"
+#include "test_unordered_set.cc"
 #include "test_vector.cc"
+#include "test_ws_deque.cc"
 
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
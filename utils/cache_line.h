@@ -0,0 +1,14 @@
+#ifndef CPP2_S21_CONTAINERS_1_UTILS_CACHE_LINE_H_
+#define CPP2_S21_CONTAINERS_1_UTILS_CACHE_LINE_H_
+
+#include <cstddef>
+
+namespace s21 {
+
+// Fields written by different threads are kept this far apart so they never
+// share a cache line.
+constexpr size_t kCacheLineSize = 64;
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_UTILS_CACHE_LINE_H_
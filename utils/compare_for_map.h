@@ -4,11 +4,18 @@
 namespace s21 {
 template <typename T, typename Compare>
 struct MapCompare {
+  MapCompare() : compare_() {}
+  explicit MapCompare(const Compare &compare) : compare_(compare) {}
+
   bool operator()(const T &rhs, const T &lhs) const {
-    return Compare{}(rhs.first, lhs.first);
+    return compare_(rhs.first, lhs.first);
   }
+
+  const Compare &key_comp() const noexcept { return compare_; }
+
+  Compare compare_;
 };
 
 }  // namespace s21
 
-#endif  // CPP2_S21_CONTAINERS_1_UTILS_COMPARE_FOR_MAP_H_
\ No newline at end of file
+#endif  // CPP2_S21_CONTAINERS_1_UTILS_COMPARE_FOR_MAP_H_
@@ -0,0 +1,228 @@
+#ifndef CPP2_S21_CONTAINERS_1_UTILS_EPOCH_RECLAMATION_H_
+#define CPP2_S21_CONTAINERS_1_UTILS_EPOCH_RECLAMATION_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "cache_line.h"
+
+namespace s21 {
+
+// Epoch-based memory reclamation for the lock-free containers.
+//
+// A thread pins the domain (pin() returns an RAII guard) for as long as it
+// may hold raw pointers into a shared structure. Nodes that have been
+// unlinked are handed to retire() instead of being freed; they are stamped
+// with the current global epoch and destroyed once the epoch has advanced
+// twice, which can only happen after every thread that was pinned at the
+// time has unpinned. The epoch advances when all pinned threads have
+// observed the current one.
+//
+// Deleters are plain function pointers with no context, so a retired node
+// can outlive the container that allocated it; allocators used with the
+// concurrent containers must therefore be stateless.
+class EpochReclamation {
+  struct ThreadRecord;
+
+ public:
+  using deleter_type = void (*)(void *);
+
+  class Guard {
+   public:
+    explicit Guard(EpochReclamation &domain) : domain_(domain) {
+      domain_.enter();
+    }
+    Guard(const Guard &) = delete;
+    Guard &operator=(const Guard &) = delete;
+    ~Guard() { domain_.leave(); }
+
+   private:
+    EpochReclamation &domain_;
+  };
+
+  static EpochReclamation &instance() {
+    static EpochReclamation domain;
+    return domain;
+  }
+
+  EpochReclamation(const EpochReclamation &) = delete;
+  EpochReclamation &operator=(const EpochReclamation &) = delete;
+
+  ~EpochReclamation() {
+    freeAll(orphans_);
+    ThreadRecord *record = records_.load(std::memory_order_acquire);
+    while (record) {
+      ThreadRecord *next = record->next_;
+      freeAll(record->retired_);
+      delete record;
+      record = next;
+    }
+  }
+
+  Guard pin() { return Guard(*this); }
+
+  void retire(void *ptr, deleter_type deleter) {
+    ThreadRecord *record = localRecord();
+    record->retired_.push_back(
+        {ptr, deleter, global_epoch_.load(std::memory_order_acquire)});
+    if (record->retired_.size() >= kCollectThreshold) {
+      collect(record);
+    }
+  }
+
+  // Tries to advance the epoch and frees whatever the calling thread has
+  // retired that is no longer reachable.
+  void collect() { collect(localRecord()); }
+
+  uint64_t epoch() const noexcept {
+    return global_epoch_.load(std::memory_order_acquire);
+  }
+
+ private:
+  static constexpr size_t kCollectThreshold = 64;
+  static constexpr uint64_t kActive = 1;
+
+  struct Retired {
+    void *ptr_;
+    deleter_type deleter_;
+    uint64_t epoch_;
+  };
+
+  // Records are never freed while the domain lives; a thread that exits
+  // hands its record back for reuse and its pending nodes to orphans_.
+  struct alignas(kCacheLineSize) ThreadRecord {
+    // (epoch << 1) | kActive while pinned, 0 otherwise.
+    std::atomic<uint64_t> state_{0};
+    std::atomic<bool> in_use_{true};
+    ThreadRecord *next_ = nullptr;
+    size_t nesting_ = 0;
+    std::vector<Retired> retired_;
+  };
+
+  struct LocalRecord {
+    ~LocalRecord() {
+      if (record_) {
+        domain_->release(record_);
+      }
+    }
+
+    EpochReclamation *domain_;
+    ThreadRecord *record_;
+  };
+
+  EpochReclamation() : global_epoch_(0), records_(nullptr) {}
+
+  ThreadRecord *localRecord() {
+    thread_local LocalRecord local{this, nullptr};
+    if (local.record_ == nullptr) {
+      local.record_ = acquireRecord();
+    }
+    return local.record_;
+  }
+
+  ThreadRecord *acquireRecord() {
+    for (ThreadRecord *record = records_.load(std::memory_order_acquire);
+         record; record = record->next_) {
+      bool expected = false;
+      if (!record->in_use_.load(std::memory_order_relaxed) &&
+          record->in_use_.compare_exchange_strong(expected, true,
+                                                  std::memory_order_acquire)) {
+        return record;
+      }
+    }
+    ThreadRecord *record = new ThreadRecord;
+    ThreadRecord *head = records_.load(std::memory_order_relaxed);
+    do {
+      record->next_ = head;
+    } while (!records_.compare_exchange_weak(head, record,
+                                             std::memory_order_release,
+                                             std::memory_order_relaxed));
+    return record;
+  }
+
+  void release(ThreadRecord *record) {
+    if (!record->retired_.empty()) {
+      std::lock_guard<std::mutex> lock(orphans_mutex_);
+      orphans_.insert(orphans_.end(), record->retired_.begin(),
+                      record->retired_.end());
+      record->retired_.clear();
+    }
+    record->state_.store(0, std::memory_order_release);
+    record->in_use_.store(false, std::memory_order_release);
+  }
+
+  void enter() {
+    ThreadRecord *record = localRecord();
+    if (record->nesting_++ == 0) {
+      uint64_t epoch = global_epoch_.load(std::memory_order_acquire);
+      record->state_.store((epoch << 1) | kActive, std::memory_order_relaxed);
+      // Our pin must be visible before we read any shared pointer.
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+  }
+
+  void leave() {
+    ThreadRecord *record = localRecord();
+    if (--record->nesting_ == 0) {
+      record->state_.store(0, std::memory_order_release);
+    }
+  }
+
+  bool tryAdvance() {
+    uint64_t epoch = global_epoch_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    for (ThreadRecord *record = records_.load(std::memory_order_acquire);
+         record; record = record->next_) {
+      uint64_t state = record->state_.load(std::memory_order_acquire);
+      if ((state & kActive) && (state >> 1) != epoch) {
+        return false;
+      }
+    }
+    return global_epoch_.compare_exchange_strong(epoch, epoch + 1,
+                                                 std::memory_order_acq_rel);
+  }
+
+  void collect(ThreadRecord *record) {
+    tryAdvance();
+    uint64_t epoch = global_epoch_.load(std::memory_order_acquire);
+    freeExpired(record->retired_, epoch);
+    std::unique_lock<std::mutex> lock(orphans_mutex_, std::try_to_lock);
+    if (lock.owns_lock() && !orphans_.empty()) {
+      freeExpired(orphans_, epoch);
+    }
+  }
+
+  static void freeExpired(std::vector<Retired> &retired, uint64_t epoch) {
+    size_t kept = 0;
+    for (size_t i = 0; i < retired.size(); ++i) {
+      if (retired[i].epoch_ + 2 <= epoch) {
+        retired[i].deleter_(retired[i].ptr_);
+      } else {
+        retired[kept++] = retired[i];
+      }
+    }
+    retired.resize(kept);
+  }
+
+  static void freeAll(std::vector<Retired> &retired) {
+    for (auto &item : retired) {
+      item.deleter_(item.ptr_);
+    }
+    retired.clear();
+  }
+
+ private:
+  alignas(kCacheLineSize) std::atomic<uint64_t> global_epoch_;
+  std::atomic<ThreadRecord *> records_;
+  std::mutex orphans_mutex_;
+  std::vector<Retired> orphans_;
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_UTILS_EPOCH_RECLAMATION_H_
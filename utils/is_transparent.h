@@ -0,0 +1,23 @@
+#ifndef CPP2_S21_CONTAINERS_1_UTILS_IS_TRANSPARENT_H_
+#define CPP2_S21_CONTAINERS_1_UTILS_IS_TRANSPARENT_H_
+
+#include <type_traits>
+
+namespace s21 {
+
+// True for comparators such as std::less<> that declare is_transparent and
+// can therefore compare a key with any type it is ordered against, which
+// lets lookups skip building a temporary key.
+template <typename Compare, typename = void>
+struct is_transparent : std::false_type {};
+
+template <typename Compare>
+struct is_transparent<Compare, std::void_t<typename Compare::is_transparent>>
+    : std::true_type {};
+
+template <typename Compare>
+inline constexpr bool is_transparent_v = is_transparent<Compare>::value;
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_UTILS_IS_TRANSPARENT_H_